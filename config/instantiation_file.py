@@ -74,6 +74,8 @@ cache_builder_parts = {
     'log2_ways': '.log2_ways({log2_ways})',
     'pq_size': '.pq_size({pq_size})',
     'mshr_size': '.mshr_size({mshr_size})',
+    'sampled_sets': '.sampled_sets({sampled_sets})',
+    'prefetch_filter': '.prefetch_filter({prefetch_filter})',
     'latency': '.latency({latency})',
     'hit_latency': '.hit_latency({hit_latency})',
     'fill_latency': '.fill_latency({fill_latency})',
@@ -105,6 +107,14 @@ def vector_string(iterable):
         return hoisted[0]
     return '{'+', '.join(hoisted)+'}'
 
+def execute_class_part(name, spec, default_ports):
+    ''' Produce the builder call for one class of the execute_classes table. Braces are doubled because the parts are formatted again. '''
+    ports = spec.get('ports', default_ports)
+    if int(ports) < 1:
+        raise ValueError(f'Execute class {name} must have at least one port')
+    pipelined = 'true' if spec.get('pipelined', True) else 'false'
+    return f'.execute_class(op_class::{name}, {spec["latency"]}, champsim::bandwidth::maximum_type{{{{{ports}}}}}, {pipelined})'
+
 def get_cpu_builder(cpu, caches, ul_pairs):
     '''
     Generate a champsim::core_builder
@@ -130,10 +140,33 @@ def get_cpu_builder(cpu, caches, ul_pairs):
         ('champsim::core_builder{{ champsim::defaults::default_core }}',),
         required_parts,
         *(util.wrap_list(v) for k,v in core_builder_parts.items() if k in cpu),
-        (v for k,v in dib_builder_parts.items() if k in cpu.get('DIB',{}))
+        (v for k,v in dib_builder_parts.items() if k in cpu.get('DIB',{})),
+        (execute_class_part(k, v, cpu.get('execute_width', 1)) for k,v in cpu.get('execute_classes',{}).items())
     ), indent=1, line_end=''))
     yield from (part.format(**cpu, **local_params) for part in builder_parts)
 
+def static_geometry_part(cache):
+    ''' Produce the builder call that fixes the geometry of a cache at compile time. The sets and ways must be given directly. '''
+    sets = cache.get('sets', 1 << cache['log2_sets'] if 'log2_sets' in cache else None)
+    ways = cache.get('ways', 1 << cache['log2_ways'] if 'log2_ways' in cache else None)
+    if sets is None or ways is None or '_offset_bits' not in cache:
+        raise ValueError(f'Cache {cache["name"]} has a static geometry, but does not specify its sets and ways')
+    return f'.static_geometry<{sets}, {ways}, {cache["_offset_bits"]}>()'
+
+def dram_scheduler_part(pmem, num_cpus):
+    ''' Produce the trailing constructor argument that selects the scheduling policy of the DRAM channels, if one is given. '''
+    policies = {
+        'fr-fcfs': 'FR_FCFS',
+        'bandwidth-cap': 'BANDWIDTH_CAP',
+        'bliss': 'BLISS',
+        'atlas': 'ATLAS'
+    }
+    if 'scheduler' not in pmem:
+        return ''
+    if pmem['scheduler'] not in policies:
+        raise ValueError(f'Unknown DRAM scheduler {pmem["scheduler"]}. Choose one of {", ".join(policies)}')
+    return f', champsim::dram_scheduler{{champsim::dram_scheduling_policy::{policies[pmem["scheduler"]]}, {num_cpus}, {float(pmem.get("bandwidth_cap", 1))}}}'
+
 def get_cache_builder(elem, ul_pairs):
     '''
     Generate a champsim::cache_builder
@@ -149,7 +182,16 @@ def get_cache_builder(elem, ul_pairs):
         ('wq_check_full_addr', True): '.set_wq_checks_full_addr()',
         ('wq_check_full_addr', False): '.reset_wq_checks_full_addr()',
         ('virtual_prefetch', True): '.set_virtual_prefetch()',
-        ('virtual_prefetch', False): '.reset_virtual_prefetch()'
+        ('virtual_prefetch', False): '.reset_virtual_prefetch()',
+        ('prefetch_throttle', True): '.set_prefetch_throttle()',
+        ('prefetch_throttle', False): '.reset_prefetch_throttle()',
+        ('prefetch_ensemble', True): '.set_prefetch_ensemble()',
+        ('prefetch_ensemble', False): '.reset_prefetch_ensemble()',
+        ('way_partitioning', True): '.set_way_partitioning()',
+        ('way_partitioning', False): '.reset_way_partitioning()',
+        ('inclusion', 'non-inclusive'): '.inclusion(champsim::inclusion_policy::NINE)',
+        ('inclusion', 'inclusive'): '.inclusion(champsim::inclusion_policy::INCLUSIVE)',
+        ('inclusion', 'exclusive'): '.inclusion(champsim::inclusion_policy::EXCLUSIVE)'
     }
 
     uppers = (v for v in ul_pairs if v[0] == elem.get('name'))
@@ -172,7 +214,8 @@ def get_cache_builder(elem, ul_pairs):
         ('champsim::cache_builder{{ {^defaults} }}',),
         required_parts,
         (v for k,v in cache_builder_parts.items() if k in elem),
-        (v for k,v in local_cache_builder_parts.items() if k[0] in elem and k[1] == elem[k[0]])
+        (v for k,v in local_cache_builder_parts.items() if k[0] in elem and k[1] == elem[k[0]]),
+        (static_geometry_part(elem),) if elem.get('static_geometry', False) else ()
     ), indent=1, line_end=''))
     yield from (part.format(**elem, **local_params) for part in builder_parts)
 
@@ -348,7 +391,7 @@ def get_instantiation_lines(cores, caches, ptws, pmem, vmem, build_id):
             _refresh_period=int(1000*pmem['refresh_period']),
             _refreshes_per_period=int(pmem['refreshes_per_period']),
             _ulptr=vector_string(f'&channels.at({ul_pairs.index(v)})' for v in ul_pairs if v[0] == pmem['name']),
-            **pmem),
+            **pmem) + dram_scheduler_part(pmem, len(cores)),
         '},'
     )
 
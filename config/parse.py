@@ -234,7 +234,7 @@ class NormalizedConfiguration:
                 'frequency', 'ifetch_buffer_size', 'decode_buffer_size', 'dispatch_buffer_size', 'register_file_size', 'rob_size', 'lq_size',
                 'sq_size', 'fetch_width', 'decode_width', 'dispatch_width', 'execute_width', 'lq_width', 'sq_width',
                 'retire_width', 'mispredict_penalty', 'scheduler_size', 'decode_latency', 'dispatch_latency',
-                'schedule_latency', 'execute_latency', 'branch_predictor', 'btb', 'DIB'
+                'schedule_latency', 'execute_latency', 'execute_classes', 'branch_predictor', 'btb', 'DIB'
             )
         )
         self.cores = [util.chain(cpu, core_from_config, {'name': f'cpu{i}'}) for i,cpu in enumerate(self.cores)]
@@ -403,8 +403,9 @@ class NormalizedConfiguration:
                '_queue_check_full_addr': cache.get('_first_level', False) or cache.get('wq_check_full_addr', False),
 
                 # Get module path names and unique module names
-               '_replacement_data': list(map(replacement_parse, util.wrap_list(cache.get('replacement', 'lru')))),
-               '_prefetcher_data': [*map(functools.partial(prefetcher_parse, cache=cache), util.wrap_list(cache.get('prefetcher', 'no')))]
+               # Lists of modules are joined each time a cache is chained, so a module listed once may appear several times
+               '_replacement_data': list(map(replacement_parse, util.unique(util.wrap_list(cache.get('replacement', 'lru'))))),
+               '_prefetcher_data': [*map(functools.partial(prefetcher_parse, cache=cache), util.unique(util.wrap_list(cache.get('prefetcher', 'no'))))]
             } for k,cache in caches.items())
         )
 
@@ -42,6 +42,14 @@ def wrap_list(attr):
         attr = [attr]
     return attr
 
+def unique(iterable):
+    ''' Remove repeated elements, keeping the first of each. The elements need not be hashable. '''
+    result = []
+    for val in iterable:
+        if val not in result:
+            result.append(val)
+    return result
+
 def collect(iterable, key_func, join_func):
     ''' Perform the "sort->groupby" idiom on an iterable, grouping according to the join_func. '''
     intern_iterable = sorted(iterable, key=key_func)
@@ -17,6 +17,7 @@
 #ifndef BLOCK_H
 #define BLOCK_H
 
+#include "address.h"
 #include "champsim.h"
 
 namespace champsim
@@ -25,12 +26,14 @@ struct cache_block {
   bool valid = false;
   bool prefetch = false;
   bool dirty = false;
+  uint8_t pf_component = 0; // the prefetcher of the cache that prefetched the block
 
   champsim::address address{};
   champsim::address v_address{};
   champsim::address data{};
 
   uint32_t pf_metadata = 0;
+  uint32_t pf_issue_metadata = 0; // the metadata that the prefetch of the block was issued with
 };
 } // namespace champsim
 
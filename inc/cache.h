@@ -22,28 +22,44 @@
 #undef CHAMPSIM_MODULE
 #endif
 
+#include <algorithm>
 #include <array>
+#include <cassert>
 #include <cstddef> // for size_t
 #include <cstdint> // for uint64_t, uint32_t, uint8_t
-#include <deque>
 #include <iterator> // for size
 #include <limits>   // for numeric_limits
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <tuple>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "address.h"
 #include "bandwidth.h"
 #include "block.h"
 #include "cache_builder.h"
+#include "cache_profiler.h"
 #include "cache_stats.h"
 #include "champsim.h"
 #include "channel.h"
 #include "chrono.h"
 #include "modules.h"
+#include "msl/bits.h"
+#include "msl/lru_table.h"
 #include "operable.h"
+#include "prefetch_candidates.h"
+#include "prefetch_ensemble.h"
+#include "prefetch_filter.h"
+#include "prefetch_throttle.h"
+#include "prefetch_trace.h"
+#include "set_sampler.h"
+#include "way_partitioner.h"
+#include "util/indexed_list.h"
+#include "util/ring_buffer.h"
 #include "util/to_underlying.h" // for to_underlying
 #include "waitable.h"
 
@@ -71,14 +87,16 @@ class CACHE : public champsim::operable
     bool prefetch_from_this;
     bool skip_fill;
     bool is_translated;
+    bool clean;
     bool translate_issued = false;
+    uint8_t pf_component = 0;
 
     uint8_t asid[2] = {std::numeric_limits<uint8_t>::max(), std::numeric_limits<uint8_t>::max()};
 
     champsim::chrono::clock::time_point event_cycle = champsim::chrono::clock::time_point::max();
 
-    std::vector<uint64_t> instr_depend_on_me{};
-    std::vector<std::deque<response_type>*> to_return{};
+    champsim::shared_list<uint64_t> instr_depend_on_me{};
+    uint64_t to_return = 0; // the indices of the upper levels to respond to, as a bitmask
 
     explicit tag_lookup_type(request_type req) : tag_lookup_type(req, false, false) {}
     tag_lookup_type(const request_type& req, bool local_pref, bool skip);
@@ -94,30 +112,46 @@ public:
     struct returned_value {
       champsim::address data;
       uint32_t pf_metadata;
+      unsigned miss_levels;
     };
     champsim::waitable<returned_value> data_promise{};
     uint32_t cpu;
 
     access_type type;
     bool prefetch_from_this;
+    bool clean;
+    bool late_prefetch = false; // a demand merged into this prefetch while it was in flight
+    uint8_t pf_component;
+    uint32_t pf_metadata;
 
     uint8_t asid[2] = {std::numeric_limits<uint8_t>::max(), std::numeric_limits<uint8_t>::max()};
 
     champsim::chrono::clock::time_point time_enqueued;
 
-    std::vector<uint64_t> instr_depend_on_me{};
-    std::vector<std::deque<response_type>*> to_return{};
+    champsim::shared_list<uint64_t> instr_depend_on_me{};
+    uint64_t to_return = 0; // the indices of the upper levels to respond to, as a bitmask
 
     mshr_type(const tag_lookup_type& req, champsim::chrono::clock::time_point _time_enqueued);
     static mshr_type merge(mshr_type predecessor, mshr_type successor);
   };
 
+  // MSHRs are found by their block address
+  struct mshr_indexer {
+    champsim::data::bits shamt;
+    uint64_t operator()(champsim::address address) const { return address.slice_upper(shamt).to<uint64_t>(); }
+    uint64_t operator()(const mshr_type& entry) const { return operator()(entry.address); }
+  };
+
 private:
   bool try_hit(const tag_lookup_type& handle_pkt);
   bool handle_fill(const mshr_type& fill_mshr);
   bool handle_miss(const tag_lookup_type& handle_pkt);
   bool handle_write(const tag_lookup_type& handle_pkt);
+  void model_writeback(const tag_lookup_type& handle_pkt, bool dirty);
+  void record_tag_check(const tag_lookup_type& handle_pkt, bool hit);
+  bool back_invalidate(champsim::address inval_addr);
   void finish_packet(const response_type& packet);
+  void finish_modeled_miss(const mshr_type& entry);
   void finish_translation(const response_type& packet);
 
   void issue_translation(tag_lookup_type& q_entry) const;
@@ -127,17 +161,20 @@ public:
 
 private:
   static BLOCK fill_block(mshr_type mshr, uint32_t metadata);
+  static request_type writeback_packet(const BLOCK& victim, uint32_t triggering_cpu, uint64_t instr_id);
   using set_type = std::vector<BLOCK>;
 
   std::pair<set_type::iterator, set_type::iterator> get_set_span(champsim::address address);
   [[nodiscard]] std::pair<set_type::const_iterator, set_type::const_iterator> get_set_span(champsim::address address) const;
   [[nodiscard]] long get_set_index(champsim::address address) const;
+  [[nodiscard]] uint64_t block_tag(champsim::address address) const;
+  [[nodiscard]] long find_way(champsim::address address) const;
 
   template <typename T>
   bool should_activate_prefetcher(const T& pkt) const;
 
   template <bool>
-  auto initiate_tag_check(champsim::channel* ul = nullptr);
+  auto initiate_tag_check(std::size_t upper_level = 0);
 
   template <typename T>
   champsim::address module_address(const T& element) const;
@@ -145,9 +182,54 @@ private:
   auto matches_address(champsim::address address) const;
   std::pair<mshr_type, request_type> mshr_and_forward_packet(const tag_lookup_type& handle_pkt);
 
-  std::deque<tag_lookup_type> internal_PQ{};
-  std::deque<tag_lookup_type> inflight_tag_check{};
-  std::deque<tag_lookup_type> translation_stash{};
+  champsim::ring_buffer<tag_lookup_type> internal_PQ{};
+  champsim::ring_buffer<tag_lookup_type> inflight_tag_check{};
+  champsim::ring_buffer<tag_lookup_type> translation_stash{};
+
+  std::size_t upper_level_rotation = 0; // the upper level whose queues are read first
+
+  // The sets simulated in detail, and the model of the others
+  champsim::set_sampler set_sampling{};
+  champsim::ring_buffer<mshr_type> modeled_misses{};         // misses to the other sets, answered after the modeled latency
+  champsim::ring_buffer<request_type> modeled_writebacks{}; // writebacks that the blocks of the other sets would cause
+
+  champsim::cache_profiler profiler{};
+
+  // Shadow tags of the demand blocks evicted by prefetches, with the metadata that the evicting prefetch was issued with
+  struct pollution_entry {
+    uint64_t block = 0;
+    uint32_t pf_metadata = 0;
+  };
+  struct pollution_entry_block {
+    uint64_t operator()(const pollution_entry& entry) const { return entry.block; }
+  };
+  constexpr static std::size_t pollution_filter_ways = 2;
+  champsim::msl::lru_table<pollution_entry, pollution_entry_block, pollution_entry_block> pollution_filter;
+
+  // Limits the prefetches admitted, if throttling is enabled
+  champsim::prefetch_throttle throttle{};
+  [[nodiscard]] champsim::prefetch_throttle::feedback_type prefetch_feedback() const;
+
+  // Arbitrates between the prefetchers, if there is more than one and arbitration is enabled
+  champsim::prefetch_ensemble ensemble{};
+  std::size_t prefetch_component = champsim::prefetch_ensemble::no_component; // the prefetcher being invoked, if any
+
+  // Candidates pushed by the prefetchers, waiting for room in the prefetch queue
+  champsim::prefetch_candidate_queue prefetch_candidates{};
+  void issue_prefetch_candidates();
+
+  // Why a prefetch was or was not admitted to the prefetch queue
+  enum class prefetch_result { ISSUED, QUEUE_FULL, FILTERED, DUPLICATE, OVER_QUOTA, THROTTLED };
+  prefetch_result try_prefetch_line(champsim::address pf_addr, bool fill_this_level, uint32_t prefetch_metadata);
+
+  // Drops prefetches to blocks recently prefetched or filled, before they take a tag check
+  champsim::prefetch_filter pf_filter{};
+
+  champsim::prefetch_trace_writer pf_trace{};
+
+  // Limits the ways each core may allocate, if partitioning is enabled
+  champsim::way_partitioner partitioner{};
+  void record_useful_prefetch(uint8_t component, uint32_t metadata);
 
 public:
   std::vector<channel_type*> upper_levels;
@@ -162,24 +244,58 @@ public:
   champsim::chrono::clock::duration FILL_LATENCY;
   champsim::data::bits OFFSET_BITS;
   set_type block{static_cast<typename set_type::size_type>(NUM_SET * NUM_WAY)};
+  std::vector<uint64_t> block_tags = std::vector<uint64_t>(static_cast<std::size_t>(NUM_SET * NUM_WAY)); // the tags of the blocks, zero if invalid
   champsim::bandwidth::maximum_type MAX_TAG, MAX_FILL;
   bool prefetch_as_load;
   bool match_offset_bits;
   bool virtual_prefetch;
+  champsim::inclusion_policy inclusion;
   std::vector<access_type> pref_activate_mask;
 
   using stats_type = cache_stats;
 
   stats_type sim_stats, roi_stats;
 
-  std::deque<mshr_type> MSHR;
-  std::deque<mshr_type> inflight_writes;
+  champsim::indexed_list<mshr_type, mshr_indexer> MSHR{mshr_indexer{OFFSET_BITS}};
+  champsim::ring_buffer<mshr_type> inflight_writes;
 
   long operate() final;
   void initialize() final;
   void begin_phase() final;
   void end_phase(unsigned cpu) final;
 
+  /**
+   * Profile the hits, misses, and evictions of each set and the load instructions that miss most often.
+   *
+   * :param out: The stream to receive the profile of each phase.
+   * :param top_ips: The number of load instructions to track.
+   */
+  void enable_profile(std::ostream& out, std::size_t top_ips);
+
+  /**
+   * Write the profile of the phase that just ended, if profiling is enabled.
+   */
+  void write_profile(std::string_view phase_name) const;
+
+  /**
+   * Record every call to the prefetcher of this cache, to be replayed later without the rest of the simulator.
+   *
+   * :param out: The binary stream to receive the records.
+   */
+  void enable_prefetch_trace(std::ostream& out);
+
+  /**
+   * Remove the prefetches waiting in the internal prefetch queue and the pending prefetch candidates, and return their addresses.
+   * The prefetcher replay harness uses this to collect the prefetches without checking them against the tags.
+   */
+  std::vector<champsim::address> drain_prefetch_queue();
+
+  /**
+   * Start a new invocation of the prefetcher, for the throttle to count the prefetches admitted against.
+   * The prefetcher replay harness uses this, since it invokes the prefetcher directly.
+   */
+  void begin_prefetch_invocation() {}
+
   [[deprecated]] std::size_t get_occupancy(uint8_t queue_type, champsim::address address) const;
   [[deprecated]] std::size_t get_size(uint8_t queue_type, champsim::address address) const;
 
@@ -212,6 +328,14 @@ public:
   long invalidate_entry(champsim::address inval_addr);
   bool prefetch_line(champsim::address pf_addr, bool fill_this_level, uint32_t prefetch_metadata);
 
+  /**
+   * Offer a prefetch to be issued when the prefetch queue has room. Candidates that are already cached, already in flight, or already
+   * pending are filtered out, and the candidates of higher priority are issued first.
+   *
+   * \return false if the candidate was dropped because the pending candidates are all of higher priority
+   */
+  bool push_prefetch_candidate(champsim::address pf_addr, bool fill_this_level, uint32_t prefetch_metadata, uint32_t priority);
+
   [[deprecated]] bool prefetch_line(uint64_t pf_addr, bool fill_this_level, uint32_t prefetch_metadata);
 
   [[deprecated("Use CACHE::prefetch_line(pf_addr, fill_this_level, prefetch_metadata) instead.")]] bool
@@ -254,12 +378,27 @@ public:
   template <typename... Ps>
   struct prefetcher_module_model final : prefetcher_module_concept {
     std::tuple<Ps...> intern_;
-    explicit prefetcher_module_model(CACHE* cache) : intern_(Ps{cache}...) { (void)cache; /* silence -Wunused-but-set-parameter when sizeof...(Ps) == 0 */ }
+    CACHE* cache_;
+    explicit prefetcher_module_model(CACHE* cache) : intern_(Ps{cache}...), cache_(cache) {}
     void bind(CACHE* cache)
     {
+      cache_ = cache;
       std::apply([cache = cache](auto&... p) { (..., p.bind(cache)); }, intern_);
     }
 
+    // Invoke each prefetcher in order, telling the cache which prefetcher is issuing and that none is once it returns
+    template <typename F>
+    void each_component(F&& func)
+    {
+      each_component(func, std::index_sequence_for<Ps...>{});
+    }
+
+    template <typename F, std::size_t... Is>
+    void each_component([[maybe_unused]] F& func, std::index_sequence<Is...>)
+    {
+      (..., (cache_->prefetch_component = Is, func(std::get<Is>(intern_)), cache_->prefetch_component = champsim::prefetch_ensemble::no_component));
+    }
+
     void impl_prefetcher_initialize() final;
     [[nodiscard]] uint32_t impl_prefetcher_cache_operate(champsim::address addr, champsim::address ip, bool cache_hit, bool useful_prefetch, access_type type,
                                                          uint32_t metadata_in) final;
@@ -317,12 +456,55 @@ public:
 
   template <typename... Ps, typename... Rs>
   explicit CACHE(champsim::cache_builder<champsim::cache_builder_module_type_holder<Ps...>, champsim::cache_builder_module_type_holder<Rs...>> b)
-      : champsim::operable(b.m_clock_period), upper_levels(b.m_uls), lower_level(b.m_ll), lower_translate(b.m_lt), NAME(b.m_name), NUM_SET(b.get_num_sets()),
+      : champsim::operable(b.m_clock_period), pollution_filter(champsim::msl::next_pow2(std::max(b.get_num_sets(), 1u)), pollution_filter_ways),
+        upper_levels(b.m_uls), lower_level(b.m_ll), lower_translate(b.m_lt), NAME(b.m_name), NUM_SET(b.get_num_sets()),
         NUM_WAY(b.get_num_ways()), MSHR_SIZE(b.get_num_mshrs()), PQ_SIZE(b.m_pq_size), HIT_LATENCY(b.get_hit_latency() * b.m_clock_period),
         FILL_LATENCY(b.get_fill_latency() * b.m_clock_period), OFFSET_BITS(b.m_offset_bits), MAX_TAG(b.get_tag_bandwidth()), MAX_FILL(b.get_fill_bandwidth()),
-        prefetch_as_load(b.m_pref_load), match_offset_bits(b.m_wq_full_addr), virtual_prefetch(b.m_va_pref), pref_activate_mask(b.m_pref_act_mask),
-        pref_module_pimpl(std::make_unique<prefetcher_module_model<Ps...>>(this)), repl_module_pimpl(std::make_unique<replacement_module_model<Rs...>>(this))
+        prefetch_as_load(b.m_pref_load), match_offset_bits(b.m_wq_full_addr), virtual_prefetch(b.m_va_pref), inclusion(b.m_inclusion),
+        pref_activate_mask(b.m_pref_act_mask), pref_module_pimpl(std::make_unique<prefetcher_module_model<Ps...>>(this)),
+        repl_module_pimpl(std::make_unique<replacement_module_model<Rs...>>(this))
   {
+    assert(std::size(upper_levels) <= std::numeric_limits<decltype(mshr_type::to_return)>::digits);
+
+    if (b.m_static_geometry.has_value()
+        && (b.m_static_geometry->sets != NUM_SET || b.m_static_geometry->ways != NUM_WAY || b.m_static_geometry->offset_bits != OFFSET_BITS)) {
+      throw std::invalid_argument{"The geometry of cache " + NAME + " does not match its static geometry"};
+    }
+
+    if (b.m_pf_ensemble && sizeof...(Ps) > 1) {
+      ensemble = champsim::prefetch_ensemble{sizeof...(Ps)};
+    }
+
+    if (b.m_pf_filter.has_value()) {
+      pf_filter = champsim::prefetch_filter{b.m_pf_filter.value()};
+    }
+
+    if (b.m_way_partition) {
+      partitioner = champsim::way_partitioner{NUM_CPUS, NUM_SET, NUM_WAY};
+    }
+
+    // The interval is half as many fills as the cache has blocks
+    if (b.m_pf_throttle) {
+      throttle = champsim::prefetch_throttle{std::max<uint64_t>(uint64_t{NUM_SET} * NUM_WAY / 2, 1)};
+    }
+
+    if (auto sampled_sets = b.get_num_sampled_sets(); sampled_sets.has_value()) {
+      set_sampling = champsim::set_sampler{NUM_SET, sampled_sets.value()};
+    }
+
+    if (lower_level != nullptr) {
+      lower_level->accepts_invalidations = true;
+    }
+    if (inclusion == champsim::inclusion_policy::EXCLUSIVE) {
+      for (auto* ul : upper_levels) {
+        ul->writeback_clean_victims = true;
+      }
+    }
+
+    // The other queues are bounded by the MSHRs, whose default count scales with the sets. They grow to their working size during warmup instead.
+    if (PQ_SIZE != std::numeric_limits<std::size_t>::max()) {
+      internal_PQ.reserve(PQ_SIZE);
+    }
   }
 
   CACHE(const CACHE&) = delete;
@@ -365,7 +547,9 @@ uint32_t CACHE::prefetcher_module_model<Ps...>::impl_prefetcher_cache_operate(ch
     return return_type{};
   };
 
-  return std::apply([&](auto&... p) { return (return_type{} ^ ... ^ process_one(p)); }, intern_);
+  return_type result{};
+  each_component([&](auto& p) { result ^= process_one(p); });
+  return result;
 }
 
 template <typename... Ps>
@@ -382,7 +566,9 @@ uint32_t CACHE::prefetcher_module_model<Ps...>::impl_prefetcher_cache_fill(champ
     return return_type{};
   };
 
-  return std::apply([&](auto&... p) { return (return_type{} ^ ... ^ process_one(p)); }, intern_);
+  return_type result{};
+  each_component([&](auto& p) { result ^= process_one(p); });
+  return result;
 }
 
 template <typename... Ps>
@@ -394,7 +580,7 @@ void CACHE::prefetcher_module_model<Ps...>::impl_prefetcher_cycle_operate()
       p.prefetcher_cycle_operate();
   };
 
-  std::apply([&](auto&... p) { (..., process_one(p)); }, intern_);
+  each_component(process_one);
 }
 
 template <typename... Ps>
@@ -420,7 +606,7 @@ void CACHE::prefetcher_module_model<Ps...>::impl_prefetcher_branch_operate(champ
       p.prefetcher_branch_operate(ip.to<uint64_t>(), branch_type, branch_target.to<uint64_t>());
   };
 
-  std::apply([&](auto&... p) { (..., process_one(p)); }, intern_);
+  each_component(process_one);
 }
 
 template <typename... Rs>
@@ -23,6 +23,7 @@
 #include <limits>
 #include <optional>
 
+#include "cache_geometry.h"
 #include "champsim.h"
 #include "channel.h"
 #include "chrono.h"
@@ -37,6 +38,16 @@ template <typename... Ts>
 class cache_builder_module_type_holder
 {
 };
+
+/**
+ * How the contents of a cache relate to the contents of the caches above it.
+ */
+enum class inclusion_policy {
+  NINE,      // neither inclusive nor exclusive
+  INCLUSIVE, // the upper levels are invalidated when a block is evicted
+  EXCLUSIVE, // blocks move to the upper levels when they hit, and are filled by the victims of the upper levels
+};
+
 namespace detail
 {
 struct cache_builder_base {
@@ -57,6 +68,19 @@ struct cache_builder_base {
   bool m_pref_load{};
   bool m_wq_full_addr{};
   bool m_va_pref{};
+  bool m_pf_throttle{};
+  bool m_pf_ensemble{};
+  bool m_way_partition{};
+
+  struct static_geometry_type {
+    uint32_t sets;
+    uint32_t ways;
+    champsim::data::bits offset_bits;
+  };
+  std::optional<static_geometry_type> m_static_geometry{};
+  std::optional<uint32_t> m_sampled_sets{};
+  std::optional<uint32_t> m_pf_filter{};
+  inclusion_policy m_inclusion{inclusion_policy::NINE};
 
   std::vector<access_type> m_pref_act_mask{access_type::LOAD, access_type::PREFETCH};
   std::vector<champsim::channel*> m_uls{};
@@ -81,6 +105,7 @@ class cache_builder : public detail::cache_builder_base
 
   uint32_t get_num_sets() const;
   uint32_t get_num_ways() const;
+  std::optional<uint32_t> get_num_sampled_sets() const;
   uint32_t get_num_mshrs() const;
   champsim::bandwidth::maximum_type get_tag_bandwidth() const;
   champsim::bandwidth::maximum_type get_fill_bandwidth() const;
@@ -182,6 +207,36 @@ public:
    */
   self_type& log2_offset_bits(unsigned log2_offset_bits_);
 
+  /**
+   * Fix the number of sets, the number of ways, and the number of offset bits when the simulator is compiled.
+   * The geometry is checked when the simulator is compiled, and the cache throws std::invalid_argument if it is later given other sets, ways, or offset bits.
+   */
+  template <uint32_t Sets, uint32_t Ways, unsigned OffsetBits>
+  self_type& static_geometry();
+
+  /**
+   * Simulate only this many of the sets in detail. The number is rounded up to a power of two.
+   *
+   * Whether an access to one of the other sets hits is modeled from the miss rate of the sampled sets, and the misses are sent to the lower level.
+   * Those misses are not held in MSHRs or filled. They are answered after the miss latency of the sampled sets, and a write that dirties a block is
+   * written back to the lower level right away. The hits and misses in the statistics are extrapolated to the whole cache.
+   */
+  self_type& sampled_sets(uint32_t sampled_sets_);
+
+  /**
+   * Drop prefetches to blocks that were recently prefetched or filled, using a counting Bloom filter of this many counters.
+   * The number is rounded up to a power of two.
+   */
+  self_type& prefetch_filter(uint32_t counters_);
+
+  /**
+   * Specify how the contents of the cache relate to the contents of the caches above it.
+   *
+   * An inclusive cache invalidates a block in the levels above it when it evicts the block.
+   * An exclusive cache gives up a block when a level above it reads the block, and is filled by the victims of the levels above it, clean or dirty.
+   */
+  self_type& inclusion(inclusion_policy inclusion_);
+
   /**
    * Specify that prefetches should be issued with the same priority as loads.
    */
@@ -212,6 +267,38 @@ public:
    */
   self_type& reset_virtual_prefetch();
 
+  /**
+   * Specify that the prefetches admitted should be throttled by the accuracy, lateness, and pollution of the prefetches and by the DRAM bandwidth.
+   */
+  self_type& set_prefetch_throttle();
+
+  /**
+   * Specify that every prefetch should be admitted while the prefetch queue has room.
+   */
+  self_type& reset_prefetch_throttle();
+
+  /**
+   * Specify that the prefetchers of this cache should be arbitrated. Candidates that another prefetcher issued recently are dropped, and the
+   * prefetch queue is shared out by the recent accuracy of each prefetcher. This has no effect on a cache with a single prefetcher.
+   */
+  self_type& set_prefetch_ensemble();
+
+  /**
+   * Specify that the prefetchers of this cache should each issue independently.
+   */
+  self_type& reset_prefetch_ensemble();
+
+  /**
+   * Specify that the ways of this cache should be partitioned between the cores by utility-based cache partitioning. The allocations are
+   * recomputed periodically from sampled utility monitors, and enforced by restricting the victims the replacement policy may choose.
+   */
+  self_type& set_way_partitioning();
+
+  /**
+   * Specify that the cores may allocate any way of this cache.
+   */
+  self_type& reset_way_partitioning();
+
   /**
    * Specify the ``access_type`` values that should activate the prefetcher.
    */
@@ -270,6 +357,14 @@ auto champsim::cache_builder<P, R>::get_num_ways() const -> uint32_t
   return 1;
 }
 
+template <typename P, typename R>
+auto champsim::cache_builder<P, R>::get_num_sampled_sets() const -> std::optional<uint32_t>
+{
+  if (!m_sampled_sets.has_value() || champsim::next_pow2(m_sampled_sets.value()) >= get_num_sets())
+    return std::nullopt;
+  return std::max(champsim::next_pow2(m_sampled_sets.value()), 1u);
+}
+
 template <typename P, typename R>
 auto champsim::cache_builder<P, R>::get_num_mshrs() const -> uint32_t
 {
@@ -443,6 +538,39 @@ auto champsim::cache_builder<P, R>::log2_offset_bits(unsigned log2_offset_bits_)
   return offset_bits(champsim::data::bits{1ull << log2_offset_bits_});
 }
 
+template <typename P, typename R>
+template <uint32_t Sets, uint32_t Ways, unsigned OffsetBits>
+auto champsim::cache_builder<P, R>::static_geometry() -> self_type&
+{
+  using geometry_type = champsim::static_cache_geometry<Sets, Ways, OffsetBits>;
+  m_sets = geometry_type::sets;
+  m_ways = geometry_type::ways;
+  m_offset_bits = champsim::data::bits{geometry_type::offset_bits};
+  m_static_geometry = static_geometry_type{geometry_type::sets, geometry_type::ways, m_offset_bits};
+  return *this;
+}
+
+template <typename P, typename R>
+auto champsim::cache_builder<P, R>::sampled_sets(uint32_t sampled_sets_) -> self_type&
+{
+  m_sampled_sets = sampled_sets_;
+  return *this;
+}
+
+template <typename P, typename R>
+auto champsim::cache_builder<P, R>::prefetch_filter(uint32_t counters_) -> self_type&
+{
+  m_pf_filter = counters_;
+  return *this;
+}
+
+template <typename P, typename R>
+auto champsim::cache_builder<P, R>::inclusion(inclusion_policy inclusion_) -> self_type&
+{
+  m_inclusion = inclusion_;
+  return *this;
+}
+
 template <typename P, typename R>
 auto champsim::cache_builder<P, R>::set_prefetch_as_load() -> self_type&
 {
@@ -485,6 +613,48 @@ auto champsim::cache_builder<P, R>::reset_virtual_prefetch() -> self_type&
   return *this;
 }
 
+template <typename P, typename R>
+auto champsim::cache_builder<P, R>::set_prefetch_throttle() -> self_type&
+{
+  m_pf_throttle = true;
+  return *this;
+}
+
+template <typename P, typename R>
+auto champsim::cache_builder<P, R>::reset_prefetch_throttle() -> self_type&
+{
+  m_pf_throttle = false;
+  return *this;
+}
+
+template <typename P, typename R>
+auto champsim::cache_builder<P, R>::set_prefetch_ensemble() -> self_type&
+{
+  m_pf_ensemble = true;
+  return *this;
+}
+
+template <typename P, typename R>
+auto champsim::cache_builder<P, R>::reset_prefetch_ensemble() -> self_type&
+{
+  m_pf_ensemble = false;
+  return *this;
+}
+
+template <typename P, typename R>
+auto champsim::cache_builder<P, R>::set_way_partitioning() -> self_type&
+{
+  m_way_partition = true;
+  return *this;
+}
+
+template <typename P, typename R>
+auto champsim::cache_builder<P, R>::reset_way_partitioning() -> self_type&
+{
+  m_way_partition = false;
+  return *this;
+}
+
 template <typename P, typename R>
 template <typename... Elems>
 auto champsim::cache_builder<P, R>::prefetch_activate(Elems... pref_act_elems) -> self_type&
@@ -0,0 +1,59 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CACHE_GEOMETRY_H
+#define CACHE_GEOMETRY_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "util/bits.h"
+#include "util/tag_match.h"
+
+namespace champsim
+{
+/**
+ * The geometry of a cache, fixed when the simulator is compiled.
+ *
+ * Locating a block compiles to a shift and a mask, and the ways of a set are compared with ``find_tag()`` for a constant number of ways.
+ * ``cache_builder::static_geometry()`` uses this to check the geometry of a cache when the simulator is compiled.
+ */
+template <uint32_t Sets, uint32_t Ways, unsigned OffsetBits>
+struct static_cache_geometry {
+  static_assert(Sets > 0 && champsim::is_power_of_2(Sets), "The number of sets must be a power of two");
+  static_assert(Ways > 0, "A cache must have at least one way");
+
+  constexpr static uint32_t sets = Sets;
+  constexpr static uint32_t ways = Ways;
+  constexpr static unsigned offset_bits = OffsetBits;
+
+  [[nodiscard]] constexpr static std::size_t set_index(uint64_t addr) { return static_cast<std::size_t>((addr >> OffsetBits) & (Sets - 1)); }
+
+  // The tag is offset by one so that a zero tag never matches
+  [[nodiscard]] constexpr static uint64_t tag(uint64_t addr) { return (addr >> OffsetBits) + 1; }
+
+  /**
+   * Find the way of the cache that holds the address, given the tags of every block in the cache.
+   * Returns the number of ways if the address is not present.
+   */
+  [[nodiscard]] static std::size_t find_way(const uint64_t* tags, uint64_t addr)
+  {
+    return champsim::find_tag(tags + set_index(addr) * Ways, Ways, tag(addr));
+  }
+};
+} // namespace champsim
+
+#endif
@@ -0,0 +1,75 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef CACHE_PROFILER_H
+#define CACHE_PROFILER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+#include "access_type.h"
+#include "address.h"
+#include "util/space_saving.h"
+
+namespace champsim
+{
+/**
+ * Counts the hits, misses, and evictions of each set of a cache, and the load instructions that miss most often.
+ *
+ * The loads are tracked in a fixed number of counters, so the memory used does not grow with the footprint of the program.
+ * A default-constructed profiler is disabled, and CACHE checks enabled() before recording anything.
+ */
+class cache_profiler
+{
+  std::ostream* out = nullptr;
+  std::vector<uint64_t> set_hits{};
+  std::vector<uint64_t> set_misses{};
+  std::vector<uint64_t> set_evictions{};
+  champsim::space_saving<champsim::address> load_miss_ips{};
+
+public:
+  cache_profiler() = default;
+
+  /**
+   * :param stream: The stream to receive the profile at the end of each phase.
+   * :param num_sets: The number of sets in the profiled cache.
+   * :param top_ips: The number of load instructions to track.
+   */
+  cache_profiler(std::ostream& stream, std::size_t num_sets, std::size_t top_ips);
+
+  [[nodiscard]] bool enabled() const { return out != nullptr; }
+
+  void record_access(long set, champsim::address ip, access_type type, bool hit);
+  void record_eviction(long set);
+
+  [[nodiscard]] uint64_t hits(long set) const { return set_hits.at(static_cast<std::size_t>(set)); }
+  [[nodiscard]] uint64_t misses(long set) const { return set_misses.at(static_cast<std::size_t>(set)); }
+  [[nodiscard]] uint64_t evictions(long set) const { return set_evictions.at(static_cast<std::size_t>(set)); }
+  [[nodiscard]] auto top_load_misses() const { return load_miss_ips.top(); }
+
+  /**
+   * Write the profile of a phase. Only the sets that were accessed or evicted from are written.
+   */
+  void write(std::string_view cache_name, std::string_view phase_name) const;
+  void clear();
+};
+} // namespace champsim
+
+#endif
@@ -5,6 +5,7 @@
 #include <string>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "channel.h"
 #include "event_counter.h"
@@ -18,11 +19,52 @@ struct cache_stats {
   uint64_t pf_useless = 0;
   uint64_t pf_fill = 0;
 
+  // prefetch timeliness and pollution
+  uint64_t pf_late = 0;            // demands that merged into a prefetch of this cache still in flight
+  long pf_late_cycles_saved{};     // cycles by which the late prefetches were issued ahead of their demands
+  long pf_late_cycles_lost{};      // cycles the demands still waited for the late prefetches
+  uint64_t pf_pollution = 0;       // demand misses to blocks that were evicted by prefetches
+  uint64_t pf_throttled = 0;       // prefetches refused by the throttle
+  uint64_t pf_filtered = 0;        // prefetches dropped as duplicates of recent prefetches or fills
+
+  // batched prefetch candidates
+  uint64_t pf_candidates = 0;          // candidates pushed by the prefetchers
+  uint64_t pf_candidates_filtered = 0; // candidates that were already cached, in flight, or pending
+  uint64_t pf_candidates_dropped = 0;  // candidates dropped for candidates of higher priority
+
+  // prefetch outcomes by the metadata the prefetch was issued with
+  champsim::stats::event_counter<uint32_t> pf_issued_by_metadata = {};
+  champsim::stats::event_counter<uint32_t> pf_useful_by_metadata = {};
+  champsim::stats::event_counter<uint32_t> pf_useless_by_metadata = {};
+  champsim::stats::event_counter<uint32_t> pf_late_by_metadata = {};
+  champsim::stats::event_counter<uint32_t> pf_pollution_by_metadata = {};
+
+  // prefetch outcomes by the prefetcher that issued them, if the prefetchers are arbitrated
+  champsim::stats::event_counter<std::size_t> pf_issued_by_component = {};
+  champsim::stats::event_counter<std::size_t> pf_useful_by_component = {};
+  champsim::stats::event_counter<std::size_t> pf_useless_by_component = {};
+  champsim::stats::event_counter<std::size_t> pf_duplicate_by_component = {}; // dropped because another prefetcher issued them recently
+  champsim::stats::event_counter<std::size_t> pf_over_quota_by_component = {}; // dropped because the prefetcher had its share of the queue
+
+  // way partitioning, at the end of the phase
+  std::vector<uint32_t> way_allocation{}; // the ways allocated to each core, if the cache is partitioned
+  uint64_t repartitions = 0;
+
+  // inclusion stats
+  uint64_t back_invalidations = 0; // evictions that invalidated the block in the upper levels
+  uint64_t inclusion_victims = 0;  // blocks invalidated because a lower level evicted them
+
   champsim::stats::event_counter<std::pair<access_type, std::remove_cv_t<decltype(NUM_CPUS)>>> hits = {};
   champsim::stats::event_counter<std::pair<access_type, std::remove_cv_t<decltype(NUM_CPUS)>>> misses = {};
   champsim::stats::event_counter<std::pair<access_type, std::remove_cv_t<decltype(NUM_CPUS)>>> mshr_merge = {};
   champsim::stats::event_counter<std::pair<access_type, std::remove_cv_t<decltype(NUM_CPUS)>>> mshr_return = {};
 
+  // With set sampling, the hits and misses above are extrapolated to the whole cache. These count only the sets simulated in detail.
+  uint64_t sets = 0;
+  uint64_t sampled_sets = 0;
+  champsim::stats::event_counter<std::pair<access_type, std::remove_cv_t<decltype(NUM_CPUS)>>> sampled_hits = {};
+  champsim::stats::event_counter<std::pair<access_type, std::remove_cv_t<decltype(NUM_CPUS)>>> sampled_misses = {};
+
   long total_miss_latency_cycles{};
 };
 
@@ -0,0 +1,77 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CACHE_SWEEP_H
+#define CACHE_SWEEP_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "address.h"
+#include "environment.h"
+#include "phase_info.h"
+#include "tracereader.h"
+
+namespace champsim
+{
+/**
+ * Per-set LRU stack distances for a range of power-of-two set counts, recorded in a single pass.
+ *
+ * For a fixed number of sets, an LRU cache with W ways hits exactly when the stack distance within the set is less than W,
+ * so one histogram per set count gives the miss count of every associativity up to the maximum.
+ */
+class stack_distance_profile
+{
+  std::size_t max_ways_;
+  std::vector<std::size_t> set_counts_;
+  std::vector<std::vector<uint64_t>> stacks_;    // per set count: sets * max_ways tags, most recent first, 0 marks an empty entry
+  std::vector<std::vector<uint64_t>> histogram_; // per set count: hits at each stack distance
+  uint64_t accesses_ = 0;
+
+public:
+  stack_distance_profile(std::size_t min_sets, std::size_t max_sets, std::size_t max_ways);
+
+  void access(champsim::block_number block);
+  void clear_stats();
+
+  [[nodiscard]] uint64_t accesses() const;
+  [[nodiscard]] uint64_t misses(std::size_t sets, std::size_t ways) const;
+  [[nodiscard]] const std::vector<std::size_t>& set_counts() const;
+  [[nodiscard]] std::size_t max_ways() const;
+};
+
+struct miss_ratio_curve {
+  std::string name;
+  std::size_t NUM_SET = 0;
+  std::size_t NUM_WAY = 0;
+
+  std::vector<std::size_t> sets{};
+  std::vector<std::size_t> ways{};
+  uint64_t accesses = 0;
+  std::vector<std::vector<uint64_t>> misses{}; // indexed [sets][ways]
+};
+
+/**
+ * Stream the data accesses of each trace through the L1D-to-LLC path of its core, profiling every level in one pass.
+ *
+ * Each level is filtered by an LRU model of its configured geometry, so the next level sees the miss stream of the configured cache.
+ * Accesses use virtual block addresses, and writebacks, prefetches, and instruction fetches are not modeled.
+ */
+std::vector<miss_ratio_curve> cache_sweep_main(environment& env, std::vector<phase_info>& phases, std::vector<tracereader>& traces);
+} // namespace champsim
+
+#endif
@@ -21,12 +21,17 @@
 #include <cstdint>
 #include <deque>
 #include <limits>
+#include <optional>
 #include <string_view>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "access_type.h"
 #include "address.h"
 #include "champsim.h"
+#include "util/ring_buffer.h"
+#include "util/shared_list.h"
 
 namespace champsim
 {
@@ -53,6 +58,7 @@ class channel
     bool forward_checked = false;
     bool is_translated = true;
     bool response_requested = true;
+    bool clean = false; // a writeback of a block that was not modified, for an exclusive lower level
 
     uint8_t asid[2] = {std::numeric_limits<uint8_t>::max(), std::numeric_limits<uint8_t>::max()};
     access_type type{access_type::LOAD};
@@ -66,7 +72,7 @@ class channel
     uint64_t instr_id = 0;
     champsim::address ip{};
 
-    std::vector<uint64_t> instr_depend_on_me{};
+    champsim::shared_list<uint64_t> instr_depend_on_me{};
   };
 
   struct response {
@@ -74,17 +80,44 @@ class channel
     champsim::address v_address{};
     champsim::address data{};
     uint32_t pf_metadata = 0;
-    std::vector<uint64_t> instr_depend_on_me{};
+    unsigned miss_levels = 0; // the number of cache levels this block missed in before it was found
+    champsim::shared_list<uint64_t> instr_depend_on_me{};
 
-    response(champsim::address addr, champsim::address v_addr, champsim::address data_, uint32_t pf_meta, std::vector<uint64_t> deps)
-        : address(addr), v_address(v_addr), data(data_), pf_metadata(pf_meta), instr_depend_on_me(deps)
+    response(champsim::address addr, champsim::address v_addr, champsim::address data_, uint32_t pf_meta, champsim::shared_list<uint64_t> deps)
+        : address(addr), v_address(v_addr), data(data_), pf_metadata(pf_meta), instr_depend_on_me(std::move(deps))
     {
     }
     explicit response(request req) : response(req.address, req.v_address, req.data, req.pf_metadata, req.instr_depend_on_me) {}
   };
 
+  // The block addresses of the requests in a queue, so that collisions can be found without searching the queue.
+  // Consumers are expected to remove requests from the front of the queues, which is detected by the change in the queue's size.
+  // If the ends of the queue no longer match the index afterward, a request was removed from elsewhere, and the index is rebuilt.
+  class request_index
+  {
+    struct queued {
+      uint64_t sequence;
+      uint64_t key;
+    };
+
+    std::deque<queued> order{}; // parallel to the queue
+    std::unordered_multimap<uint64_t, uint64_t> sequences_by_key{};
+    uint64_t next_sequence = 0;
+
+  public:
+    void push_back(uint64_t key);
+    void erase(std::size_t pos);
+    void drop_front(std::size_t queue_size);
+    void clear();
+    [[nodiscard]] bool matches_ends(uint64_t front_key, uint64_t back_key) const;
+    [[nodiscard]] std::optional<std::size_t> find(uint64_t key) const;
+  };
+
+  template <typename R>
+  void sync_index(const R& queue, request_index& index, champsim::data::bits shamt);
+
   template <typename R>
-  bool do_add_queue(R& queue, std::size_t queue_size, const typename R::value_type& packet);
+  bool do_add_queue(R& queue, request_index& index, champsim::data::bits shamt, std::size_t queue_size, const typename R::value_type& packet);
 
   std::size_t RQ_SIZE = std::numeric_limits<std::size_t>::max();
   std::size_t PQ_SIZE = std::numeric_limits<std::size_t>::max();
@@ -92,13 +125,25 @@ class channel
   champsim::data::bits OFFSET_BITS{};
   bool match_offset_bits = false;
 
+  request_index RQ_index{}, PQ_index{}, WQ_index{};
+
+  [[nodiscard]] champsim::data::bits read_shamt() const;
+  [[nodiscard]] champsim::data::bits write_shamt() const;
+
 public:
   using response_type = response;
   using request_type = request;
   using stats_type = cache_queue_stats;
 
-  std::deque<request_type> RQ{}, PQ{}, WQ{};
-  std::deque<response_type> returned{};
+  champsim::ring_buffer<request_type> RQ{}, PQ{}, WQ{};
+  champsim::ring_buffer<response_type> returned{};
+
+  // Blocks evicted by an inclusive lower level, which the upper level must also invalidate. Only upper levels that hold blocks accept them.
+  bool accepts_invalidations = false;
+  champsim::ring_buffer<champsim::address> invalidations{};
+
+  // Set by an exclusive lower level, which is filled by the clean victims of the upper level as well as the dirty ones
+  bool writeback_clean_victims = false;
 
   stats_type sim_stats{}, roi_stats{};
 
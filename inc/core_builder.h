@@ -17,10 +17,14 @@
 #ifndef CORE_BUILDER_H
 #define CORE_BUILDER_H
 
+#include <array>
 #include <cstdint>
 #include <limits>
+#include <optional>
+#include <stdexcept>
 
 #include "chrono.h"
+#include "op_class.h"
 
 class CACHE;
 class O3_CPU;
@@ -33,6 +37,12 @@ class core_builder_module_type_holder
 };
 namespace detail
 {
+struct execute_class_spec {
+  unsigned latency;
+  champsim::bandwidth::maximum_type ports;
+  bool pipelined;
+};
+
 struct core_builder_base {
   uint32_t m_cpu{};
   champsim::chrono::picoseconds m_clock_period{250};
@@ -68,6 +78,8 @@ struct core_builder_base {
   unsigned m_schedule_latency{};
   unsigned m_execute_latency{};
 
+  std::array<std::optional<execute_class_spec>, static_cast<std::size_t>(op_class::NUM_CLASSES)> m_execute_classes{};
+
   CACHE* m_l1i{};
   champsim::bandwidth::maximum_type m_l1i_bw{1};
   champsim::bandwidth::maximum_type m_l1d_bw{1};
@@ -225,6 +237,13 @@ public:
    */
   self_type& execute_latency(unsigned execute_latency_);
 
+  /**
+   * Specify the execution latency and the number of functional units for a class of instructions.
+   * A pipelined unit accepts a new instruction every cycle, otherwise it is busy for the full latency.
+   * Classes that are not specified use the execute latency and have as many pipelined units as the execute width.
+   */
+  self_type& execute_class(op_class class_, unsigned latency_, champsim::bandwidth::maximum_type ports_, bool pipelined_ = true);
+
   /**
    * Specify the latency of execution.
    */
@@ -465,6 +484,17 @@ auto champsim::core_builder<B, T>::execute_latency(unsigned execute_latency_) ->
   return *this;
 }
 
+template <typename B, typename T>
+auto champsim::core_builder<B, T>::execute_class(op_class class_, unsigned latency_, champsim::bandwidth::maximum_type ports_, bool pipelined_) -> self_type&
+{
+  // A class without ports could never issue, and the core would deadlock
+  if (static_cast<long>(ports_) <= 0) {
+    throw std::invalid_argument{"An execute class must have at least one port"};
+  }
+  m_execute_classes.at(static_cast<std::size_t>(class_)) = detail::execute_class_spec{latency_, ports_, pipelined_};
+  return *this;
+}
+
 template <typename B, typename T>
 auto champsim::core_builder<B, T>::l1i(CACHE* l1i_) -> self_type&
 {
@@ -1,12 +1,37 @@
 #ifndef CORE_STATS_H
 #define CORE_STATS_H
 
+#include <array>
 #include <cstdint>
 #include <string>
+#include <string_view>
 
 #include "event_counter.h"
 #include "instruction.h"
 
+// Each cycle is attributed to exactly one component of the CPI stack
+enum class cpi_component : unsigned {
+  RETIRING = 0,      // at least one instruction retired
+  L1D_BOUND,         // the ROB head waits on a load that hit in the L1D
+  L2C_BOUND,         // ... that missed in one cache level
+  LLC_BOUND,         // ... that missed in two cache levels
+  DRAM_BOUND,        // ... that missed in three or more cache levels
+  ICACHE_MISS,       // the ROB is empty and the oldest fetch waits on the L1I
+  FRONTEND_STARVED,  // the ROB is empty and the DIB and decoder have not delivered
+  BRANCH_MISPREDICT, // the ROB is empty and fetch is recovering from a misprediction
+  ROB_FULL,          // dispatch is blocked by a full ROB
+  LQ_FULL,           // dispatch is blocked by a full load queue
+  SQ_FULL,           // dispatch is blocked by a full store queue
+  REGISTERS_FULL,    // scheduling is blocked by a full register file
+  CORE_BOUND,        // the ROB head waits on execution or dependencies
+  NUM_COMPONENTS
+};
+
+using namespace std::literals::string_view_literals;
+inline constexpr std::array<std::string_view, static_cast<std::size_t>(cpi_component::NUM_COMPONENTS)> cpi_component_names{
+    "RETIRING"sv,          "L1D_BOUND"sv, "L2C_BOUND"sv, "LLC_BOUND"sv, "DRAM_BOUND"sv,     "ICACHE_MISS"sv, "FRONTEND_STARVED"sv,
+    "BRANCH_MISPREDICT"sv, "ROB_FULL"sv,  "LQ_FULL"sv,   "SQ_FULL"sv,   "REGISTERS_FULL"sv, "CORE_BOUND"sv};
+
 struct cpu_stats {
   std::string name;
   long long begin_instrs = 0;
@@ -17,6 +42,7 @@ struct cpu_stats {
 
   champsim::stats::event_counter<branch_type> total_branch_types = {};
   champsim::stats::event_counter<branch_type> branch_type_misses = {};
+  champsim::stats::event_counter<cpi_component> cpi_stack = {};
 
   [[nodiscard]] auto instrs() const { return end_instrs - begin_instrs; }
   [[nodiscard]] auto cycles() const { return end_cycles - begin_cycles; }
@@ -17,8 +17,17 @@
 #ifndef __DPC_API_H__
 #define __DPC_API_H__
 
+#include <cstddef>
 #include <cstdint>
 
+namespace champsim
+{
+struct environment;
+
+// Direct the functions below to the given environment. Until this is called, they all return 0.
+void attach_dpc_api(environment& env);
+} // namespace champsim
+
 //--------------------------------------------------------------------//
 // Get instanteneous DRAM bandwdith estimate.
 //
@@ -30,4 +39,51 @@
 //--------------------------------------------------------------------//
 uint8_t get_dram_bw();
 
+//--------------------------------------------------------------------//
+// Get the number of DRAM channels.
+//--------------------------------------------------------------------//
+std::size_t get_dram_channels();
+
+//--------------------------------------------------------------------//
+// Get the read (or write) bandwidth estimate of one DRAM channel.
+//
+// As with get_dram_bw(), the return value is a 4-bit quantized
+// utilization of the channel's data bus over the same window, counting
+// only the cycles in which the bus carries read (or write) data.
+//--------------------------------------------------------------------//
+uint8_t get_dram_read_bw(std::size_t channel);
+uint8_t get_dram_write_bw(std::size_t channel);
+
+//--------------------------------------------------------------------//
+// Get the share of the DRAM traffic issued by a core.
+//
+// The return value is the 4-bit quantized fraction of the DRAM data bus
+// transfers within the bandwidth window that were issued by the core.
+// For example, a return value of 8 denotes that the core issued about
+// half of the recent DRAM traffic.
+//--------------------------------------------------------------------//
+uint8_t get_dram_core_share(uint32_t cpu);
+
+//--------------------------------------------------------------------//
+// Get the average DRAM queueing latency.
+//
+// The return value is a moving average, in DRAM controller cycles, of
+// the time from a request's arrival at the memory controller until its
+// data transfer begins, averaged across all DRAM channels.
+//--------------------------------------------------------------------//
+uint64_t get_dram_queue_latency();
+
+//--------------------------------------------------------------------//
+// Get the occupancy of the LLC MSHRs.
+//
+// The return value is the 4-bit quantized fraction of the MSHRs in use,
+// summed across all caches that miss directly to DRAM.
+//--------------------------------------------------------------------//
+uint8_t get_llc_mshr_occupancy();
+
+//--------------------------------------------------------------------//
+// Get the IPC of a core over the current phase.
+//--------------------------------------------------------------------//
+double get_core_ipc(uint32_t cpu);
+
 #endif /* __DPC_API_H__ */
@@ -21,16 +21,17 @@
 #include <cmath>
 #include <cstddef>  // for size_t
 #include <cstdint>  // for uint64_t, uint32_t, uint8_t
-#include <deque>    // for deque
 #include <iterator> // for end
 #include <limits>
 #include <memory>
 #include <optional>
 #include <string>
+#include <vector>
 
 #include "address.h"
 #include "channel.h"
 #include "chrono.h"
+#include "dram_scheduler.h"
 #include "dram_stats.h"
 #include "extent_set.h"
 #include "operable.h"
@@ -103,14 +104,19 @@ struct DRAM_CHANNEL final : public champsim::operable {
     uint8_t asid[2] = {std::numeric_limits<uint8_t>::max(), std::numeric_limits<uint8_t>::max()};
 
     uint32_t pf_metadata = 0;
+    uint32_t cpu = std::numeric_limits<uint32_t>::max();
 
     champsim::address address{};
     champsim::address v_address{};
     champsim::address data{};
     champsim::chrono::clock::time_point ready_time = champsim::chrono::clock::time_point::max();
+    champsim::chrono::clock::time_point arrival_time{};
 
-    std::vector<uint64_t> instr_depend_on_me{};
-    std::vector<std::deque<response_type>*> to_return{};
+    std::size_t bank = 0;  // the index of the bank, found when the request passes the collision check
+    unsigned long row = 0; // the row of the bank
+
+    champsim::shared_list<uint64_t> instr_depend_on_me{};
+    uint64_t to_return = 0; // the indices of the upper levels to respond to, as a bitmask
 
     explicit request_type(const typename champsim::channel::request_type& req);
   };
@@ -119,6 +125,9 @@ struct DRAM_CHANNEL final : public champsim::operable {
   queue_type WQ;
   queue_type RQ;
 
+  // The queues that responses are returned to, indexed by the bits of each request's to_return
+  std::vector<champsim::channel*> upper_levels{};
+
   /*
    * | row address | rank index | column address | bank index | channel | block
    * offset |
@@ -140,6 +149,16 @@ struct DRAM_CHANNEL final : public champsim::operable {
   request_array_type bank_request;
   request_array_type::iterator active_request;
 
+  /*
+   * The slots of a queue that hold requests which passed the collision check, grouped by bank.
+   * Each bank keeps its slots in the order that FR-FCFS would pick them: by ready time, then the later slot first.
+   */
+  struct bank_queue_set {
+    std::vector<std::vector<std::size_t>> banks{};
+    std::size_t occupancy = 0;
+  };
+  bank_queue_set RQ_banks, WQ_banks;
+
   // track bankgroup accesses
   std::vector<champsim::chrono::clock::time_point> bankgroup_readytime{address_mapping.ranks() * address_mapping.bankgroups(),
                                                                        champsim::chrono::clock::time_point{}};
@@ -157,17 +176,33 @@ struct DRAM_CHANNEL final : public champsim::operable {
   using stats_type = dram_stats;
   stats_type roi_stats, sim_stats;
 
+  // Ranks the cores whose requests are waiting
+  champsim::dram_scheduler scheduler{};
+
   // Latencies
   const champsim::chrono::clock::duration tRP, tRCD, tCAS, tRAS, tREF, tRFC, DRAM_DBUS_TURN_AROUND_TIME, DRAM_DBUS_RETURN_TIME, DRAM_DBUS_BANKGROUP_STALL;
 
   // data bus period
   champsim::chrono::picoseconds data_bus_period{};
   champsim::chrono::clock::time_point dq_payload_until{}; // End time of ongoing payload transfer window on dbus
+  bool dq_payload_write = false;                                  // Whether the ongoing payload transfer is a write
+  uint32_t dq_payload_cpu = std::numeric_limits<uint32_t>::max(); // The core that issued the ongoing payload transfer
+
+  // Moving average (1/16 weight) of the time from a request's arrival until its payload transfer begins
+  champsim::chrono::clock::duration avg_queue_latency{};
+
+  // While the channel is idle, it skips its work until its next event. The memory controller wakes it when a request arrives.
+  champsim::chrono::clock::time_point idle_until{};
+  long idle_progress = 0;
 
   DRAM_CHANNEL(champsim::chrono::picoseconds dbus_period, champsim::chrono::picoseconds mc_period, std::size_t t_rp, std::size_t t_rcd, std::size_t t_cas,
                std::size_t t_ras, champsim::chrono::microseconds refresh_period, std::size_t refreshes_per_period, champsim::data::bytes width,
                std::size_t rq_size, std::size_t wq_size, DRAM_ADDRESS_MAPPING addr_mapping);
 
+  bool in_write_queue(queue_type::const_iterator pkt) const;
+  void enqueue(queue_type::iterator pkt);
+  void dequeue(queue_type::iterator pkt);
+
   void check_write_collision();
   void check_read_collision();
   long finish_dbus_request();
@@ -183,6 +218,18 @@ struct DRAM_CHANNEL final : public champsim::operable {
   void end_phase(unsigned cpu) final;
   void print_deadlock() final;
 
+  /**
+   * Whether the channel has no requests, and so has nothing to do until its next event.
+   */
+  [[nodiscard]] bool idle() const;
+
+  /**
+   * The earliest time at which the state of the channel changes without a new request: the next refresh, or when a bank or the data bus becomes ready.
+   */
+  [[nodiscard]] champsim::chrono::clock::time_point next_event_time() const;
+
+  void wake() { idle_until = {}; }
+
   std::size_t bank_request_capacity() const;
   std::size_t bankgroup_request_capacity() const;
   [[nodiscard]] champsim::data::bytes density() const;
@@ -197,7 +244,7 @@ class MEMORY_CONTROLLER : public champsim::operable
   const champsim::data::bytes channel_width;
 
   void initiate_requests();
-  bool add_rq(const request_type& packet, champsim::channel* ul);
+  bool add_rq(const request_type& packet, std::size_t upper_level);
   bool add_wq(const request_type& packet);
 
   const DRAM_ADDRESS_MAPPING address_mapping;
@@ -252,13 +299,18 @@ class MEMORY_CONTROLLER : public champsim::operable
   BwBucketWinMulti bw_sys{};
   uint8_t bw_bucket16_sys{0};
 
+  // The same windows, restricted to the reads or the writes of each channel, and to the transfers of each core
+  std::vector<BwBucketWinMulti> bw_read_by_channel;
+  std::vector<BwBucketWinMulti> bw_write_by_channel;
+  std::vector<BwBucketWinMulti> bw_by_cpu;
+
 public:
   std::vector<DRAM_CHANNEL> channels;
 
   MEMORY_CONTROLLER(champsim::chrono::picoseconds dbus_period, champsim::chrono::picoseconds mc_period, std::size_t t_rp, std::size_t t_rcd, std::size_t t_cas,
                     std::size_t t_ras, champsim::chrono::microseconds refresh_period, std::vector<channel_type*>&& ul, std::size_t rq_size, std::size_t wq_size,
                     std::size_t chans, champsim::data::bytes chan_width, std::size_t rows, std::size_t columns, std::size_t ranks, std::size_t bankgroups,
-                    std::size_t banks, std::size_t refreshes_per_period);
+                    std::size_t banks, std::size_t refreshes_per_period, champsim::dram_scheduler sched = champsim::dram_scheduler{});
 
   uint64_t operate_total = 0;
   uint64_t bw_hist[16] = {0};
@@ -271,6 +323,22 @@ public:
 
   uint8_t get_bw() { return bw_bucket16_sys; }
 
+  /**
+   * The 4-bit quantized read (or write) utilization of one channel's data bus, over the same window as get_bw()
+   */
+  [[nodiscard]] uint8_t get_read_bw(std::size_t channel) const;
+  [[nodiscard]] uint8_t get_write_bw(std::size_t channel) const;
+
+  /**
+   * The 4-bit quantized share of the data bus transfers in the window that were issued by the given core
+   */
+  [[nodiscard]] uint8_t get_cpu_share(uint32_t cpu) const;
+
+  /**
+   * The average time requests wait in the channel queues before their payload transfer begins, averaged over the channels
+   */
+  [[nodiscard]] champsim::chrono::clock::duration get_queue_latency() const;
+
   [[nodiscard]] champsim::data::bytes size() const;
 };
 
@@ -0,0 +1,97 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef DRAM_SCHEDULER_H
+#define DRAM_SCHEDULER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace champsim
+{
+enum class dram_scheduling_policy {
+  FR_FCFS,       // oldest first, among the requests to idle banks
+  BANDWIDTH_CAP, // cores over their share of the data bus in the current epoch go last
+  BLISS,         // cores that were served many times in a row go last, until the blacklist is cleared
+  ATLAS          // cores go in order of their least attained service, measured over long quanta
+};
+
+/**
+ * Ranks the cores whose requests wait in a DRAM channel.
+ *
+ * Among the requests to idle banks, those of the cores of the lowest rank are scheduled first, and then the oldest. With FR-FCFS every core has the
+ * same rank, so that the scheduler is oblivious to the cores. The other policies keep one core from starving the others: by capping the data bus
+ * time of each core (a soft cap, since a capped core is still served when no other core is waiting), by blacklisting cores that are served many
+ * times in a row (BLISS), or by favoring the cores that have been served the least (ATLAS).
+ */
+class dram_scheduler
+{
+public:
+  constexpr static uint64_t cap_epoch = 10000;            // cycles over which the data bus time of each core is capped
+  constexpr static uint64_t bliss_streak = 4;             // transfers in a row that blacklist a core
+  constexpr static uint64_t bliss_clear_interval = 10000; // cycles between clearing the blacklist
+  constexpr static uint64_t atlas_quantum = 100000;       // cycles between ranking the cores
+  constexpr static double atlas_history = 0.875;          // the weight of the service attained before the last quantum
+
+private:
+  dram_scheduling_policy policy = dram_scheduling_policy::FR_FCFS;
+  std::size_t num_cpus = 0;
+  double bandwidth_cap = 1.0;
+  uint64_t cycle = 0;
+
+  std::vector<double> epoch_busy{};
+
+  std::vector<bool> blacklisted{};
+  uint32_t last_cpu = std::numeric_limits<uint32_t>::max();
+  uint64_t streak = 0;
+
+  std::vector<double> attained_service{};
+  std::vector<double> quantum_service{};
+  std::vector<unsigned> ranks{};
+
+  void rank_by_attained_service();
+
+public:
+  dram_scheduler() = default;
+
+  /**
+   * :param cap: The fraction of the data bus time that each core may use, for the bandwidth cap policy.
+   */
+  dram_scheduler(dram_scheduling_policy policy_, std::size_t cpus, double cap = 1.0);
+
+  [[nodiscard]] dram_scheduling_policy get_policy() const { return policy; }
+
+  /**
+   * Advance by one cycle of the channel.
+   */
+  void tick();
+
+  /**
+   * Record that the data bus transferred a block for the given core.
+   */
+  void record_transfer(uint32_t cpu, double busy_cycles);
+
+  /**
+   * The rank of the given core. The requests of the cores of lower rank are scheduled first.
+   */
+  [[nodiscard]] unsigned rank(uint32_t cpu) const;
+};
+} // namespace champsim
+
+#endif
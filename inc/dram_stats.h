@@ -4,12 +4,19 @@
 #include <cstdint>
 #include <string>
 
+#include "event_counter.h"
+
 struct dram_stats {
   std::string name{};
   long dbus_cycle_congested{};
   uint64_t dbus_count_congested = 0;
   uint64_t refresh_cycles = 0;
   unsigned WQ_ROW_BUFFER_HIT = 0, WQ_ROW_BUFFER_MISS = 0, RQ_ROW_BUFFER_HIT = 0, RQ_ROW_BUFFER_MISS = 0, WQ_FULL = 0;
+
+  // The blocks transferred for each core, and the cycles from the arrival of each read to the end of its transfer
+  champsim::stats::event_counter<uint32_t> reads_by_cpu{};
+  champsim::stats::event_counter<uint32_t> writes_by_cpu{};
+  champsim::stats::event_counter<uint32_t> read_latency_by_cpu{};
 };
 
 dram_stats operator-(dram_stats lhs, dram_stats rhs);
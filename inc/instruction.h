@@ -28,6 +28,7 @@
 #include "address.h"
 #include "champsim.h"
 #include "chrono.h"
+#include "op_class.h"
 #include "trace_instruction.h"
 
 // branch types
@@ -108,6 +109,8 @@ struct ooo_model_instr : champsim::program_ordered<ooo_model_instr> {
   branch_type branch{NOT_BRANCH};
   champsim::address branch_target{};
 
+  op_class exec_class{op_class::ALU};
+
   bool dib_checked = false;
   bool fetch_issued = false;
   bool fetch_completed = false;
@@ -189,11 +192,26 @@ private:
     } else {
       branch_taken = false;
     }
+
+    // the trace formats without a class can only distinguish branches and memory operations
+    if (is_branch) {
+      exec_class = op_class::BRANCH;
+    } else if (!std::empty(source_memory)) {
+      exec_class = op_class::LOAD;
+    } else if (!std::empty(destination_memory)) {
+      exec_class = op_class::STORE;
+    }
   }
 
 public:
   ooo_model_instr(uint8_t cpu, input_instr instr) : ooo_model_instr(instr, {cpu, cpu}) {}
   ooo_model_instr(uint8_t /*cpu*/, cloudsuite_instr instr) : ooo_model_instr(instr, {instr.asid[0], instr.asid[1]}) {}
+  ooo_model_instr(uint8_t cpu, classed_instr instr) : ooo_model_instr(instr, {cpu, cpu})
+  {
+    if (instr.instr_class < static_cast<unsigned char>(op_class::NUM_CLASSES)) {
+      exec_class = static_cast<op_class>(instr.instr_class);
+    }
+  }
 
   [[nodiscard]] std::size_t num_mem_ops() const { return std::size(destination_memory) + std::size(source_memory); }
 };
@@ -41,6 +41,7 @@
 #include "instruction.h"
 #include "modules.h"
 #include "operable.h"
+#include "pipeline_trace.h"
 #include "register_allocator.h"
 #include "util/lru_table.h"
 #include "util/to_underlying.h"
@@ -59,6 +60,7 @@ class CacheBus
 
 public:
   CacheBus(uint32_t cpu_idx, champsim::channel* ll) : lower_level(ll), cpu(cpu_idx) {}
+  [[nodiscard]] channel_type* lower() const { return lower_level; }
   bool issue_read(request_type packet);
   bool issue_write(request_type packet);
 };
@@ -135,11 +137,26 @@ public:
 
   champsim::bandwidth::maximum_type L1I_BANDWIDTH, L1D_BANDWIDTH;
 
+  // The functional units that execute each class of instruction
+  struct functional_unit_class {
+    champsim::chrono::clock::duration latency;
+    champsim::chrono::clock::duration occupancy; // how long a unit is busy after it accepts an instruction
+    std::vector<champsim::chrono::clock::time_point> busy_until;
+  };
+  using functional_unit_table = std::array<functional_unit_class, static_cast<std::size_t>(op_class::NUM_CLASSES)>;
+  functional_unit_table functional_units;
+
   RegisterAllocator reg_allocator{REGISTER_FILE_SIZE};
 
   // branch
   champsim::chrono::clock::time_point fetch_resume_time{};
 
+  // CPI stack
+  long pending_memory_stall_cycles = 0; // attributed to a level when the load at the ROB head returns
+  bool register_file_stall = false;
+
+  champsim::pipeline_tracer pipeline_trace{};
+
   const long IN_QUEUE_SIZE;
   std::deque<ooo_model_instr> input_queue;
 
@@ -163,14 +180,25 @@ public:
   long complete_inflight_instruction();
   long handle_memory_return();
   long retire_rob();
+  void record_cpi_component(long retire_count);
+
+  void enable_pipeline_trace(std::ostream& out, uint64_t begin_id, uint64_t end_id, uint64_t period);
+  void record_pipeline_stage(uint64_t instr_id, champsim::pipeline_tracer::stage which)
+  {
+    if (pipeline_trace.tracks(instr_id)) {
+      pipeline_trace.record_stage(instr_id, which, current_time);
+    }
+  }
 
   bool do_init_instruction(ooo_model_instr& instr);
   bool do_predict_branch(ooo_model_instr& instr);
+  bool do_evaluate_branch(ooo_model_instr& instr);
   void do_check_dib(ooo_model_instr& instr);
   bool do_fetch_instruction(std::deque<ooo_model_instr>::iterator begin, std::deque<ooo_model_instr>::iterator end);
   void do_dib_update(const ooo_model_instr& instr);
   void do_scheduling(ooo_model_instr& instr);
   void do_execution(ooo_model_instr& instr);
+  [[nodiscard]] bool functional_unit_available(const ooo_model_instr& instr) const;
   void do_memory_scheduling(ooo_model_instr& instr);
   void do_complete_execution(ooo_model_instr& instr);
   void do_sq_forward_to_lq(LSQ_ENTRY& sq_entry, LSQ_ENTRY& lq_entry);
@@ -237,6 +265,8 @@ public:
   [[nodiscard]] std::pair<champsim::address, bool> impl_btb_prediction(champsim::address ip, uint8_t branch_type) const;
   // NOLINTEND(readability-make-member-function-const)
 
+  static functional_unit_table make_functional_units(const champsim::detail::core_builder_base& b);
+
   template <typename... Bs, typename... Ts>
   explicit O3_CPU(champsim::core_builder<champsim::core_builder_module_type_holder<Bs...>, champsim::core_builder_module_type_holder<Ts...>> b)
       : champsim::operable(b.m_clock_period), cpu(b.m_cpu),
@@ -248,7 +278,7 @@ public:
         BRANCH_MISPREDICT_PENALTY(b.m_mispredict_penalty * b.m_clock_period), DISPATCH_LATENCY(b.m_dispatch_latency * b.m_clock_period),
         DECODE_LATENCY(b.m_decode_latency * b.m_clock_period), SCHEDULING_LATENCY(b.m_schedule_latency * b.m_clock_period),
         EXEC_LATENCY(b.m_execute_latency * b.m_clock_period), DIB_HIT_LATENCY(b.m_dib_hit_latency * b.m_clock_period), L1I_BANDWIDTH(b.m_l1i_bw),
-        L1D_BANDWIDTH(b.m_l1d_bw), IN_QUEUE_SIZE(2 * champsim::to_underlying(b.m_fetch_width)), L1I_bus(b.m_cpu, b.m_fetch_queues),
+        L1D_BANDWIDTH(b.m_l1d_bw), functional_units(make_functional_units(b)), IN_QUEUE_SIZE(2 * champsim::to_underlying(b.m_fetch_width)), L1I_bus(b.m_cpu, b.m_fetch_queues),
         L1D_bus(b.m_cpu, b.m_data_queues), l1i(b.m_l1i), branch_module_pimpl(std::make_unique<branch_module_model<Bs...>>(this)),
         btb_module_pimpl(std::make_unique<btb_module_model<Ts...>>(this))
   {
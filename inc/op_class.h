@@ -0,0 +1,37 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OP_CLASS_H
+#define OP_CLASS_H
+
+#include <array>
+#include <string_view>
+
+// The functional unit class of an instruction, which determines its execution latency
+enum class op_class : unsigned char {
+  ALU = 0,
+  SLOW_ALU, // integer multiply and divide
+  FP,
+  LOAD,
+  STORE,
+  BRANCH,
+  NUM_CLASSES,
+};
+
+using namespace std::literals::string_view_literals;
+inline constexpr std::array<std::string_view, static_cast<std::size_t>(op_class::NUM_CLASSES)> op_class_names{"ALU"sv,   "SLOW_ALU"sv, "FP"sv,
+                                                                                                            "LOAD"sv,  "STORE"sv,    "BRANCH"sv};
+#endif
@@ -0,0 +1,74 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PIPELINE_TRACE_H
+#define PIPELINE_TRACE_H
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <vector>
+
+#include "address.h"
+#include "chrono.h"
+
+namespace champsim
+{
+/**
+ * Records the time each sampled instruction passes through the pipeline and writes it in the O3PipeView format,
+ * which can be viewed with Konata or gem5's o3-pipeview.py.
+ *
+ * Records are kept in a ring indexed by instruction ID, which must be at least as large as the number of instructions in flight.
+ * A default-constructed tracer is disabled, and O3_CPU checks tracks() before recording each instruction.
+ */
+class pipeline_tracer
+{
+public:
+  enum class stage : unsigned { FETCH = 0, DECODE, DISPATCH, SCHEDULE, EXECUTE, MEMORY_ISSUE, MEMORY_RETURN, COMPLETE, RETIRE, NUM_STAGES };
+
+  struct record {
+    uint64_t instr_id = std::numeric_limits<uint64_t>::max();
+    champsim::address ip{};
+    std::array<champsim::chrono::clock::time_point, static_cast<std::size_t>(stage::NUM_STAGES)> times{};
+  };
+
+private:
+  std::ostream* out = nullptr;
+  uint64_t begin_id = 0;
+  uint64_t end_id = 0;
+  uint64_t period = 1;
+  std::vector<record> ring{};
+
+  record& slot(uint64_t instr_id) { return ring.at(instr_id % std::size(ring)); }
+
+public:
+  pipeline_tracer() = default;
+  pipeline_tracer(std::ostream& out, uint64_t begin_id, uint64_t end_id, uint64_t period, std::size_t capacity);
+
+  [[nodiscard]] bool enabled() const { return out != nullptr; }
+  [[nodiscard]] bool tracks(uint64_t instr_id) const
+  {
+    return enabled() && instr_id >= begin_id && instr_id < end_id && ((instr_id - begin_id) % period) == 0;
+  }
+
+  void begin(uint64_t instr_id, champsim::address ip, champsim::chrono::clock::time_point time);
+  void record_stage(uint64_t instr_id, stage which, champsim::chrono::clock::time_point time);
+  void retire(uint64_t instr_id, champsim::chrono::clock::time_point time);
+};
+} // namespace champsim
+
+#endif
@@ -0,0 +1,80 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PREFETCH_CANDIDATES_H
+#define PREFETCH_CANDIDATES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include "address.h"
+
+namespace champsim
+{
+/**
+ * A bounded list of prefetch candidates, ordered by priority.
+ *
+ * Prefetchers push candidates as they generate them, and the cache issues the highest-priority candidates as its prefetch queue has room.
+ * Candidates of equal priority are issued in the order they were pushed.
+ */
+class prefetch_candidate_queue
+{
+public:
+  struct candidate_type {
+    champsim::address address{};
+    uint64_t block = 0;
+    bool fill_this_level = true;
+    uint32_t metadata = 0;
+    uint32_t priority = 0;
+    std::size_t component = 0;
+  };
+
+  enum class push_result {
+    ADDED,    // the candidate was added
+    MERGED,   // a candidate for the same block was already pending
+    REPLACED, // the candidate was added in place of the candidate of the lowest priority
+    DROPPED   // the queue was full of candidates of higher priority
+  };
+
+  constexpr static std::size_t default_capacity = 64;
+
+private:
+  std::vector<candidate_type> entries{};
+  std::size_t capacity = default_capacity;
+
+public:
+  prefetch_candidate_queue() = default;
+  explicit prefetch_candidate_queue(std::size_t capacity_);
+
+  /**
+   * Add a candidate. A candidate for a block that is already pending raises the priority of the pending candidate.
+   * If the queue is full, the candidate of the lowest priority is dropped, which may be the one being pushed.
+   */
+  push_result push(candidate_type candidate);
+
+  [[nodiscard]] bool full() const { return std::size(entries) >= capacity; }
+  [[nodiscard]] bool empty() const { return std::empty(entries); }
+  [[nodiscard]] std::size_t size() const { return std::size(entries); }
+
+  [[nodiscard]] const candidate_type& front() const { return entries.front(); }
+  void pop_front();
+  void clear() { entries.clear(); }
+};
+} // namespace champsim
+
+#endif
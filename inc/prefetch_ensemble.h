@@ -0,0 +1,93 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PREFETCH_ENSEMBLE_H
+#define PREFETCH_ENSEMBLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+#include "msl/lru_table.h"
+
+namespace champsim
+{
+/**
+ * Arbitrates between the prefetchers of a cache that hold more than one.
+ *
+ * A candidate that another component issued recently is dropped as a duplicate. Each component may occupy a share of the prefetch queue in
+ * proportion to the accuracy it has shown recently, so that the more useful components get more of the queue.
+ * A default-constructed ensemble is disabled and admits every candidate.
+ * Prefetches issued outside the invocation of any component, with no_component, are admitted and are not charged to any component.
+ */
+class prefetch_ensemble
+{
+public:
+  enum class admission { ADMIT, DUPLICATE, OVER_QUOTA };
+  constexpr static std::size_t no_component = std::numeric_limits<uint8_t>::max(); // prefetches issued outside any component
+
+  constexpr static uint64_t window = 1024; // the counts are halved after this many prefetches are admitted
+  constexpr static std::size_t candidate_sets = 64;
+  constexpr static std::size_t candidate_ways = 4;
+
+private:
+  struct component_type {
+    uint64_t issued = 0;
+    uint64_t useful = 0;
+  };
+
+  struct candidate_type {
+    uint64_t block = 0;
+    std::size_t component = 0;
+  };
+  struct candidate_block {
+    uint64_t operator()(const candidate_type& candidate) const { return candidate.block; }
+  };
+
+  std::vector<component_type> components{};
+  champsim::msl::lru_table<candidate_type, candidate_block, candidate_block> recent{candidate_sets, candidate_ways};
+  uint64_t admitted_in_window = 0;
+
+public:
+  prefetch_ensemble() = default;
+  explicit prefetch_ensemble(std::size_t num_components);
+
+  [[nodiscard]] bool enabled() const { return !std::empty(components); }
+  [[nodiscard]] std::size_t num_components() const { return std::size(components); }
+  [[nodiscard]] bool charges(std::size_t component) const { return component < std::size(components); }
+
+  /**
+   * The recent accuracy of a component. Components that have not issued prefetches are assumed to be half accurate.
+   */
+  [[nodiscard]] double accuracy(std::size_t component) const;
+
+  /**
+   * The number of entries of a prefetch queue of the given size that a component may occupy.
+   */
+  [[nodiscard]] std::size_t quota(std::size_t component, std::size_t pq_size) const;
+
+  /**
+   * Decide whether to admit a candidate of a component, given how many entries of the prefetch queue the component occupies.
+   */
+  admission try_admit(std::size_t component, uint64_t block, std::size_t occupancy, std::size_t pq_size);
+
+  void record_useful(std::size_t component);
+};
+} // namespace champsim
+
+#endif
@@ -0,0 +1,76 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PREFETCH_FILTER_H
+#define PREFETCH_FILTER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace champsim
+{
+/**
+ * A counting Bloom filter over the blocks recently prefetched into or filled in a cache.
+ *
+ * The filter remembers a bounded history of blocks, so that the oldest can be removed and the rate of false positives stays low.
+ * A block may be removed early, as when it is evicted. Its entry in the history is then left in place and passed over, so that removing a
+ * block takes constant time. A default-constructed filter is disabled and contains nothing.
+ */
+class prefetch_filter
+{
+public:
+  constexpr static std::size_t counters_per_block = 4; // the history holds a quarter as many blocks as there are counters
+  constexpr static std::size_t num_hashes = 2;
+
+private:
+  std::vector<uint8_t> counters{};
+  std::deque<std::pair<uint64_t, uint64_t>> history{}; // the blocks in the order they were inserted, with the number of each insertion
+  std::unordered_map<uint64_t, uint64_t> newest{};     // the number of the latest insertion of each block remembered
+  uint64_t insertions = 0;
+
+  [[nodiscard]] std::size_t index(uint64_t block, std::size_t hash) const;
+  void add(uint64_t block, int delta);
+
+public:
+  prefetch_filter() = default;
+  explicit prefetch_filter(std::size_t num_counters);
+
+  [[nodiscard]] bool enabled() const { return !std::empty(counters); }
+  [[nodiscard]] std::size_t capacity() const { return std::size(counters) / counters_per_block; }
+
+  /**
+   * Whether the block may have been inserted recently. There are no false negatives, but there may be false positives.
+   */
+  [[nodiscard]] bool contains(uint64_t block) const;
+
+  /**
+   * Remember a block, forgetting the oldest if the history is full. A block that is already remembered becomes the newest.
+   */
+  void insert(uint64_t block);
+
+  /**
+   * Forget a block, if it is remembered.
+   */
+  void erase(uint64_t block);
+};
+} // namespace champsim
+
+#endif
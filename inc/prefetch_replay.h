@@ -0,0 +1,57 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PREFETCH_REPLAY_H
+#define PREFETCH_REPLAY_H
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+class CACHE;
+
+namespace champsim
+{
+struct prefetch_replay_stats {
+  std::string name;
+  uint64_t records = 0;
+  uint64_t demand_accesses = 0;
+  uint64_t demand_misses = 0; // misses in the recording, with the hits on recorded prefetches
+  uint64_t covered = 0;       // recorded misses to blocks prefetched in time
+  uint64_t late = 0;          // recorded misses to blocks prefetched, but not in time
+  uint64_t issued = 0;
+  uint64_t useless = 0; // prefetched blocks displaced or left over without a demand
+};
+
+/**
+ * Drive the prefetcher of a cache with a recorded prefetcher trace, without simulating the rest of the system.
+ *
+ * The recorded demand accesses are replayed in order, each with its recorded cycle, and the prefetcher's cycle operation is invoked once per record.
+ * A prefetched block arrives after a fixed latency, and the prefetcher is told of the fill when it arrives.
+ * A recorded hit on a block that the recorded prefetcher brought in is replayed as a miss, so the trace may be recorded with any prefetcher.
+ * A recorded miss to a block that has arrived is reported to the prefetcher as a hit on a useful prefetch.
+ * The prefetched blocks are held in a buffer as large as the cache, and the oldest is displaced when it is full.
+ * The recorded demand fills are replayed as they are, and the recorded prefetch fills are replaced by the fills of the replayed prefetches.
+ * The throttle of the cache, if it is enabled, sees each call to the prefetcher as an invocation, as in the simulation.
+ *
+ * :param cache: The cache whose prefetcher is replayed. Its prefetcher should be initialized.
+ * :param trace: The recorded trace.
+ * :param latency: The number of cycles after which a prefetched block arrives.
+ */
+prefetch_replay_stats prefetch_replay_main(CACHE& cache, std::istream& trace, uint64_t latency);
+} // namespace champsim
+
+#endif
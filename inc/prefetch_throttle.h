@@ -0,0 +1,115 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef PREFETCH_THROTTLE_H
+#define PREFETCH_THROTTLE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace champsim
+{
+/**
+ * Adjusts how many prefetches a cache admits from the accuracy, lateness, and pollution of its prefetches and the DRAM bandwidth,
+ * after the feedback-directed prefetching of Srinath et al. (HPCA 2007).
+ *
+ * The feedback is gathered over intervals of fills, and is averaged with that of the previous intervals. At the end of each interval, the
+ * aggressiveness moves up or down by one level. Each level limits the prefetches admitted each time the prefetcher is invoked, and the share of
+ * the prefetch queue they may occupy. A default-constructed throttle is disabled and admits every prefetch.
+ */
+class prefetch_throttle
+{
+public:
+  // Running totals of the prefetch outcomes, from which the feedback of each interval is taken
+  struct feedback_type {
+    uint64_t issued = 0;
+    uint64_t useful = 0;
+    uint64_t late = 0;
+    uint64_t pollution = 0;
+    uint64_t demand_misses = 0;
+  };
+
+  struct level_type {
+    unsigned degree;    // the prefetches admitted each time the prefetcher is invoked
+    unsigned pq_eighths; // the eighths of the prefetch queue the prefetches may occupy
+  };
+
+  constexpr static std::array<level_type, 5> levels{
+      {{1, 2}, {2, 4}, {4, 6}, {8, 8}, {std::numeric_limits<unsigned>::max(), 8}}};
+  constexpr static std::size_t initial_level = 2;
+
+  constexpr static double accuracy_high = 0.75;
+  constexpr static double accuracy_low = 0.40;
+  constexpr static double lateness_threshold = 0.01;
+  constexpr static double pollution_threshold = 0.005;
+  constexpr static uint8_t high_bandwidth = 12; // in the sixteenths of the peak returned by get_dram_bw()
+
+private:
+  uint64_t interval_fills = 0;
+  uint64_t fills = 0;
+  std::size_t level = initial_level;
+  unsigned admitted = 0;
+  feedback_type last{};
+
+  double accuracy = 0;
+  double lateness = 0;
+  double pollution = 0;
+
+public:
+  prefetch_throttle() = default;
+
+  /**
+   * :param interval: The number of fills in each interval.
+   */
+  explicit prefetch_throttle(uint64_t interval);
+
+  [[nodiscard]] bool enabled() const { return interval_fills > 0; }
+  [[nodiscard]] std::size_t aggressiveness() const { return level; }
+
+  /**
+   * Start counting the prefetches admitted for an invocation of the prefetcher.
+   */
+  void begin_invocation() { admitted = 0; }
+
+  /**
+   * Decide whether to admit a prefetch, given the occupancy of the prefetch queue. An admitted prefetch counts against the degree.
+   */
+  bool try_admit(std::size_t pq_occupancy, std::size_t pq_size);
+
+  /**
+   * Count a fill. Returns true if the fill ends an interval.
+   */
+  bool count_fill();
+
+  /**
+   * Adjust the aggressiveness from the prefetch outcomes since the previous interval.
+   *
+   * :param totals: The running totals of the prefetch outcomes.
+   * :param dram_bw: The DRAM bandwidth, in sixteenths of the peak.
+   */
+  void end_interval(const feedback_type& totals, uint8_t dram_bw);
+
+  /**
+   * Restart the running totals, as when the statistics are reset. The aggressiveness is kept.
+   */
+  void restart_totals() { last = {}; }
+};
+} // namespace champsim
+
+#endif
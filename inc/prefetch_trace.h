@@ -0,0 +1,68 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PREFETCH_TRACE_H
+#define PREFETCH_TRACE_H
+
+#include <cstdint>
+#include <iostream>
+
+namespace champsim
+{
+/**
+ * One call to a prefetcher, as recorded in a prefetcher trace. The records are written in the binary layout of this struct.
+ */
+struct prefetch_trace_record {
+  enum : uint8_t { CACHE_OPERATE, CACHE_FILL };
+
+  uint64_t cycle = 0;
+  uint64_t address = 0;
+  uint64_t ip = 0;              // for CACHE_OPERATE
+  uint64_t evicted_address = 0; // for CACHE_FILL
+  uint32_t metadata = 0;
+  uint32_t set = 0; // for CACHE_FILL
+  uint32_t way = 0; // for CACHE_FILL
+  uint8_t kind = CACHE_OPERATE;
+  uint8_t type = 0;  // the access_type, for CACHE_OPERATE
+  uint8_t hit = 0;   // for CACHE_OPERATE
+  uint8_t flag = 0;  // whether the access used a prefetch for CACHE_OPERATE, or whether the fill is a prefetch for CACHE_FILL
+};
+static_assert(sizeof(prefetch_trace_record) == 48, "The trace records must not be padded");
+
+/**
+ * Writes the calls to the prefetcher of a cache. A default-constructed writer is disabled and writes nothing.
+ */
+class prefetch_trace_writer
+{
+  std::ostream* out = nullptr;
+
+public:
+  prefetch_trace_writer() = default;
+  explicit prefetch_trace_writer(std::ostream& out_) : out(&out_) {}
+
+  [[nodiscard]] bool enabled() const { return out != nullptr; }
+  void write(const prefetch_trace_record& record) const;
+};
+
+/**
+ * Read the next record of a prefetcher trace.
+ *
+ * \return false at the end of the trace
+ */
+bool read_prefetch_trace(std::istream& in, prefetch_trace_record& record);
+} // namespace champsim
+
+#endif
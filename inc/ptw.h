@@ -28,6 +28,7 @@
 #include "channel.h"
 #include "operable.h"
 #include "ptw_builder.h"
+#include "util/indexed_list.h"
 #include "util/lru_table.h"
 #include "waitable.h"
 
@@ -55,8 +56,8 @@ class PageTableWalker : public champsim::operable
     champsim::address v_address{};
     champsim::waitable<champsim::address> data{};
 
-    std::vector<uint64_t> instr_depend_on_me{};
-    std::vector<std::deque<response_type>*> to_return{};
+    champsim::shared_list<uint64_t> instr_depend_on_me{};
+    uint64_t to_return = 0; // the indices of the upper levels to respond to, as a bitmask
 
     uint32_t pf_metadata = 0;
     uint32_t cpu = std::numeric_limits<uint32_t>::max();
@@ -67,14 +68,20 @@ class PageTableWalker : public champsim::operable
     mshr_type(const request_type& req, std::size_t level);
   };
 
-  std::deque<mshr_type> MSHR;
+  // MSHRs are found by their block address
+  struct mshr_indexer {
+    uint64_t operator()(champsim::address address) const { return champsim::block_number{address}.to<uint64_t>(); }
+    uint64_t operator()(const mshr_type& entry) const { return operator()(entry.address); }
+  };
+
+  champsim::indexed_list<mshr_type, mshr_indexer> MSHR;
   std::deque<mshr_type> finished;
   std::deque<mshr_type> completed;
 
   std::vector<channel_type*> upper_levels;
   channel_type* lower_level;
 
-  std::optional<mshr_type> handle_read(const request_type& pkt, channel_type* ul);
+  std::optional<mshr_type> handle_read(const request_type& pkt, std::size_t upper_level);
   std::optional<mshr_type> handle_fill(const mshr_type& fill_mshr);
   std::optional<mshr_type> step_translation(const mshr_type& source);
 
@@ -0,0 +1,140 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SET_SAMPLER_H
+#define SET_SAMPLER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "access_type.h"
+#include "chrono.h"
+#include "util/to_underlying.h"
+
+namespace champsim
+{
+/**
+ * The rate at which an event occurs, estimated from observations.
+ *
+ * Outcomes are drawn at the estimated rate, without randomness, by carrying the fraction of an occurrence left over by each draw into the next.
+ * Observations are aged by halving the counts, so that the estimate follows the recent behavior.
+ */
+class sampled_rate
+{
+  uint64_t observations = 0;
+  uint64_t occurrences = 0;
+  double prior = 1.0;
+  double carry = 0;
+
+public:
+  constexpr static uint64_t window = 1 << 16;
+
+  sampled_rate() = default;
+
+  /**
+   * :param prior_rate: The rate to assume before any observations are made.
+   */
+  explicit sampled_rate(double prior_rate) : prior(prior_rate) {}
+
+  void observe(bool occurred);
+  [[nodiscard]] double rate() const;
+
+  /**
+   * The outcome of the next draw.
+   */
+  [[nodiscard]] bool peek() const;
+
+  /**
+   * Account for a drawn outcome. Outcomes should be committed only once they have taken effect, so that a retried draw sees the same outcome.
+   */
+  void commit(bool occurred);
+};
+
+/**
+ * The time that misses take to return, and the number of levels they miss in, estimated from observations.
+ *
+ * Observations are aged by halving the totals, so that the estimate follows the recent behavior.
+ */
+class sampled_latency
+{
+  uint64_t observations = 0;
+  champsim::chrono::clock::duration latency_total{};
+  uint64_t levels_total = 0;
+
+public:
+  void observe(champsim::chrono::clock::duration latency, unsigned levels);
+
+  /**
+   * The mean of the observed latencies, or zero before any observations are made.
+   */
+  [[nodiscard]] champsim::chrono::clock::duration latency() const;
+
+  /**
+   * The mean of the observed numbers of levels, rounded to the nearest level.
+   */
+  [[nodiscard]] unsigned levels() const;
+};
+
+/**
+ * Selects the sets of a cache that are simulated in detail.
+ *
+ * One set is chosen from each group of adjacent sets, at an offset within the group that is scrambled to avoid aliasing with strided accesses.
+ * The outcomes of accesses to the other sets are modeled from the outcomes observed in the sampled sets.
+ */
+class set_sampler
+{
+  std::vector<bool> sampled{}; // empty if every set is sampled
+  std::size_t sampled_count = 0;
+  std::array<sampled_rate, champsim::to_underlying(access_type::NUM_TYPES)> miss_rates{};
+  sampled_rate useful_rate{0.0};
+  sampled_rate dirtying_rate{0.0};
+  std::array<sampled_latency, champsim::to_underlying(access_type::NUM_TYPES)> miss_latencies{};
+
+public:
+  set_sampler() = default;
+  set_sampler(uint32_t num_sets, uint32_t num_sampled);
+
+  [[nodiscard]] bool enabled() const { return !std::empty(sampled); }
+  [[nodiscard]] bool is_sampled(long set) const { return !enabled() || sampled[static_cast<std::size_t>(set)]; }
+  [[nodiscard]] std::size_t num_sampled() const { return sampled_count; }
+
+  void observe_access(access_type type, bool miss) { miss_rates.at(champsim::to_underlying(type)).observe(miss); }
+  [[nodiscard]] bool peek_miss(access_type type) const { return miss_rates.at(champsim::to_underlying(type)).peek(); }
+  void commit_access(access_type type, bool miss) { miss_rates.at(champsim::to_underlying(type)).commit(miss); }
+
+  // Whether a hit finds a block that was prefetched and not yet used
+  void observe_hit(bool useful_prefetch) { useful_rate.observe(useful_prefetch); }
+  [[nodiscard]] bool peek_useful() const { return useful_rate.peek(); }
+  void commit_hit(bool useful_prefetch) { useful_rate.commit(useful_prefetch); }
+
+  // Whether a write that hits finds the block clean, and so makes the block's eviction a writeback
+  void observe_write_hit(bool dirties) { dirtying_rate.observe(dirties); }
+  [[nodiscard]] bool peek_dirtying() const { return dirtying_rate.peek(); }
+  void commit_write_hit(bool dirties) { dirtying_rate.commit(dirties); }
+
+  // How long a miss takes to return from the lower level, and how many levels it misses in there
+  void observe_miss(access_type type, champsim::chrono::clock::duration latency, unsigned miss_levels)
+  {
+    miss_latencies.at(champsim::to_underlying(type)).observe(latency, miss_levels);
+  }
+  [[nodiscard]] champsim::chrono::clock::duration miss_latency(access_type type) const { return miss_latencies.at(champsim::to_underlying(type)).latency(); }
+  [[nodiscard]] unsigned miss_levels(access_type type) const { return miss_latencies.at(champsim::to_underlying(type)).levels(); }
+};
+} // namespace champsim
+
+#endif
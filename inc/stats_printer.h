@@ -19,9 +19,11 @@
 #include <vector>
 
 #include "cache.h"
+#include "cache_sweep.h"
 #include "dram_controller.h"
 #include "ooo_cpu.h"
 #include "phase_info.h"
+#include "prefetch_replay.h"
 
 namespace champsim
 {
@@ -33,11 +35,15 @@ public:
   plain_printer(std::ostream& str) : stream(str) {}
   void print(phase_stats& stats);
   void print(std::vector<phase_stats>& stats);
+  void print(std::vector<miss_ratio_curve>& curves);
+  void print(const prefetch_replay_stats& stats);
 
   static std::vector<std::string> format(O3_CPU::stats_type stats);
   static std::vector<std::string> format(CACHE::stats_type stats);
   static std::vector<std::string> format(DRAM_CHANNEL::stats_type stats);
   static std::vector<std::string> format(phase_stats& stats);
+  static std::vector<std::string> format(const miss_ratio_curve& curve);
+  static std::vector<std::string> format(const prefetch_replay_stats& stats);
 };
 
 class json_printer
@@ -47,5 +53,7 @@ class json_printer
 public:
   json_printer(std::ostream& str) : stream(str) {}
   void print(std::vector<phase_stats>& stats);
+  void print(std::vector<miss_ratio_curve>& curves);
+  void print(const prefetch_replay_stats& stats);
 };
 } // namespace champsim
@@ -20,7 +20,7 @@
 #include <cstring>
 #include <deque>
 #include <memory>
-#include <numeric>
+#include <utility>
 #include <string>
 #include <type_traits>
 
@@ -102,9 +102,10 @@ ooo_model_instr apply_branch_target(ooo_model_instr branch, const ooo_model_inst
 template <typename It>
 void set_branch_targets(It begin, It end)
 {
-  std::reverse_iterator rbegin{end};
-  std::reverse_iterator rend{begin};
-  std::adjacent_difference(rbegin, rend, rbegin, apply_branch_target);
+  // Each instruction is resolved against its successor in place, so the buffered instructions are moved rather than copied
+  for (auto next = begin; begin != end && ++next != end; ++begin) {
+    *begin = apply_branch_target(std::move(*begin), *next);
+  }
 }
 
 template <typename T, typename F>
@@ -132,7 +133,7 @@ ooo_model_instr bulk_tracereader<T, F>::operator()()
     set_branch_targets(std::begin(instr_buffer), std::end(instr_buffer));
   }
 
-  auto retval = instr_buffer.front();
+  auto retval = std::move(instr_buffer.front());
   instr_buffer.pop_front();
 
   return retval;
@@ -142,5 +143,6 @@ std::string get_fptr_cmd(std::string_view fname);
 } // namespace champsim
 
 champsim::tracereader get_tracereader(const std::string& fname, uint8_t cpu, bool is_cloudsuite, bool repeat);
+champsim::tracereader get_classed_tracereader(const std::string& fname, uint8_t cpu, bool repeat);
 
 #endif
@@ -23,6 +23,8 @@
 #ifndef UTIL_BITS_H
 #define UTIL_BITS_H
 
+#include <cstddef>
+#include <cstdint>
 #include <utility>
 
 #include "../msl/bits.h"
@@ -35,6 +37,17 @@ using msl::is_power_of_2;
 using msl::lg2;
 using msl::next_pow2;
 using msl::splice_bits;
+
+/**
+ * Call the function with the index of each set bit of the mask, from the least significant.
+ */
+template <typename F>
+void for_each_set_bit(uint64_t mask, F&& func)
+{
+  for (; mask != 0; mask &= mask - 1) {
+    func(static_cast<std::size_t>(__builtin_ctzll(mask)));
+  }
+}
 } // namespace champsim
 
 #endif
@@ -0,0 +1,194 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef UTIL_INDEXED_LIST_H
+#define UTIL_INDEXED_LIST_H
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <list>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace champsim
+{
+/**
+ * A sequence of entries that can also be found by a key in constant time.
+ *
+ * The entries are held in a list, so they keep their order and never move in memory while they are held. The key of each entry is computed with KeyFunc when
+ * it is inserted. The members of an entry that determine its key must not be modified while the entry is held.
+ */
+template <typename T, typename KeyFunc>
+class indexed_list
+{
+  using list_type = std::list<T>;
+
+public:
+  using value_type = T;
+  using size_type = typename list_type::size_type;
+  using reference = typename list_type::reference;
+  using const_reference = typename list_type::const_reference;
+  using iterator = typename list_type::iterator;
+  using const_iterator = typename list_type::const_iterator;
+  using key_type = std::invoke_result_t<KeyFunc, const T&>;
+
+private:
+  struct index_entry {
+    uint64_t sequence;
+    iterator position;
+  };
+
+  KeyFunc key_func;
+  list_type entries{};
+  std::unordered_multimap<key_type, index_entry> index{};
+  uint64_t next_sequence = 0;
+
+  auto find_index_entry(const_iterator pos)
+  {
+    auto [first, last] = index.equal_range(key_func(*pos));
+    return std::find_if(first, last, [pos](const auto& x) { return const_iterator{x.second.position} == pos; });
+  }
+
+public:
+  explicit indexed_list(KeyFunc key_func_ = {}) : key_func(std::move(key_func_)) {}
+
+  indexed_list(const indexed_list& other) : key_func(other.key_func)
+  {
+    for (const auto& x : other) {
+      push_back(x);
+    }
+  }
+
+  indexed_list(indexed_list&& other) noexcept = default;
+
+  indexed_list& operator=(const indexed_list& other)
+  {
+    indexed_list copy{other};
+    swap(copy);
+    return *this;
+  }
+
+  indexed_list& operator=(indexed_list&& other) noexcept = default;
+  ~indexed_list() = default;
+
+  void swap(indexed_list& other) noexcept
+  {
+    using std::swap;
+    swap(key_func, other.key_func);
+    swap(entries, other.entries);
+    swap(index, other.index);
+    swap(next_sequence, other.next_sequence);
+  }
+
+  [[nodiscard]] iterator begin() noexcept { return std::begin(entries); }
+  [[nodiscard]] iterator end() noexcept { return std::end(entries); }
+  [[nodiscard]] const_iterator begin() const noexcept { return std::cbegin(entries); }
+  [[nodiscard]] const_iterator end() const noexcept { return std::cend(entries); }
+  [[nodiscard]] const_iterator cbegin() const noexcept { return std::cbegin(entries); }
+  [[nodiscard]] const_iterator cend() const noexcept { return std::cend(entries); }
+
+  [[nodiscard]] reference front() { return entries.front(); }
+  [[nodiscard]] const_reference front() const { return entries.front(); }
+  [[nodiscard]] reference back() { return entries.back(); }
+  [[nodiscard]] const_reference back() const { return entries.back(); }
+
+  [[nodiscard]] size_type size() const noexcept { return std::size(entries); }
+  [[nodiscard]] bool empty() const noexcept { return std::empty(entries); }
+
+  template <typename... Args>
+  reference emplace_back(Args&&... args)
+  {
+    auto& inserted = entries.emplace_back(std::forward<Args>(args)...);
+    index.emplace(key_func(inserted), index_entry{next_sequence++, std::prev(std::end(entries))});
+    return inserted;
+  }
+
+  void push_back(const T& value) { emplace_back(value); }
+  void push_back(T&& value) { emplace_back(std::move(value)); }
+
+  /**
+   * Find an entry with the given key, or return end() if there is none.
+   */
+  [[nodiscard]] iterator find(const key_type& key)
+  {
+    auto found = index.find(key);
+    return found == std::end(index) ? end() : found->second.position;
+  }
+
+  [[nodiscard]] const_iterator find(const key_type& key) const
+  {
+    auto found = index.find(key);
+    return found == std::end(index) ? end() : const_iterator{found->second.position};
+  }
+
+  /**
+   * Find every entry with the given key, in the order they were inserted.
+   */
+  [[nodiscard]] std::vector<iterator> find_all(const key_type& key)
+  {
+    auto [first, last] = index.equal_range(key);
+    std::vector<index_entry> found{};
+    std::transform(first, last, std::back_inserter(found), [](const auto& x) { return x.second; });
+    std::sort(std::begin(found), std::end(found), [](const auto& lhs, const auto& rhs) { return lhs.sequence < rhs.sequence; });
+
+    std::vector<iterator> retval{};
+    std::transform(std::begin(found), std::end(found), std::back_inserter(retval), [](const auto& x) { return x.position; });
+    return retval;
+  }
+
+  iterator erase(const_iterator pos)
+  {
+    index.erase(find_index_entry(pos));
+    return entries.erase(pos);
+  }
+
+  iterator erase(const_iterator first, const_iterator last)
+  {
+    while (first != last) {
+      first = erase(first);
+    }
+    return entries.erase(last, last);
+  }
+
+  /**
+   * Remove the entry at pos and return it.
+   */
+  T extract(iterator pos)
+  {
+    index.erase(find_index_entry(pos));
+    T retval{std::move(*pos)};
+    entries.erase(pos);
+    return retval;
+  }
+
+  /**
+   * Move the entry at from to be before pos. No entries are copied.
+   */
+  void move_before(const_iterator pos, const_iterator from) { entries.splice(pos, entries, from); }
+
+  void clear() noexcept
+  {
+    entries.clear();
+    index.clear();
+  }
+};
+} // namespace champsim
+
+#endif
@@ -0,0 +1,303 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef UTIL_RING_BUFFER_H
+#define UTIL_RING_BUFFER_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "util/bits.h"
+
+namespace champsim
+{
+/**
+ * A double-ended queue held in a single circular allocation.
+ *
+ * The capacity is a power of two that can be reserved up front, usually from the bound on the queue's occupancy. Elements are constructed in place, and
+ * erasing elements does not free storage, so a queue that stays within its capacity never allocates. If the queue is pushed beyond its capacity, the
+ * capacity doubles.
+ *
+ * Iterators are random access. Like std::deque, any insertion or erasure invalidates them.
+ */
+template <typename T>
+class ring_buffer
+{
+  using storage_type = std::vector<std::optional<T>>;
+
+  storage_type slots{};
+  std::size_t head = 0;
+  std::size_t count = 0;
+
+  [[nodiscard]] std::size_t physical(std::size_t pos) const { return (head + pos) & (std::size(slots) - 1); }
+  std::optional<T>& slot(std::size_t pos) { return slots[physical(pos)]; }
+  const std::optional<T>& slot(std::size_t pos) const { return slots[physical(pos)]; }
+
+  void grow_to(std::size_t new_capacity)
+  {
+    storage_type new_slots(champsim::next_pow2(std::max<std::size_t>(new_capacity, 1)));
+    for (std::size_t i = 0; i < count; ++i) {
+      new_slots[i] = std::move(slot(i));
+    }
+    slots = std::move(new_slots);
+    head = 0;
+  }
+
+  template <bool Const>
+  class iterator_base
+  {
+    friend class ring_buffer;
+    using buffer_pointer = std::conditional_t<Const, const ring_buffer*, ring_buffer*>;
+
+    buffer_pointer buffer = nullptr;
+    std::ptrdiff_t pos = 0;
+
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<Const, const T*, T*>;
+    using reference = std::conditional_t<Const, const T&, T&>;
+
+    iterator_base() = default;
+    iterator_base(buffer_pointer buffer_, std::ptrdiff_t pos_) : buffer(buffer_), pos(pos_) {}
+
+    template <bool OtherConst, typename = std::enable_if_t<Const && !OtherConst>>
+    iterator_base(const iterator_base<OtherConst>& other) : buffer(other.buffer), pos(other.pos) // NOLINT(google-explicit-constructor)
+    {
+    }
+
+    reference operator*() const { return *buffer->slot(static_cast<std::size_t>(pos)); }
+    pointer operator->() const { return &(operator*()); }
+    reference operator[](difference_type n) const { return *(*this + n); }
+
+    iterator_base& operator++()
+    {
+      ++pos;
+      return *this;
+    }
+    iterator_base operator++(int)
+    {
+      auto retval = *this;
+      ++pos;
+      return retval;
+    }
+    iterator_base& operator--()
+    {
+      --pos;
+      return *this;
+    }
+    iterator_base operator--(int)
+    {
+      auto retval = *this;
+      --pos;
+      return retval;
+    }
+    iterator_base& operator+=(difference_type n)
+    {
+      pos += n;
+      return *this;
+    }
+    iterator_base& operator-=(difference_type n)
+    {
+      pos -= n;
+      return *this;
+    }
+
+    friend iterator_base operator+(iterator_base it, difference_type n) { return it += n; }
+    friend iterator_base operator+(difference_type n, iterator_base it) { return it += n; }
+    friend iterator_base operator-(iterator_base it, difference_type n) { return it -= n; }
+    friend difference_type operator-(const iterator_base& lhs, const iterator_base& rhs) { return lhs.pos - rhs.pos; }
+
+    friend bool operator==(const iterator_base& lhs, const iterator_base& rhs) { return lhs.pos == rhs.pos; }
+    friend bool operator!=(const iterator_base& lhs, const iterator_base& rhs) { return lhs.pos != rhs.pos; }
+    friend bool operator<(const iterator_base& lhs, const iterator_base& rhs) { return lhs.pos < rhs.pos; }
+    friend bool operator>(const iterator_base& lhs, const iterator_base& rhs) { return lhs.pos > rhs.pos; }
+    friend bool operator<=(const iterator_base& lhs, const iterator_base& rhs) { return lhs.pos <= rhs.pos; }
+    friend bool operator>=(const iterator_base& lhs, const iterator_base& rhs) { return lhs.pos >= rhs.pos; }
+  };
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = T&;
+  using const_reference = const T&;
+  using iterator = iterator_base<false>;
+  using const_iterator = iterator_base<true>;
+
+  ring_buffer() = default;
+  explicit ring_buffer(std::size_t capacity_) { reserve(capacity_); }
+
+  ring_buffer(const ring_buffer& other) : slots(std::size(other.slots))
+  {
+    for (const auto& x : other) {
+      push_back(x);
+    }
+  }
+
+  ring_buffer(ring_buffer&& other) noexcept
+      : slots(std::exchange(other.slots, {})), head(std::exchange(other.head, 0)), count(std::exchange(other.count, 0))
+  {
+  }
+
+  ring_buffer& operator=(const ring_buffer& other)
+  {
+    ring_buffer copy{other};
+    std::swap(slots, copy.slots);
+    std::swap(head, copy.head);
+    std::swap(count, copy.count);
+    return *this;
+  }
+
+  ring_buffer& operator=(ring_buffer&& other) noexcept
+  {
+    slots = std::exchange(other.slots, {});
+    head = std::exchange(other.head, 0);
+    count = std::exchange(other.count, 0);
+    return *this;
+  }
+
+  ~ring_buffer() = default;
+
+  /**
+   * Ensure that the buffer can hold at least the given number of elements without allocating.
+   */
+  void reserve(std::size_t new_capacity)
+  {
+    if (new_capacity > capacity()) {
+      grow_to(new_capacity);
+    }
+  }
+
+  [[nodiscard]] std::size_t capacity() const noexcept { return std::size(slots); }
+  [[nodiscard]] std::size_t size() const noexcept { return count; }
+  [[nodiscard]] bool empty() const noexcept { return count == 0; }
+
+  [[nodiscard]] iterator begin() noexcept { return {this, 0}; }
+  [[nodiscard]] iterator end() noexcept { return {this, static_cast<std::ptrdiff_t>(count)}; }
+  [[nodiscard]] const_iterator begin() const noexcept { return {this, 0}; }
+  [[nodiscard]] const_iterator end() const noexcept { return {this, static_cast<std::ptrdiff_t>(count)}; }
+  [[nodiscard]] const_iterator cbegin() const noexcept { return begin(); }
+  [[nodiscard]] const_iterator cend() const noexcept { return end(); }
+
+  [[nodiscard]] reference operator[](std::size_t pos) { return *slot(pos); }
+  [[nodiscard]] const_reference operator[](std::size_t pos) const { return *slot(pos); }
+  [[nodiscard]] reference at(std::size_t pos)
+  {
+    if (pos >= count) {
+      throw std::out_of_range{"ring_buffer::at"};
+    }
+    return *slot(pos);
+  }
+  [[nodiscard]] const_reference at(std::size_t pos) const
+  {
+    if (pos >= count) {
+      throw std::out_of_range{"ring_buffer::at"};
+    }
+    return *slot(pos);
+  }
+
+  [[nodiscard]] reference front() { return *slot(0); }
+  [[nodiscard]] const_reference front() const { return *slot(0); }
+  [[nodiscard]] reference back() { return *slot(count - 1); }
+  [[nodiscard]] const_reference back() const { return *slot(count - 1); }
+
+  template <typename... Args>
+  reference emplace_back(Args&&... args)
+  {
+    if (count == capacity()) {
+      grow_to(2 * capacity());
+    }
+    auto& inserted = slot(count).emplace(std::forward<Args>(args)...);
+    ++count;
+    return inserted;
+  }
+
+  void push_back(const T& value) { emplace_back(value); }
+  void push_back(T&& value) { emplace_back(std::move(value)); }
+
+  void pop_front()
+  {
+    assert(count > 0);
+    slot(0).reset();
+    head = physical(1);
+    --count;
+  }
+
+  void pop_back()
+  {
+    assert(count > 0);
+    slot(count - 1).reset();
+    --count;
+  }
+
+  iterator erase(const_iterator pos) { return erase(pos, std::next(pos)); }
+
+  /**
+   * Erase a range of elements, moving whichever side of the range is shorter to close the gap.
+   */
+  iterator erase(const_iterator first, const_iterator last)
+  {
+    const auto first_pos = static_cast<std::size_t>(first.pos);
+    const auto last_pos = static_cast<std::size_t>(last.pos);
+    const auto num_erased = last_pos - first_pos;
+    if (num_erased == 0) {
+      return {this, first.pos};
+    }
+
+    if (first_pos < count - last_pos) {
+      // Shift the elements before the range toward the back
+      for (std::size_t i = first_pos; i > 0; --i) {
+        slot(i - 1 + num_erased) = std::move(slot(i - 1));
+      }
+      for (std::size_t i = 0; i < num_erased; ++i) {
+        slot(i).reset();
+      }
+      head = physical(num_erased);
+    } else {
+      // Shift the elements after the range toward the front
+      for (std::size_t i = last_pos; i < count; ++i) {
+        slot(i - num_erased) = std::move(slot(i));
+      }
+      for (std::size_t i = count - num_erased; i < count; ++i) {
+        slot(i).reset();
+      }
+    }
+    count -= num_erased;
+    return {this, first.pos};
+  }
+
+  void clear() noexcept
+  {
+    for (std::size_t i = 0; i < count; ++i) {
+      slot(i).reset();
+    }
+    head = 0;
+    count = 0;
+  }
+};
+} // namespace champsim
+
+#endif
@@ -0,0 +1,102 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef UTIL_SHARED_LIST_H
+#define UTIL_SHARED_LIST_H
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+namespace champsim
+{
+/**
+ * An immutable, reference-counted list.
+ *
+ * The elements are allocated once, when the list is created. Copies share the same storage, so a list can be passed through every level of the hierarchy
+ * without allocating. An empty list holds no storage. Removing elements from the front only advances this handle's view of the list.
+ */
+template <typename T>
+class shared_list
+{
+  std::shared_ptr<const std::vector<T>> items{};
+  std::size_t first = 0;
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using const_iterator = const T*;
+  using iterator = const_iterator;
+
+  shared_list() = default;
+  shared_list(std::vector<T>&& elements)
+      : items(std::empty(elements) ? nullptr : std::make_shared<const std::vector<T>>(std::move(elements))) // NOLINT(google-explicit-constructor)
+  {
+  }
+  shared_list(std::initializer_list<T> elements) : shared_list(std::vector<T>{elements}) {}
+
+  template <typename InputIt>
+  shared_list(InputIt begin_, InputIt end_) : shared_list(std::vector<T>(begin_, end_))
+  {
+  }
+
+  [[nodiscard]] const_iterator begin() const noexcept { return items == nullptr ? nullptr : std::data(*items) + first; }
+  [[nodiscard]] const_iterator end() const noexcept { return items == nullptr ? nullptr : std::data(*items) + std::size(*items); }
+  [[nodiscard]] size_type size() const noexcept { return items == nullptr ? 0 : std::size(*items) - first; }
+  [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+  [[nodiscard]] const T& front() const { return *begin(); }
+
+  /**
+   * Remove the first element from this list. Other lists that share the storage are not affected.
+   */
+  void pop_front()
+  {
+    ++first;
+    if (first == std::size(*items)) {
+      items.reset();
+      first = 0;
+    }
+  }
+
+  /**
+   * Merge two sorted lists, keeping one copy of each element.
+   * If either list contains the other, no storage is allocated.
+   */
+  [[nodiscard]] static shared_list set_union(const shared_list& lhs, const shared_list& rhs)
+  {
+    if (std::includes(std::begin(lhs), std::end(lhs), std::begin(rhs), std::end(rhs))) {
+      return lhs;
+    }
+    if (std::includes(std::begin(rhs), std::end(rhs), std::begin(lhs), std::end(lhs))) {
+      return rhs;
+    }
+
+    std::vector<T> merged;
+    merged.reserve(std::size(lhs) + std::size(rhs));
+    std::set_union(std::begin(lhs), std::end(lhs), std::begin(rhs), std::end(rhs), std::back_inserter(merged));
+    return shared_list{std::move(merged)};
+  }
+
+  friend bool operator==(const shared_list& lhs, const shared_list& rhs) { return std::equal(std::begin(lhs), std::end(lhs), std::begin(rhs), std::end(rhs)); }
+  friend bool operator!=(const shared_list& lhs, const shared_list& rhs) { return !(lhs == rhs); }
+};
+} // namespace champsim
+
+#endif
@@ -0,0 +1,93 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef UTIL_SPACE_SAVING_H
+#define UTIL_SPACE_SAVING_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+namespace champsim
+{
+/**
+ * Approximates the most frequent keys of a stream in a fixed number of counters, with the space-saving algorithm of Metwally et al.
+ *
+ * When a key without a counter arrives and every counter is taken, the smallest counter is given to the new key and keeps its count.
+ * The count of a key is then an overestimate by at most its recorded error, and any key that occurs more than (total / capacity) times is kept.
+ */
+template <typename Key>
+class space_saving
+{
+public:
+  struct entry {
+    Key key;
+    uint64_t count;
+    uint64_t error; // the most the count may overestimate the occurrences of the key
+  };
+
+private:
+  std::vector<entry> entries{};
+  std::size_t capacity = 0;
+  uint64_t total_count = 0;
+
+public:
+  space_saving() = default;
+  explicit space_saving(std::size_t num_counters) : capacity(num_counters) { entries.reserve(capacity); }
+
+  void add(const Key& key)
+  {
+    if (capacity == 0) {
+      return;
+    }
+    ++total_count;
+
+    auto found = std::find_if(std::begin(entries), std::end(entries), [&key](const entry& x) { return x.key == key; });
+    if (found != std::end(entries)) {
+      ++found->count;
+    } else if (std::size(entries) < capacity) {
+      entries.push_back({key, 1, 0});
+    } else {
+      auto smallest = std::min_element(std::begin(entries), std::end(entries), [](const entry& x, const entry& y) { return x.count < y.count; });
+      *smallest = {key, smallest->count + 1, smallest->count};
+    }
+  }
+
+  /**
+   * The tracked keys, from the most to the least frequent.
+   */
+  [[nodiscard]] std::vector<entry> top() const
+  {
+    auto result = entries;
+    std::stable_sort(std::begin(result), std::end(result), [](const entry& x, const entry& y) { return x.count > y.count; });
+    return result;
+  }
+
+  [[nodiscard]] std::size_t num_counters() const { return capacity; }
+  [[nodiscard]] uint64_t total() const { return total_count; }
+
+  void clear()
+  {
+    entries.clear();
+    total_count = 0;
+  }
+};
+} // namespace champsim
+
+#endif
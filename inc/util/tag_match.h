@@ -0,0 +1,95 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef UTIL_TAG_MATCH_H
+#define UTIL_TAG_MATCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#if defined(__AVX2__) || defined(__SSE4_1__)
+#include <immintrin.h>
+#endif
+
+namespace champsim
+{
+namespace detail
+{
+template <std::size_t... I>
+std::size_t find_tag_unrolled(const uint64_t* tags, uint64_t tag, std::index_sequence<I...>)
+{
+  // Visit the tags from the back, so that the first match is the one that is kept
+  constexpr std::size_t count = sizeof...(I);
+  std::size_t found = count;
+  ((found = (tags[count - 1 - I] == tag) ? count - 1 - I : found), ...);
+  return found;
+}
+} // namespace detail
+
+/**
+ * Find the first of a contiguous array of tags that is equal to the given tag, or return the number of tags if none match.
+ *
+ * The tags of a set are compared several at a time with the widest vector compare that the target supports (build with -mavx2 or -msse4.1 to enable them).
+ * Otherwise, the common associativities are compared without a loop, and any other is compared without an early exit so that the compiler can vectorize it.
+ */
+inline std::size_t find_tag(const uint64_t* tags, std::size_t count, uint64_t tag)
+{
+  std::size_t i = 0;
+#if defined(__AVX2__)
+  const auto needle = _mm256_set1_epi64x(static_cast<long long>(tag));
+  for (; i + 4 <= count; i += 4) {
+    const auto hay = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(tags + i)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    const auto mask = static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(hay, needle))));
+    if (mask != 0) {
+      return i + static_cast<std::size_t>(__builtin_ctz(mask));
+    }
+  }
+#elif defined(__SSE4_1__)
+  const auto needle = _mm_set1_epi64x(static_cast<long long>(tag));
+  for (; i + 2 <= count; i += 2) {
+    const auto hay = _mm_loadu_si128(reinterpret_cast<const __m128i*>(tags + i)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    const auto mask = static_cast<unsigned>(_mm_movemask_pd(_mm_castsi128_pd(_mm_cmpeq_epi64(hay, needle))));
+    if (mask != 0) {
+      return i + static_cast<std::size_t>(__builtin_ctz(mask));
+    }
+  }
+#else
+  switch (count) {
+  case 4:
+    return detail::find_tag_unrolled(tags, tag, std::make_index_sequence<4>{});
+  case 8:
+    return detail::find_tag_unrolled(tags, tag, std::make_index_sequence<8>{});
+  case 12:
+    return detail::find_tag_unrolled(tags, tag, std::make_index_sequence<12>{});
+  case 16:
+    return detail::find_tag_unrolled(tags, tag, std::make_index_sequence<16>{});
+  default:
+    break;
+  }
+#endif
+
+  // Scan the remainder from the back so that the first match is the one that is kept
+  std::size_t found = count;
+  for (std::size_t j = count; j > i; --j) {
+    found = (tags[j - 1] == tag) ? (j - 1) : found;
+  }
+  return found;
+}
+} // namespace champsim
+
+#endif
@@ -0,0 +1,99 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef WAY_PARTITIONER_H
+#define WAY_PARTITIONER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "block.h"
+
+namespace champsim
+{
+/**
+ * Partitions the ways of a shared cache between cores, by utility-based cache partitioning (UCP).
+ *
+ * A utility monitor (UMON) keeps, for each core, the tags of a few sampled sets as if the core had the whole cache to itself, and counts the hits at
+ * each position of the LRU stack. Periodically, the lookahead algorithm gives each way to the core that gains the most hits from it, and the counts
+ * are halved so that they follow the recent behavior.
+ *
+ * The allocations are enforced at replacement. A core below its allocation evicts a block of a core above its own, and any other core evicts one of
+ * its own blocks. The victim chosen by the replacement policy is kept if it is such a block, or else the least recently touched one is evicted.
+ * A default-constructed partitioner is disabled.
+ */
+class way_partitioner
+{
+public:
+  constexpr static std::size_t monitored_sets = 32;
+  constexpr static uint64_t default_interval = 5'000'000; // cycles between repartitions
+  constexpr static uint32_t no_owner = std::numeric_limits<uint32_t>::max();
+
+private:
+  std::size_t num_cpus = 0;
+  std::size_t num_sets = 0;
+  std::size_t num_ways = 0;
+  std::size_t monitor_stride = 1; // every monitor_stride-th set is monitored
+  uint64_t interval = default_interval;
+  uint64_t next_repartition = default_interval;
+  uint64_t touches = 0;
+
+  std::vector<std::vector<uint64_t>> shadow_tags{}; // the LRU stacks of each core in each monitored set, most recent first
+  std::vector<uint64_t> stack_hits{};               // hits at each stack position of each core
+  std::vector<uint32_t> allocation{};
+  uint64_t repartition_count = 0;
+
+  std::vector<uint32_t> owners{}; // the core that filled each block of the cache
+  std::vector<uint64_t> last_touch{};
+  std::vector<uint32_t> occupancy{};
+
+  [[nodiscard]] std::size_t block_index(long set, long way) const;
+
+public:
+  way_partitioner() = default;
+  way_partitioner(std::size_t cpus, std::size_t sets, std::size_t ways, uint64_t repartition_interval = default_interval);
+
+  [[nodiscard]] bool enabled() const { return num_cpus > 0; }
+  [[nodiscard]] const std::vector<uint32_t>& allocations() const { return allocation; }
+  [[nodiscard]] uint64_t repartitions() const { return repartition_count; }
+
+  /**
+   * Record an access by a core to the monitors, repartitioning the ways if the interval has passed.
+   */
+  void observe(uint32_t cpu, long set, uint64_t block, uint64_t cycle);
+
+  /**
+   * Recompute the allocations from the hits counted by the monitors.
+   */
+  void repartition();
+
+  /**
+   * Record a hit to, or a fill of, a block of the cache.
+   */
+  void touch(long set, long way);
+  void fill(uint32_t cpu, long set, long way);
+
+  /**
+   * Restrict the victim chosen by the replacement policy for a fill by the given core to the ways the core may evict.
+   */
+  [[nodiscard]] long restrict_victim(uint32_t cpu, long set, const cache_block* current_set, long chosen);
+};
+} // namespace champsim
+
+#endif
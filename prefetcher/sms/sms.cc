@@ -48,7 +48,7 @@ uint32_t sms::prefetcher_cache_operate(champsim::address address, champsim::addr
       /* filter table miss. Beginning of new generation. Issue prefetch */
       insert_filter_table(ip.to<uint64_t>(), page, offset);
       generate_prefetch(ip.to<uint64_t>(), addr, page, offset, pref_addr);
-      buffer_prefetch(pref_addr);
+      buffer_prefetch(pref_addr, offset);
     }
   }
   return 0;
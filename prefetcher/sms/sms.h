@@ -9,6 +9,7 @@
 #define __SMS_H__
 
 #include <deque>
+#include <utility>
 #include <vector>
 
 #include "champsim.h"
@@ -33,7 +34,7 @@ private:
   std::deque<ATEntry*> acc_table;
   std::vector<std::deque<PHTEntry*>> pht;
   uint32_t pht_sets;
-  std::deque<uint64_t> pref_buffer;
+  std::deque<std::pair<uint64_t, uint32_t>> pref_buffer; // addresses and their priorities
 
   // private functions
   std::deque<FTEntry*>::iterator search_filter_table(uint64_t page);
@@ -55,7 +56,7 @@ private:
 
   uint64_t create_signature(uint64_t pc, uint32_t offset);
   std::size_t generate_prefetch(uint64_t pc, uint64_t address, uint64_t page, uint32_t offset, std::vector<uint64_t>& pref_addr);
-  void buffer_prefetch(std::vector<uint64_t> pref_addr);
+  void buffer_prefetch(const std::vector<uint64_t>& pref_addr, uint32_t offset);
   void issue_prefetch();
 
 public:
@@ -205,33 +205,29 @@ std::size_t sms::generate_prefetch(uint64_t pc, uint64_t address, uint64_t page,
   return pref_addr.size();
 }
 
-void sms::buffer_prefetch(std::vector<uint64_t> pref_addr)
+// The blocks nearest the trigger are given the highest priority
+void sms::buffer_prefetch(const std::vector<uint64_t>& pref_addr, uint32_t offset)
 {
-  // cout << "buffering " << pref_addr.size() << " already present " << pref_buffer.size() << endl;
-  uint32_t count = 0;
-  for (uint32_t index = 0; index < pref_addr.size(); ++index) {
+  for (auto addr : pref_addr) {
     if (pref_buffer.size() >= sms::PREF_BUFFER_SIZE) {
       break;
     }
-    pref_buffer.push_back(pref_addr[index]);
-    count++;
+    auto index = (uint32_t)((addr >> LOG2_BLOCK_SIZE) & ((1ull << (sms::REGION_SIZE_LOG - LOG2_BLOCK_SIZE)) - 1));
+    auto distance = (index > offset) ? (index - offset) : (offset - index);
+    pref_buffer.emplace_back(addr, BITMAP_MAX_SIZE - distance);
   }
-  //   stats.pref_buffer.buffered += count;
-  //   stats.pref_buffer.spilled += (pref_addr.size() - count);
 }
 
+// Offer at most PREF_DEGREE candidates each cycle. The cache filters and orders them, and issues them as its prefetch queue has room.
 void sms::issue_prefetch()
 {
   uint32_t count = 0;
   while (!pref_buffer.empty() && count < sms::PREF_DEGREE) {
-    champsim::address pf_addr{pref_buffer.front()};
-    const bool success = prefetch_line(pf_addr, true, 0);
-    if (!success)
+    auto [addr, priority] = pref_buffer.front();
+    if (!push_prefetch_candidate(champsim::address{addr}, true, 0, priority)) {
       break;
-    else {
-      pref_buffer.pop_front();
-      count++;
     }
+    pref_buffer.pop_front();
+    count++;
   }
-  //   stats.pref_buffer.issued += pref_addr.size();
-}
\ No newline at end of file
+}
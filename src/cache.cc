@@ -27,19 +27,25 @@
 #include "champsim.h"
 #include "chrono.h"
 #include "deadlock.h"
+#include "dpc_api.h"
 #include "instruction.h"
 #include "util/algorithm.h"
 #include "util/bits.h"
 #include "util/span.h"
+#include "util/tag_match.h"
 
 CACHE::CACHE(CACHE&& other)
-    : operable(other),
+    : operable(other), set_sampling(std::move(other.set_sampling)),
+      profiler(std::move(other.profiler)), pollution_filter(std::move(other.pollution_filter)), throttle(std::move(other.throttle)),
+      ensemble(std::move(other.ensemble)), prefetch_component(other.prefetch_component), prefetch_candidates(std::move(other.prefetch_candidates)),
+      pf_filter(std::move(other.pf_filter)), pf_trace(std::move(other.pf_trace)), partitioner(std::move(other.partitioner)),
 
       upper_levels(std::move(other.upper_levels)), lower_level(std::move(other.lower_level)), lower_translate(std::move(other.lower_translate)),
 
       cpu(other.cpu), NAME(std::move(other.NAME)), NUM_SET(other.NUM_SET), NUM_WAY(other.NUM_WAY), MSHR_SIZE(other.MSHR_SIZE), PQ_SIZE(other.PQ_SIZE),
-      HIT_LATENCY(other.HIT_LATENCY), FILL_LATENCY(other.FILL_LATENCY), OFFSET_BITS(other.OFFSET_BITS), block(std::move(other.block)), MAX_TAG(other.MAX_TAG),
-      MAX_FILL(other.MAX_FILL), prefetch_as_load(other.prefetch_as_load), match_offset_bits(other.match_offset_bits), virtual_prefetch(other.virtual_prefetch),
+      HIT_LATENCY(other.HIT_LATENCY), FILL_LATENCY(other.FILL_LATENCY), OFFSET_BITS(other.OFFSET_BITS), block(std::move(other.block)),
+      block_tags(std::move(other.block_tags)), MAX_TAG(other.MAX_TAG), MAX_FILL(other.MAX_FILL), prefetch_as_load(other.prefetch_as_load),
+      match_offset_bits(other.match_offset_bits), virtual_prefetch(other.virtual_prefetch), inclusion(other.inclusion),
       pref_activate_mask(std::move(other.pref_activate_mask)),
 
       sim_stats(std::move(other.sim_stats)), roi_stats(std::move(other.roi_stats)),
@@ -73,11 +79,23 @@ auto CACHE::operator=(CACHE&& other) -> CACHE&
   this->OFFSET_BITS = other.OFFSET_BITS;
   ;
   this->block = std::move(other.block);
+  this->block_tags = std::move(other.block_tags);
+  this->set_sampling = std::move(other.set_sampling);
+  this->profiler = std::move(other.profiler);
+  this->pollution_filter = std::move(other.pollution_filter);
+  this->throttle = std::move(other.throttle);
+  this->ensemble = std::move(other.ensemble);
+  this->prefetch_component = other.prefetch_component;
+  this->prefetch_candidates = std::move(other.prefetch_candidates);
+  this->pf_filter = std::move(other.pf_filter);
+  this->pf_trace = std::move(other.pf_trace);
+  this->partitioner = std::move(other.partitioner);
   this->MAX_TAG = other.MAX_TAG;
   this->MAX_FILL = other.MAX_FILL;
   this->prefetch_as_load = other.prefetch_as_load;
   this->match_offset_bits = other.match_offset_bits;
   this->virtual_prefetch = other.virtual_prefetch;
+  this->inclusion = other.inclusion;
   this->pref_activate_mask = std::move(other.pref_activate_mask);
 
   this->sim_stats = std::move(other.sim_stats);
@@ -94,34 +112,36 @@ auto CACHE::operator=(CACHE&& other) -> CACHE&
 
 CACHE::tag_lookup_type::tag_lookup_type(const request_type& req, bool local_pref, bool skip)
     : address(req.address), v_address(req.v_address), data(req.data), ip(req.ip), instr_id(req.instr_id), pf_metadata(req.pf_metadata), cpu(req.cpu),
-      type(req.type), prefetch_from_this(local_pref), skip_fill(skip), is_translated(req.is_translated), instr_depend_on_me(req.instr_depend_on_me)
+      type(req.type), prefetch_from_this(local_pref), skip_fill(skip), is_translated(req.is_translated), clean(req.clean),
+      instr_depend_on_me(req.instr_depend_on_me)
 {
 }
 
 CACHE::mshr_type::mshr_type(const tag_lookup_type& req, champsim::chrono::clock::time_point _time_enqueued)
     : address(req.address), v_address(req.v_address), ip(req.ip), instr_id(req.instr_id), cpu(req.cpu), type(req.type),
-      prefetch_from_this(req.prefetch_from_this), time_enqueued(_time_enqueued), instr_depend_on_me(req.instr_depend_on_me), to_return(req.to_return)
+      prefetch_from_this(req.prefetch_from_this), clean(req.clean), pf_component(req.pf_component), pf_metadata(req.pf_metadata),
+      time_enqueued(_time_enqueued),
+      instr_depend_on_me(req.instr_depend_on_me), to_return(req.to_return)
 {
 }
 
 CACHE::mshr_type CACHE::mshr_type::merge(mshr_type predecessor, mshr_type successor)
 {
-  std::vector<uint64_t> merged_instr{};
-  std::vector<std::deque<response_type>*> merged_return{};
-
-  std::set_union(std::begin(predecessor.instr_depend_on_me), std::end(predecessor.instr_depend_on_me), std::begin(successor.instr_depend_on_me),
-                 std::end(successor.instr_depend_on_me), std::back_inserter(merged_instr));
-  std::set_union(std::begin(predecessor.to_return), std::end(predecessor.to_return), std::begin(successor.to_return), std::end(successor.to_return),
-                 std::back_inserter(merged_return));
-
-  mshr_type retval{(successor.type == access_type::PREFETCH) ? predecessor : successor};
+  auto merged_instr = champsim::shared_list<uint64_t>::set_union(predecessor.instr_depend_on_me, successor.instr_depend_on_me);
+  auto merged_return = predecessor.to_return | successor.to_return;
+  auto merged_late = predecessor.late_prefetch || successor.late_prefetch;
 
   // set the time enqueued to the predecessor unless its a demand into prefetch, in which case we use the successor
-  retval.time_enqueued =
+  auto merged_time_enqueued =
       ((successor.type != access_type::PREFETCH && predecessor.type == access_type::PREFETCH)) ? successor.time_enqueued : predecessor.time_enqueued;
-  retval.instr_depend_on_me = merged_instr;
+  auto merged_promise = predecessor.data_promise;
+
+  mshr_type retval{(successor.type == access_type::PREFETCH) ? std::move(predecessor) : std::move(successor)};
+  retval.time_enqueued = merged_time_enqueued;
+  retval.instr_depend_on_me = std::move(merged_instr);
   retval.to_return = merged_return;
-  retval.data_promise = predecessor.data_promise;
+  retval.late_prefetch = merged_late;
+  retval.data_promise = merged_promise;
 
   if constexpr (champsim::debug_print) {
     if (successor.type == access_type::PREFETCH) {
@@ -143,15 +163,34 @@ auto CACHE::fill_block(mshr_type mshr, uint32_t metadata) -> BLOCK
   CACHE::BLOCK to_fill;
   to_fill.valid = true;
   to_fill.prefetch = mshr.prefetch_from_this;
-  to_fill.dirty = (mshr.type == access_type::WRITE);
+  to_fill.dirty = (mshr.type == access_type::WRITE) && !mshr.clean;
   to_fill.address = mshr.address;
   to_fill.v_address = mshr.v_address;
   to_fill.data = mshr.data_promise->data;
   to_fill.pf_metadata = metadata;
+  to_fill.pf_component = mshr.pf_component;
+  to_fill.pf_issue_metadata = mshr.pf_metadata;
 
   return to_fill;
 }
 
+auto CACHE::writeback_packet(const BLOCK& victim, uint32_t triggering_cpu, uint64_t instr_id) -> request_type
+{
+  request_type packet;
+
+  packet.cpu = triggering_cpu;
+  packet.address = victim.address;
+  packet.data = victim.data;
+  packet.instr_id = instr_id;
+  packet.ip = champsim::address{};
+  packet.type = access_type::WRITE;
+  packet.pf_metadata = victim.pf_metadata;
+  packet.response_requested = false;
+  packet.clean = !victim.dirty;
+
+  return packet;
+}
+
 auto CACHE::matches_address(champsim::address addr) const
 {
   return [match = addr.slice_upper(OFFSET_BITS), shamt = OFFSET_BITS](const auto& entry) {
@@ -172,14 +211,22 @@ bool CACHE::handle_fill(const mshr_type& fill_mshr)
 
   // find victim
   auto [set_begin, set_end] = get_set_span(fill_mshr.address);
-  auto way = std::find_if_not(set_begin, set_end, [](auto x) { return x.valid; });
-  if (way == set_end) {
-    way = std::next(set_begin, impl_find_victim(fill_mshr.cpu, fill_mshr.instr_id, get_set_index(fill_mshr.address), &*set_begin, fill_mshr.ip,
-                                                fill_mshr.address, fill_mshr.type));
+  assert(set_sampling.is_sampled(get_set_index(fill_mshr.address))); // The misses to the other sets are not filled
+  // An exclusive cache holds only its own prefetches and the victims of the upper levels.
+  const bool allocate = (inclusion != champsim::inclusion_policy::EXCLUSIVE || fill_mshr.type == access_type::WRITE || fill_mshr.prefetch_from_this);
+  auto way = set_end;
+  if (allocate) {
+    way = std::find_if_not(set_begin, set_end, [](auto x) { return x.valid; });
+  }
+  if (allocate && way == set_end) {
+    auto victim = impl_find_victim(fill_mshr.cpu, fill_mshr.instr_id, get_set_index(fill_mshr.address), &*set_begin, fill_mshr.ip, fill_mshr.address,
+                                   fill_mshr.type);
+    victim = partitioner.restrict_victim(fill_mshr.cpu, get_set_index(fill_mshr.address), &*set_begin, victim);
+    way = std::next(set_begin, victim);
   }
   assert(set_begin <= way);
   assert(way <= set_end);
-  assert(way != set_end || fill_mshr.type != access_type::WRITE); // Writes may not bypass
+  assert(way != set_end || fill_mshr.type != access_type::WRITE || !allocate); // Writes may not bypass
   const auto way_idx = std::distance(set_begin, way);             // cast protected by earlier assertion
 
   if constexpr (champsim::debug_print) {
@@ -189,24 +236,15 @@ bool CACHE::handle_fill(const mshr_type& fill_mshr)
                (fill_mshr.time_enqueued.time_since_epoch()) / clock_period, (current_time.time_since_epoch()) / clock_period);
   }
 
-  if (way != set_end && way->valid && way->dirty) {
-    request_type writeback_packet;
-
-    writeback_packet.cpu = fill_mshr.cpu;
-    writeback_packet.address = way->address;
-    writeback_packet.data = way->data;
-    writeback_packet.instr_id = fill_mshr.instr_id;
-    writeback_packet.ip = champsim::address{};
-    writeback_packet.type = access_type::WRITE;
-    writeback_packet.pf_metadata = way->pf_metadata;
-    writeback_packet.response_requested = false;
+  if (way != set_end && way->valid && (way->dirty || (lower_level != nullptr && lower_level->writeback_clean_victims))) {
+    auto wb_packet = writeback_packet(*way, fill_mshr.cpu, fill_mshr.instr_id);
 
     if constexpr (champsim::debug_print) {
-      fmt::print("[{}] {} evict address: {} v_address: {} prefetch_metadata: {}\n", NAME, __func__, writeback_packet.address, writeback_packet.v_address,
+      fmt::print("[{}] {} evict address: {} v_address: {} prefetch_metadata: {}\n", NAME, __func__, wb_packet.address, wb_packet.v_address,
                  fill_mshr.data_promise->pf_metadata);
     }
 
-    auto success = lower_level->add_wq(writeback_packet);
+    auto success = lower_level->add_wq(wb_packet);
     if (!success) {
       return false;
     }
@@ -217,14 +255,48 @@ bool CACHE::handle_fill(const mshr_type& fill_mshr)
     evicting_address = module_address(*way);
   }
 
+  throttle.begin_invocation();
   auto metadata_thru = impl_prefetcher_cache_fill(module_address(fill_mshr), get_set_index(fill_mshr.address), way_idx,
                                                   (fill_mshr.type == access_type::PREFETCH), evicting_address, fill_mshr.data_promise->pf_metadata);
-  impl_replacement_cache_fill(fill_mshr.cpu, get_set_index(fill_mshr.address), way_idx, module_address(fill_mshr), fill_mshr.ip, evicting_address,
-                              fill_mshr.type);
+  if (allocate) {
+    impl_replacement_cache_fill(fill_mshr.cpu, get_set_index(fill_mshr.address), way_idx, module_address(fill_mshr), fill_mshr.ip, evicting_address,
+                                fill_mshr.type);
+  }
 
   if (way != set_end) {
     if (way->valid && way->prefetch) {
       ++sim_stats.pf_useless;
+      sim_stats.pf_useless_by_metadata.increment(way->pf_issue_metadata);
+      if (ensemble.charges(way->pf_component)) {
+        sim_stats.pf_useless_by_component.increment(way->pf_component);
+      }
+    }
+
+    // Remember the demand blocks that prefetches evict, to find the misses they cause
+    pollution_filter.invalidate({mshr_indexer{OFFSET_BITS}(fill_mshr.address), 0});
+    if (way->valid && !way->prefetch && fill_mshr.type == access_type::PREFETCH && fill_mshr.prefetch_from_this) {
+      pollution_filter.fill({mshr_indexer{OFFSET_BITS}(way->address), fill_mshr.pf_metadata});
+    }
+
+    // Virtual prefetches are filtered by their virtual addresses, which the fills do not have
+    if (!virtual_prefetch) {
+      if (way->valid) {
+        pf_filter.erase(mshr_indexer{OFFSET_BITS}(way->address));
+      }
+      pf_filter.insert(mshr_indexer{OFFSET_BITS}(fill_mshr.address));
+    }
+
+    if (way->valid && profiler.enabled()) {
+      profiler.record_eviction(get_set_index(fill_mshr.address));
+    }
+
+    if (way->valid && inclusion == champsim::inclusion_policy::INCLUSIVE) {
+      ++sim_stats.back_invalidations;
+      for (auto* ul : upper_levels) {
+        if (ul->accepts_invalidations) {
+          ul->invalidations.push_back(way->address);
+        }
+      }
     }
 
     if (fill_mshr.type == access_type::PREFETCH) {
@@ -232,18 +304,25 @@ bool CACHE::handle_fill(const mshr_type& fill_mshr)
     }
 
     *way = fill_block(fill_mshr, metadata_thru);
+    partitioner.fill(fill_mshr.cpu, get_set_index(fill_mshr.address), way_idx);
+    block_tags.at(static_cast<std::size_t>(std::distance(std::begin(block), way))) = block_tag(fill_mshr.address);
   }
 
   // COLLECT STATS
   if (fill_mshr.type != access_type::PREFETCH)
     sim_stats.total_miss_latency_cycles += (current_time - (fill_mshr.time_enqueued + clock_period)) / clock_period;
+  if (fill_mshr.late_prefetch)
+    sim_stats.pf_late_cycles_lost += (current_time - (fill_mshr.time_enqueued + clock_period)) / clock_period;
   sim_stats.mshr_return.increment(std::pair{fill_mshr.type, fill_mshr.cpu});
 
-  response_type response{fill_mshr.address, fill_mshr.v_address, fill_mshr.data_promise->data, metadata_thru, fill_mshr.instr_depend_on_me};
-  for (auto* ret : fill_mshr.to_return) {
-    ret->push_back(response);
+  if (throttle.count_fill()) {
+    throttle.end_interval(prefetch_feedback(), get_dram_bw());
   }
 
+  response_type response{fill_mshr.address, fill_mshr.v_address, fill_mshr.data_promise->data, metadata_thru, fill_mshr.instr_depend_on_me};
+  response.miss_levels = fill_mshr.data_promise->miss_levels + 1;
+  champsim::for_each_set_bit(fill_mshr.to_return, [&](std::size_t i) { upper_levels.at(i)->returned.push_back(response); });
+
   return true;
 }
 
@@ -253,9 +332,11 @@ bool CACHE::try_hit(const tag_lookup_type& handle_pkt)
 
   // access cache
   auto [set_begin, set_end] = get_set_span(handle_pkt.address);
-  auto way = std::find_if(set_begin, set_end, [matcher = matches_address(handle_pkt.address)](const auto& x) { return x.valid && matcher(x); });
-  const auto hit = (way != set_end);
-  const auto useful_prefetch = (hit && way->prefetch && !handle_pkt.prefetch_from_this);
+  const bool sampled = set_sampling.is_sampled(get_set_index(handle_pkt.address));
+  auto way = sampled ? std::next(set_begin, find_way(handle_pkt.address)) : set_end;
+  const auto hit = sampled ? (way != set_end) : !set_sampling.peek_miss(handle_pkt.type);
+  // A hit to the other sets finds a prefetched block as often as the hits to the sampled sets do
+  const auto useful_prefetch = !handle_pkt.prefetch_from_this && (sampled ? (way != set_end && way->prefetch) : (hit && set_sampling.peek_useful()));
 
   if constexpr (champsim::debug_print) {
     fmt::print("[{}] {} instr_id: {} address: {} v_address: {} data: {} set: {} way: {} ({}) type: {} cycle: {}\n", NAME, __func__, handle_pkt.instr_id,
@@ -265,29 +346,78 @@ bool CACHE::try_hit(const tag_lookup_type& handle_pkt)
 
   auto metadata_thru = handle_pkt.pf_metadata;
   if (should_activate_prefetcher(handle_pkt)) {
+    throttle.begin_invocation();
     metadata_thru = impl_prefetcher_cache_operate(module_address(handle_pkt), handle_pkt.ip, hit, useful_prefetch, handle_pkt.type, metadata_thru);
   }
 
   // update replacement policy
   const auto way_idx = std::distance(set_begin, way);
-  impl_update_replacement_state(handle_pkt.cpu, get_set_index(handle_pkt.address), way_idx, module_address(handle_pkt), handle_pkt.ip, {}, handle_pkt.type,
-                                hit);
+  if (sampled) {
+    impl_update_replacement_state(handle_pkt.cpu, get_set_index(handle_pkt.address), way_idx, module_address(handle_pkt), handle_pkt.ip, {},
+                                  handle_pkt.type, hit);
+  }
+
+  // The utility monitors see the accesses of the cores, but not the writebacks from the levels above
+  if (partitioner.enabled()) {
+    if (handle_pkt.type != access_type::WRITE) {
+      partitioner.observe(handle_pkt.cpu, get_set_index(handle_pkt.address), mshr_indexer{OFFSET_BITS}(handle_pkt.address),
+                          static_cast<uint64_t>(current_time.time_since_epoch() / clock_period));
+    }
+    if (sampled && hit) {
+      partitioner.touch(get_set_index(handle_pkt.address), way_idx);
+    }
+  }
 
   if (hit) {
-    sim_stats.hits.increment(std::pair{handle_pkt.type, handle_pkt.cpu});
+    record_tag_check(handle_pkt, true);
+
+    // A modeled hit returns the data that was requested
+    response_type response{handle_pkt.address, handle_pkt.v_address, sampled ? way->data : handle_pkt.data, metadata_thru, handle_pkt.instr_depend_on_me};
+    champsim::for_each_set_bit(handle_pkt.to_return, [&](std::size_t i) { upper_levels.at(i)->returned.push_back(response); });
+
+    const bool writes_data = (handle_pkt.type == access_type::WRITE) && !handle_pkt.clean;
+    if (!sampled) {
+      if (!handle_pkt.prefetch_from_this) {
+        set_sampling.commit_hit(useful_prefetch);
+        if (useful_prefetch) {
+          ++sim_stats.pf_useful;
+        }
+      }
+
+      // The block's eviction becomes a writeback when the write finds the block clean
+      if (writes_data) {
+        const bool dirties = set_sampling.peek_dirtying();
+        set_sampling.commit_write_hit(dirties);
+        if (dirties && (lower_level == nullptr || !lower_level->writeback_clean_victims)) {
+          model_writeback(handle_pkt, true);
+        }
+      }
+      return hit;
+    }
 
-    response_type response{handle_pkt.address, handle_pkt.v_address, way->data, metadata_thru, handle_pkt.instr_depend_on_me};
-    for (auto* ret : handle_pkt.to_return) {
-      ret->push_back(response);
+    if (set_sampling.enabled()) {
+      if (!handle_pkt.prefetch_from_this) {
+        set_sampling.observe_hit(useful_prefetch);
+      }
+      if (writes_data) {
+        set_sampling.observe_write_hit(!way->dirty);
+      }
     }
 
-    way->dirty |= (handle_pkt.type == access_type::WRITE);
+    way->dirty |= writes_data;
 
     // update prefetch stats and reset prefetch bit
     if (useful_prefetch) {
-      ++sim_stats.pf_useful;
+      record_useful_prefetch(way->pf_component, way->pf_issue_metadata);
       way->prefetch = false;
     }
+
+    // An exclusive cache gives the block to the upper level. A dirty block is written back first, or else it is kept.
+    const bool moves_up = (inclusion == champsim::inclusion_policy::EXCLUSIVE && handle_pkt.type != access_type::WRITE && handle_pkt.to_return != 0);
+    if (moves_up && (!way->dirty || lower_level->add_wq(writeback_packet(*way, handle_pkt.cpu, handle_pkt.instr_id)))) {
+      way->valid = false;
+      block_tags.at(static_cast<std::size_t>(std::distance(std::begin(block), way))) = 0;
+    }
   }
 
   return hit;
@@ -331,28 +461,39 @@ bool CACHE::handle_miss(const tag_lookup_type& handle_pkt)
 
   auto mshr_pkt = mshr_and_forward_packet(handle_pkt);
 
-  // check mshr
-  auto mshr_entry = std::find_if(std::begin(MSHR), std::end(MSHR), matches_address(handle_pkt.address));
-  bool mshr_full = (MSHR.size() == MSHR_SIZE);
+  // A miss to a set that is not sampled is sent to the lower level, but is not tracked by an MSHR or filled
+  const bool modeled = !set_sampling.is_sampled(get_set_index(handle_pkt.address));
+
+  // check mshr. The misses being answered for the other sets hold MSHRs in the sets they stand for.
+  auto mshr_entry = modeled ? MSHR.end() : MSHR.find(mshr_indexer{OFFSET_BITS}(handle_pkt.address));
+  bool mshr_full = (MSHR.size() + std::size(modeled_misses) >= MSHR_SIZE);
 
   if (mshr_entry != MSHR.end()) // miss already inflight
   {
     if (mshr_entry->type == access_type::PREFETCH && handle_pkt.type != access_type::PREFETCH) {
-      // Mark the prefetch as useful
+      // Mark the prefetch as useful, but late
       if (mshr_entry->prefetch_from_this) {
-        ++sim_stats.pf_useful;
+        record_useful_prefetch(mshr_entry->pf_component, mshr_entry->pf_metadata);
+        ++sim_stats.pf_late;
+        sim_stats.pf_late_by_metadata.increment(mshr_entry->pf_metadata);
+        sim_stats.pf_late_cycles_saved += (current_time - mshr_entry->time_enqueued) / clock_period;
+        to_allocate.late_prefetch = true;
       }
     }
 
     // COLLECT STATS
     sim_stats.mshr_merge.increment(std::pair{to_allocate.type, to_allocate.cpu});
 
-    *mshr_entry = mshr_type::merge(*mshr_entry, to_allocate);
+    *mshr_entry = mshr_type::merge(std::move(*mshr_entry), std::move(to_allocate));
   } else {
     if (mshr_full) { // not enough MSHR resource
       return false;  // TODO should we allow prefetches anyway if they will not be filled to this level?
     }
 
+    if (modeled) {
+      mshr_pkt.second.response_requested = false;
+    }
+
     const bool send_to_rq = (prefetch_as_load || handle_pkt.type != access_type::PREFETCH);
     bool success = send_to_rq ? lower_level->add_rq(mshr_pkt.second) : lower_level->add_pq(mshr_pkt.second);
 
@@ -360,13 +501,33 @@ bool CACHE::handle_miss(const tag_lookup_type& handle_pkt)
       return false;
     }
 
-    // Allocate an MSHR
-    if (mshr_pkt.second.response_requested) {
+    if (modeled) {
+      // Answer the upper levels as a miss to a sampled set would be answered
+      if (handle_pkt.to_return != 0) {
+        const auto latency = warmup ? champsim::chrono::clock::duration{} : set_sampling.miss_latency(handle_pkt.type);
+        to_allocate.data_promise = champsim::waitable{
+            mshr_type::returned_value{handle_pkt.data, handle_pkt.pf_metadata, set_sampling.miss_levels(handle_pkt.type)}, current_time + latency};
+        modeled_misses.push_back(std::move(to_allocate));
+      }
+
+      const bool writes_data = (handle_pkt.type == access_type::WRITE) && !handle_pkt.clean;
+      if (writes_data || lower_level->writeback_clean_victims) {
+        model_writeback(handle_pkt, writes_data);
+      }
+    } else if (mshr_pkt.second.response_requested) {
+      // Allocate an MSHR
       MSHR.emplace_back(std::move(mshr_pkt.first));
     }
   }
 
-  sim_stats.misses.increment(std::pair{handle_pkt.type, handle_pkt.cpu});
+  if (handle_pkt.type != access_type::PREFETCH && handle_pkt.type != access_type::WRITE) {
+    if (auto evicted_by = pollution_filter.invalidate({mshr_indexer{OFFSET_BITS}(handle_pkt.address), 0}); evicted_by.has_value()) {
+      ++sim_stats.pf_pollution;
+      sim_stats.pf_pollution_by_metadata.increment(evicted_by->pf_metadata);
+    }
+  }
+
+  record_tag_check(handle_pkt, false);
 
   return true;
 }
@@ -379,33 +540,140 @@ bool CACHE::handle_write(const tag_lookup_type& handle_pkt)
                current_time.time_since_epoch() / clock_period);
   }
 
-  mshr_type to_allocate{handle_pkt, current_time};
-  to_allocate.data_promise.ready_at(current_time + (warmup ? champsim::chrono::clock::duration{} : FILL_LATENCY));
-  inflight_writes.push_back(to_allocate);
+  if (!set_sampling.is_sampled(get_set_index(handle_pkt.address))) {
+    // The written block is not filled, so its eventual eviction is sent now
+    if (!handle_pkt.clean || (lower_level != nullptr && lower_level->writeback_clean_victims)) {
+      model_writeback(handle_pkt, !handle_pkt.clean);
+    }
+  } else {
+    mshr_type to_allocate{handle_pkt, current_time};
+    to_allocate.data_promise.ready_at(current_time + (warmup ? champsim::chrono::clock::duration{} : FILL_LATENCY));
+    inflight_writes.push_back(to_allocate);
+  }
 
-  sim_stats.misses.increment(std::pair{handle_pkt.type, handle_pkt.cpu});
+  record_tag_check(handle_pkt, false);
 
   return true;
 }
 
+void CACHE::model_writeback(const tag_lookup_type& handle_pkt, bool dirty)
+{
+  request_type packet;
+
+  packet.cpu = handle_pkt.cpu;
+  packet.address = handle_pkt.address;
+  packet.v_address = handle_pkt.v_address;
+  packet.data = handle_pkt.data;
+  packet.instr_id = handle_pkt.instr_id;
+  packet.ip = champsim::address{};
+  packet.type = access_type::WRITE;
+  packet.pf_metadata = handle_pkt.pf_metadata;
+  packet.response_requested = false;
+  packet.clean = !dirty;
+
+  modeled_writebacks.push_back(packet);
+}
+
+bool CACHE::back_invalidate(champsim::address inval_addr)
+{
+  auto [set_begin, set_end] = get_set_span(inval_addr);
+  auto way = std::next(set_begin, find_way(inval_addr));
+
+  if (way != set_end) {
+    if (way->dirty) {
+      auto wb_packet = writeback_packet(*way, cpu, 0);
+      if (!lower_level->add_wq(wb_packet)) {
+        return false;
+      }
+    }
+
+    way->valid = false;
+    block_tags.at(static_cast<std::size_t>(std::distance(std::begin(block), way))) = 0;
+    ++sim_stats.inclusion_victims;
+  }
+
+  // The levels above may hold the block even if this level does not
+  for (auto* ul : upper_levels) {
+    if (ul->accepts_invalidations) {
+      ul->invalidations.push_back(inval_addr);
+    }
+  }
+
+  return true;
+}
+
+void CACHE::record_useful_prefetch(uint8_t component, uint32_t metadata)
+{
+  ++sim_stats.pf_useful;
+  sim_stats.pf_useful_by_metadata.increment(metadata);
+  if (ensemble.charges(component)) {
+    ensemble.record_useful(component);
+    sim_stats.pf_useful_by_component.increment(component);
+  }
+}
+
+auto CACHE::prefetch_feedback() const -> champsim::prefetch_throttle::feedback_type
+{
+  champsim::prefetch_throttle::feedback_type totals;
+  totals.issued = sim_stats.pf_issued;
+  totals.useful = sim_stats.pf_useful;
+  totals.late = sim_stats.pf_late;
+  totals.pollution = sim_stats.pf_pollution;
+  for (const auto type : {access_type::LOAD, access_type::RFO, access_type::TRANSLATION}) {
+    for (std::size_t i = 0; i < NUM_CPUS; ++i) {
+      totals.demand_misses += static_cast<uint64_t>(sim_stats.misses.value_or(std::pair{type, i}, 0));
+    }
+  }
+  return totals;
+}
+
+void CACHE::record_tag_check(const tag_lookup_type& handle_pkt, bool hit)
+{
+  const auto key = std::pair{handle_pkt.type, handle_pkt.cpu};
+  if (hit) {
+    sim_stats.hits.increment(key);
+  } else {
+    sim_stats.misses.increment(key);
+  }
+
+  if (profiler.enabled()) {
+    profiler.record_access(get_set_index(handle_pkt.address), handle_pkt.ip, handle_pkt.type, hit);
+  }
+
+  if (!set_sampling.enabled()) {
+    return;
+  }
+
+  if (set_sampling.is_sampled(get_set_index(handle_pkt.address))) {
+    set_sampling.observe_access(handle_pkt.type, !hit);
+    if (hit) {
+      sim_stats.sampled_hits.increment(key);
+    } else {
+      sim_stats.sampled_misses.increment(key);
+    }
+  } else {
+    set_sampling.commit_access(handle_pkt.type, !hit);
+  }
+}
+
 template <bool UpdateRequest>
-auto CACHE::initiate_tag_check(champsim::channel* ul)
+auto CACHE::initiate_tag_check(std::size_t upper_level)
 {
-  return [time = current_time + (warmup ? champsim::chrono::clock::duration{} : HIT_LATENCY), ul](const auto& entry) {
+  return [time = current_time + (warmup ? champsim::chrono::clock::duration{} : HIT_LATENCY), upper_level](const auto& entry) {
     CACHE::tag_lookup_type retval{entry};
     retval.event_cycle = time;
 
     if constexpr (UpdateRequest) {
       if (entry.response_requested) {
-        retval.to_return = {&ul->returned};
+        retval.to_return = uint64_t{1} << upper_level;
       }
     } else {
-      (void)ul; // supress warning about ul being unused
+      (void)upper_level; // supress warning about upper_level being unused
     }
 
     if constexpr (champsim::debug_print) {
       fmt::print("[TAG] initiate_tag_check instr_id: {} address: {} v_address: {} type: {} response_requested: {}\n", retval.instr_id, retval.address,
-                 retval.v_address, access_type_names.at(champsim::to_underlying(retval.type)), !std::empty(retval.to_return));
+                 retval.v_address, access_type_names.at(champsim::to_underlying(retval.type)), retval.to_return != 0);
     }
 
     return retval;
@@ -439,14 +707,41 @@ long CACHE::operate()
     lower_translate->returned.clear();
   }
 
+  // Apply back-invalidations from an inclusive lower level
+  if (lower_level != nullptr) {
+    auto invalidated_end = std::find_if_not(std::begin(lower_level->invalidations), std::end(lower_level->invalidations),
+                                            [this](auto inval_addr) { return this->back_invalidate(inval_addr); });
+    progress += std::distance(std::begin(lower_level->invalidations), invalidated_end);
+    lower_level->invalidations.erase(std::begin(lower_level->invalidations), invalidated_end);
+  }
+
   // Perform fills
   champsim::bandwidth fill_bw{MAX_FILL};
-  for (auto q : {std::ref(MSHR), std::ref(inflight_writes)}) {
-    auto [fill_begin, fill_end] = champsim::get_span_p(std::cbegin(q.get()), std::cend(q.get()), fill_bw,
-                                                       [time = current_time](const auto& x) { return x.data_promise.is_ready_at(time); });
-    auto complete_end = std::find_if_not(fill_begin, fill_end, [this](const auto& x) { return this->handle_fill(x); });
-    fill_bw.consume(std::distance(fill_begin, complete_end));
-    q.get().erase(fill_begin, complete_end);
+  auto perform_fills = [this, &fill_bw](auto& queue) {
+    // Only the ready entries at the front of the queue are visited
+    auto complete_end = std::begin(queue);
+    while (fill_bw.has_remaining() && complete_end != std::end(queue) && complete_end->data_promise.is_ready_at(this->current_time)
+           && this->handle_fill(*complete_end)) {
+      fill_bw.consume();
+      ++complete_end;
+    }
+    queue.erase(std::begin(queue), complete_end);
+  };
+  perform_fills(MSHR);
+  perform_fills(inflight_writes);
+
+  // Answer the misses to the sets that are not sampled, and send the writebacks that those sets would cause
+  auto modeled_end = std::stable_partition(std::begin(modeled_misses), std::end(modeled_misses),
+                                          [this](const auto& entry) { return entry.data_promise.is_ready_at(this->current_time); });
+  std::for_each(std::begin(modeled_misses), modeled_end, [this](const auto& entry) { this->finish_modeled_miss(entry); });
+  progress += std::distance(std::begin(modeled_misses), modeled_end);
+  modeled_misses.erase(std::begin(modeled_misses), modeled_end);
+
+  if (lower_level != nullptr) {
+    auto written_end = std::find_if_not(std::begin(modeled_writebacks), std::end(modeled_writebacks),
+                                        [this](const auto& packet) { return this->lower_level->add_wq(packet); });
+    progress += std::distance(std::begin(modeled_writebacks), written_end);
+    modeled_writebacks.erase(std::begin(modeled_writebacks), written_end);
   }
 
   // Initiate tag checks
@@ -461,8 +756,9 @@ long CACHE::operate()
   initiate_tag_bw.consume(stash_bandwidth_consumed);
   std::vector<long long> channels_bandwidth_consumed{};
 
+  // The upper levels take turns going first. They are not reordered, because responses are returned by their index.
   if (std::size(upper_levels) > 1) {
-    std::rotate(upper_levels.begin(), upper_levels.begin() + 1, upper_levels.end());
+    upper_level_rotation = (upper_level_rotation + 1) % std::size(upper_levels);
   }
 
   // upper levels get an equal portion of the remaining bandwidth
@@ -471,13 +767,15 @@ long CACHE::operate()
           ? (champsim::bandwidth::maximum_type)std::max((size_t)initiate_tag_bw.amount_remaining() / std::size(upper_levels), size_t{1})
           : champsim::bandwidth::maximum_type{};
 
-  for (auto* ul : upper_levels) {
+  for (std::size_t turn = 0; turn < std::size(upper_levels); ++turn) {
+    auto ul_index = (upper_level_rotation + turn) % std::size(upper_levels);
+    auto* ul = upper_levels[ul_index];
     for (auto q : {std::ref(ul->WQ), std::ref(ul->RQ), std::ref(ul->PQ)}) {
       // this needs to be in this loop, we need to ensure that for cases where bandwidth doesn't divide nicely across upstreams,
       // we don't accidentally consume more bandwidth than expected
       champsim::bandwidth per_upper_tag_bw{std::min(per_upper_bandwidth, champsim::bandwidth::maximum_type{initiate_tag_bw.amount_remaining()})};
       auto bandwidth_consumed =
-          champsim::transform_while_n(q.get(), std::back_inserter(inflight_tag_check), per_upper_tag_bw, can_translate, initiate_tag_check<true>(ul));
+          champsim::transform_while_n(q.get(), std::back_inserter(inflight_tag_check), per_upper_tag_bw, can_translate, initiate_tag_check<true>(ul_index));
       channels_bandwidth_consumed.push_back(bandwidth_consumed);
       initiate_tag_bw.consume(bandwidth_consumed);
     }
@@ -513,7 +811,9 @@ long CACHE::operate()
   tag_check_bw.consume(std::distance(tag_check_ready_begin, finish_tag_check_end));
   inflight_tag_check.erase(tag_check_ready_begin, finish_tag_check_end);
 
+  throttle.begin_invocation();
   impl_prefetcher_cycle_operate();
+  issue_prefetch_candidates();
 
   if constexpr (champsim::debug_print) {
     fmt::print("[{}] {} cycle completed: {} tags checked: {} remaining: {} stash consumed: {} remaining: {} channel consumed: {} pq consumed {} unused consume "
@@ -529,7 +829,21 @@ long CACHE::operate()
 uint64_t CACHE::get_set(uint64_t address) const { return static_cast<uint64_t>(get_set_index(champsim::address{address})); }
 // LCOV_EXCL_STOP
 
-long CACHE::get_set_index(champsim::address address) const { return address.slice(champsim::dynamic_extent{OFFSET_BITS, champsim::lg2(NUM_SET)}).to<long>(); }
+long CACHE::get_set_index(champsim::address address) const
+{
+  return static_cast<long>((address.to<uint64_t>() >> champsim::to_underlying(OFFSET_BITS)) & (NUM_SET - 1));
+}
+
+// The tag is offset by one so that a zero tag never matches
+uint64_t CACHE::block_tag(champsim::address address) const { return address.slice_upper(OFFSET_BITS).to<uint64_t>() + 1; }
+
+long CACHE::find_way(champsim::address address) const
+{
+  const auto set_idx = get_set_index(address);
+  assert(set_idx < NUM_SET);
+  const auto* set_tags = std::data(block_tags) + static_cast<std::size_t>(set_idx) * NUM_WAY;
+  return static_cast<long>(champsim::find_tag(set_tags, NUM_WAY, block_tag(address)));
+}
 
 template <typename It>
 std::pair<It, It> get_span(It anchor, typename std::iterator_traits<It>::difference_type set_idx, typename std::iterator_traits<It>::difference_type num_way)
@@ -568,17 +882,49 @@ long CACHE::invalidate_entry(champsim::address inval_addr)
 
   if (inv_way != end) {
     inv_way->valid = false;
+    block_tags.at(static_cast<std::size_t>(std::distance(std::begin(block), inv_way))) = 0;
   }
 
   return std::distance(begin, inv_way);
 }
 
 bool CACHE::prefetch_line(champsim::address pf_addr, bool fill_this_level, uint32_t prefetch_metadata)
+{
+  return try_prefetch_line(pf_addr, fill_this_level, prefetch_metadata) == prefetch_result::ISSUED;
+}
+
+auto CACHE::try_prefetch_line(champsim::address pf_addr, bool fill_this_level, uint32_t prefetch_metadata) -> prefetch_result
 {
   ++sim_stats.pf_requested;
 
   if (std::size(internal_PQ) >= PQ_SIZE) {
-    return false;
+    return prefetch_result::QUEUE_FULL;
+  }
+
+  const auto pf_block = mshr_indexer{OFFSET_BITS}(pf_addr);
+  if (pf_filter.contains(pf_block)) {
+    ++sim_stats.pf_filtered;
+    return prefetch_result::FILTERED;
+  }
+
+  const auto component = static_cast<uint8_t>(prefetch_component);
+  if (ensemble.charges(component)) {
+    auto occupancy =
+        std::count_if(std::cbegin(internal_PQ), std::cend(internal_PQ), [component](const auto& entry) { return entry.pf_component == component; });
+    auto admitted = ensemble.try_admit(component, pf_block, static_cast<std::size_t>(occupancy), PQ_SIZE);
+    if (admitted == champsim::prefetch_ensemble::admission::DUPLICATE) {
+      sim_stats.pf_duplicate_by_component.increment(component);
+      return prefetch_result::DUPLICATE;
+    }
+    if (admitted == champsim::prefetch_ensemble::admission::OVER_QUOTA) {
+      sim_stats.pf_over_quota_by_component.increment(component);
+      return prefetch_result::OVER_QUOTA;
+    }
+  }
+
+  if (!throttle.try_admit(std::size(internal_PQ), PQ_SIZE)) {
+    ++sim_stats.pf_throttled;
+    return prefetch_result::THROTTLED;
   }
 
   request_type pf_packet;
@@ -590,9 +936,89 @@ bool CACHE::prefetch_line(champsim::address pf_addr, bool fill_this_level, uint3
   pf_packet.is_translated = !virtual_prefetch;
 
   internal_PQ.emplace_back(pf_packet, true, !fill_this_level);
+  internal_PQ.back().pf_component = component;
+  pf_filter.insert(pf_block);
   ++sim_stats.pf_issued;
+  sim_stats.pf_issued_by_metadata.increment(prefetch_metadata);
+  if (ensemble.charges(component)) {
+    sim_stats.pf_issued_by_component.increment(component);
+  }
 
-  return true;
+  return prefetch_result::ISSUED;
+}
+
+bool CACHE::push_prefetch_candidate(champsim::address pf_addr, bool fill_this_level, uint32_t prefetch_metadata, uint32_t priority)
+{
+  ++sim_stats.pf_candidates;
+
+  champsim::prefetch_candidate_queue::candidate_type candidate;
+  candidate.address = pf_addr;
+  candidate.block = mshr_indexer{OFFSET_BITS}(pf_addr);
+  candidate.fill_this_level = fill_this_level;
+  candidate.metadata = prefetch_metadata;
+  candidate.priority = priority;
+  candidate.component = prefetch_component;
+
+  auto result = prefetch_candidates.push(candidate);
+  if (result == champsim::prefetch_candidate_queue::push_result::MERGED) {
+    ++sim_stats.pf_candidates_filtered;
+  } else if (result == champsim::prefetch_candidate_queue::push_result::REPLACED || result == champsim::prefetch_candidate_queue::push_result::DROPPED) {
+    ++sim_stats.pf_candidates_dropped;
+  }
+
+  return result != champsim::prefetch_candidate_queue::push_result::DROPPED;
+}
+
+void CACHE::issue_prefetch_candidates()
+{
+  if (prefetch_candidates.empty()) {
+    return;
+  }
+
+  // Collect the blocks already in flight once for the whole batch, rather than searching the queues for each candidate
+  std::vector<uint64_t> requested_blocks;
+  auto requested_block = [this](const auto& entry) {
+    return mshr_indexer{OFFSET_BITS}(virtual_prefetch && entry.prefetch_from_this ? entry.v_address : entry.address);
+  };
+  std::transform(std::cbegin(internal_PQ), std::cend(internal_PQ), std::back_inserter(requested_blocks), requested_block);
+  std::transform(std::cbegin(inflight_tag_check), std::cend(inflight_tag_check), std::back_inserter(requested_blocks), requested_block);
+  std::transform(std::cbegin(translation_stash), std::cend(translation_stash), std::back_inserter(requested_blocks), requested_block);
+  if (!virtual_prefetch) {
+    std::transform(std::cbegin(MSHR), std::cend(MSHR), std::back_inserter(requested_blocks),
+                   [this](const auto& entry) { return mshr_indexer{OFFSET_BITS}(entry.address); });
+  }
+  std::sort(std::begin(requested_blocks), std::end(requested_blocks));
+
+  const auto restore_component = prefetch_component;
+  while (!prefetch_candidates.empty() && std::size(internal_PQ) < PQ_SIZE) {
+    auto candidate = prefetch_candidates.front();
+
+    // Virtual candidates cannot be checked against the physical tags
+    const bool cached = !virtual_prefetch && find_way(candidate.address) < static_cast<long>(NUM_WAY);
+    auto requested = std::lower_bound(std::begin(requested_blocks), std::end(requested_blocks), candidate.block);
+    if (cached || (requested != std::end(requested_blocks) && *requested == candidate.block)) {
+      prefetch_candidates.pop_front();
+      ++sim_stats.pf_candidates_filtered;
+      continue;
+    }
+
+    prefetch_component = candidate.component;
+    auto result = try_prefetch_line(candidate.address, candidate.fill_this_level, candidate.metadata);
+    if (result == prefetch_result::ISSUED) {
+      prefetch_candidates.pop_front();
+      requested_blocks.insert(requested, candidate.block);
+      continue;
+    }
+
+    // A candidate that was prefetched recently will not be admitted on a later cycle either, so it is dropped.
+    // A candidate held back by the throttle or the quota stays at the head of the queue until the next cycle.
+    if (result == prefetch_result::FILTERED || result == prefetch_result::DUPLICATE) {
+      prefetch_candidates.pop_front();
+      ++sim_stats.pf_candidates_dropped;
+    }
+    break;
+  }
+  prefetch_component = restore_component;
 }
 
 // LCOV_EXCL_START exclude deprecated function
@@ -610,8 +1036,7 @@ bool CACHE::prefetch_line(uint64_t /*deprecated*/, uint64_t /*deprecated*/, uint
 void CACHE::finish_packet(const response_type& packet)
 {
   // check MSHR information
-  auto mshr_entry = std::find_if(std::begin(MSHR), std::end(MSHR), matches_address(packet.address));
-  auto first_unreturned = std::find_if(MSHR.begin(), MSHR.end(), [](auto x) { return x.data_promise.has_unknown_readiness(); });
+  auto mshr_entry = MSHR.find(mshr_indexer{OFFSET_BITS}(packet.address));
 
   // sanity check
   if (mshr_entry == MSHR.end()) {
@@ -620,16 +1045,33 @@ void CACHE::finish_packet(const response_type& packet)
   }
 
   // MSHR holds the most updated information about this request
-  mshr_type::returned_value finished_value{packet.data, packet.pf_metadata};
+  mshr_type::returned_value finished_value{packet.data, packet.pf_metadata, packet.miss_levels};
   mshr_entry->data_promise = champsim::waitable{finished_value, current_time + (warmup ? champsim::chrono::clock::duration{} : FILL_LATENCY)};
+  // Misses during warmup return immediately, so they are not used to model the latency
+  if (set_sampling.enabled() && !warmup) {
+    set_sampling.observe_miss(mshr_entry->type, (current_time - mshr_entry->time_enqueued) + FILL_LATENCY, packet.miss_levels);
+  }
   if constexpr (champsim::debug_print) {
     fmt::print("[{}_MSHR] finish_packet instr_id: {} address: {} data: {} type: {} current: {}\n", this->NAME, mshr_entry->instr_id, mshr_entry->address,
                mshr_entry->data_promise->data, access_type_names.at(champsim::to_underlying(mshr_entry->type)), current_time.time_since_epoch() / clock_period);
   }
 
   // Order this entry after previously-returned entries, but before non-returned
-  // entries
-  std::iter_swap(mshr_entry, first_unreturned);
+  // entries. The returned entries are at the front, so this search is short.
+  auto first_unreturned = std::find_if(std::begin(MSHR), std::end(MSHR), [](const auto& x) { return x.data_promise.has_unknown_readiness(); });
+  MSHR.move_before(first_unreturned, mshr_entry);
+}
+
+void CACHE::finish_modeled_miss(const mshr_type& entry)
+{
+  if (entry.type != access_type::PREFETCH) {
+    sim_stats.total_miss_latency_cycles += (current_time - (entry.time_enqueued + clock_period)) / clock_period;
+  }
+  sim_stats.mshr_return.increment(std::pair{entry.type, entry.cpu});
+
+  response_type response{entry.address, entry.v_address, entry.data_promise->data, entry.data_promise->pf_metadata, entry.instr_depend_on_me};
+  response.miss_levels = entry.data_promise->miss_levels + 1;
+  champsim::for_each_set_bit(entry.to_return, [&](std::size_t i) { upper_levels.at(i)->returned.push_back(response); });
 }
 
 void CACHE::finish_translation(const response_type& packet)
@@ -797,12 +1239,38 @@ void CACHE::impl_prefetcher_initialize() const { pref_module_pimpl->impl_prefetc
 uint32_t CACHE::impl_prefetcher_cache_operate(champsim::address addr, champsim::address ip, bool cache_hit, bool useful_prefetch, access_type type,
                                               uint32_t metadata_in) const
 {
+  if (pf_trace.enabled()) {
+    champsim::prefetch_trace_record record;
+    record.cycle = static_cast<uint64_t>(current_time.time_since_epoch() / clock_period);
+    record.address = addr.to<uint64_t>();
+    record.ip = ip.to<uint64_t>();
+    record.metadata = metadata_in;
+    record.kind = champsim::prefetch_trace_record::CACHE_OPERATE;
+    record.type = static_cast<uint8_t>(champsim::to_underlying(type));
+    record.hit = cache_hit;
+    record.flag = useful_prefetch;
+    pf_trace.write(record);
+  }
+
   return pref_module_pimpl->impl_prefetcher_cache_operate(addr, ip, cache_hit, useful_prefetch, type, metadata_in);
 }
 
 uint32_t CACHE::impl_prefetcher_cache_fill(champsim::address addr, long set, long way, bool prefetch, champsim::address evicted_addr,
                                            uint32_t metadata_in) const
 {
+  if (pf_trace.enabled()) {
+    champsim::prefetch_trace_record record;
+    record.cycle = static_cast<uint64_t>(current_time.time_since_epoch() / clock_period);
+    record.address = addr.to<uint64_t>();
+    record.evicted_address = evicted_addr.to<uint64_t>();
+    record.metadata = metadata_in;
+    record.set = static_cast<uint32_t>(set);
+    record.way = static_cast<uint32_t>(way);
+    record.kind = champsim::prefetch_trace_record::CACHE_FILL;
+    record.flag = prefetch;
+    pf_trace.write(record);
+  }
+
   return pref_module_pimpl->impl_prefetcher_cache_fill(addr, set, way, prefetch, evicted_addr, metadata_in);
 }
 
@@ -843,6 +1311,30 @@ void CACHE::initialize()
   impl_initialize_replacement();
 }
 
+void CACHE::enable_profile(std::ostream& out, std::size_t top_ips) { profiler = champsim::cache_profiler{out, NUM_SET, top_ips}; }
+
+void CACHE::write_profile(std::string_view phase_name) const
+{
+  if (profiler.enabled()) {
+    profiler.write(NAME, phase_name);
+  }
+}
+
+void CACHE::enable_prefetch_trace(std::ostream& out) { pf_trace = champsim::prefetch_trace_writer{out}; }
+
+std::vector<champsim::address> CACHE::drain_prefetch_queue()
+{
+  std::vector<champsim::address> drained;
+  do {
+    issue_prefetch_candidates();
+    std::transform(std::cbegin(internal_PQ), std::cend(internal_PQ), std::back_inserter(drained),
+                   [](const auto& entry) { return entry.address; });
+    internal_PQ.clear();
+  } while (!prefetch_candidates.empty() && PQ_SIZE > 0);
+
+  return drained;
+}
+
 void CACHE::begin_phase()
 {
   stats_type new_roi_stats;
@@ -851,9 +1343,18 @@ void CACHE::begin_phase()
   new_roi_stats.name = NAME;
   new_sim_stats.name = NAME;
 
+  const auto sampled_sets = set_sampling.enabled() ? set_sampling.num_sampled() : NUM_SET;
+  new_roi_stats.sets = new_sim_stats.sets = NUM_SET;
+  new_roi_stats.sampled_sets = new_sim_stats.sampled_sets = sampled_sets;
+
   roi_stats = new_roi_stats;
   sim_stats = new_sim_stats;
 
+  if (profiler.enabled()) {
+    profiler.clear();
+  }
+  throttle.restart_totals();
+
   for (auto* ul : upper_levels) {
     channel_type::stats_type ul_new_roi_stats;
     channel_type::stats_type ul_new_sim_stats;
@@ -871,12 +1372,37 @@ void CACHE::end_phase(unsigned finished_cpu)
   roi_stats.misses = sim_stats.misses;
   roi_stats.mshr_merge = sim_stats.mshr_merge;
   roi_stats.mshr_return = sim_stats.mshr_return;
+  roi_stats.sampled_hits = sim_stats.sampled_hits;
+  roi_stats.sampled_misses = sim_stats.sampled_misses;
+  roi_stats.back_invalidations = sim_stats.back_invalidations;
+  roi_stats.inclusion_victims = sim_stats.inclusion_victims;
 
   roi_stats.pf_requested = sim_stats.pf_requested;
   roi_stats.pf_issued = sim_stats.pf_issued;
   roi_stats.pf_useful = sim_stats.pf_useful;
   roi_stats.pf_useless = sim_stats.pf_useless;
   roi_stats.pf_fill = sim_stats.pf_fill;
+  roi_stats.pf_late = sim_stats.pf_late;
+  roi_stats.pf_late_cycles_saved = sim_stats.pf_late_cycles_saved;
+  roi_stats.pf_late_cycles_lost = sim_stats.pf_late_cycles_lost;
+  roi_stats.pf_pollution = sim_stats.pf_pollution;
+  roi_stats.pf_throttled = sim_stats.pf_throttled;
+  roi_stats.pf_filtered = sim_stats.pf_filtered;
+  roi_stats.pf_candidates = sim_stats.pf_candidates;
+  roi_stats.pf_candidates_filtered = sim_stats.pf_candidates_filtered;
+  roi_stats.pf_candidates_dropped = sim_stats.pf_candidates_dropped;
+  roi_stats.pf_issued_by_metadata = sim_stats.pf_issued_by_metadata;
+  roi_stats.pf_useful_by_metadata = sim_stats.pf_useful_by_metadata;
+  roi_stats.pf_useless_by_metadata = sim_stats.pf_useless_by_metadata;
+  roi_stats.pf_late_by_metadata = sim_stats.pf_late_by_metadata;
+  roi_stats.pf_pollution_by_metadata = sim_stats.pf_pollution_by_metadata;
+  roi_stats.pf_issued_by_component = sim_stats.pf_issued_by_component;
+  roi_stats.pf_useful_by_component = sim_stats.pf_useful_by_component;
+  roi_stats.pf_useless_by_component = sim_stats.pf_useless_by_component;
+  roi_stats.pf_duplicate_by_component = sim_stats.pf_duplicate_by_component;
+  roi_stats.pf_over_quota_by_component = sim_stats.pf_over_quota_by_component;
+  roi_stats.way_allocation = sim_stats.way_allocation = partitioner.allocations();
+  roi_stats.repartitions = sim_stats.repartitions = partitioner.repartitions();
 
   for (auto* ul : upper_levels) {
     ul->roi_stats.RQ_ACCESS = ul->sim_stats.RQ_ACCESS;
@@ -0,0 +1,68 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "cache_profiler.h"
+
+#include <algorithm>
+#include <fmt/core.h>
+#include <fmt/ostream.h>
+
+champsim::cache_profiler::cache_profiler(std::ostream& stream, std::size_t num_sets, std::size_t top_ips)
+    : out(&stream), set_hits(num_sets), set_misses(num_sets), set_evictions(num_sets), load_miss_ips(top_ips)
+{
+}
+
+void champsim::cache_profiler::record_access(long set, champsim::address ip, access_type type, bool hit)
+{
+  const auto idx = static_cast<std::size_t>(set);
+  if (hit) {
+    ++set_hits.at(idx);
+  } else {
+    ++set_misses.at(idx);
+    if (type == access_type::LOAD) {
+      load_miss_ips.add(ip);
+    }
+  }
+}
+
+void champsim::cache_profiler::record_eviction(long set) { ++set_evictions.at(static_cast<std::size_t>(set)); }
+
+void champsim::cache_profiler::write(std::string_view cache_name, std::string_view phase_name) const
+{
+  fmt::print(*out, "# {} {}\n", phase_name, cache_name);
+  fmt::print(*out, "set hits misses evictions\n");
+  for (std::size_t set = 0; set < std::size(set_hits); ++set) {
+    if (set_hits[set] > 0 || set_misses[set] > 0 || set_evictions[set] > 0) {
+      fmt::print(*out, "{} {} {} {}\n", set, set_hits[set], set_misses[set], set_evictions[set]);
+    }
+  }
+
+  fmt::print(*out, "load_miss_ip misses error\n");
+  for (const auto& entry : load_miss_ips.top()) {
+    fmt::print(*out, "{:#x} {} {}\n", entry.key.to<uint64_t>(), entry.count, entry.error);
+  }
+  fmt::print(*out, "\n");
+  out->flush();
+}
+
+void champsim::cache_profiler::clear()
+{
+  std::fill(std::begin(set_hits), std::end(set_hits), 0);
+  std::fill(std::begin(set_misses), std::end(set_misses), 0);
+  std::fill(std::begin(set_evictions), std::end(set_evictions), 0);
+  load_miss_ips.clear();
+}
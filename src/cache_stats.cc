@@ -8,10 +8,38 @@ cache_stats operator-(cache_stats lhs, cache_stats rhs)
   result.pf_useful = lhs.pf_useful - rhs.pf_useful;
   result.pf_useless = lhs.pf_useless - rhs.pf_useless;
   result.pf_fill = lhs.pf_fill - rhs.pf_fill;
+  result.pf_late = lhs.pf_late - rhs.pf_late;
+  result.pf_late_cycles_saved = lhs.pf_late_cycles_saved - rhs.pf_late_cycles_saved;
+  result.pf_late_cycles_lost = lhs.pf_late_cycles_lost - rhs.pf_late_cycles_lost;
+  result.pf_pollution = lhs.pf_pollution - rhs.pf_pollution;
+  result.pf_throttled = lhs.pf_throttled - rhs.pf_throttled;
+  result.pf_filtered = lhs.pf_filtered - rhs.pf_filtered;
+  result.pf_candidates = lhs.pf_candidates - rhs.pf_candidates;
+  result.pf_candidates_filtered = lhs.pf_candidates_filtered - rhs.pf_candidates_filtered;
+  result.pf_candidates_dropped = lhs.pf_candidates_dropped - rhs.pf_candidates_dropped;
+  result.pf_issued_by_metadata = lhs.pf_issued_by_metadata - rhs.pf_issued_by_metadata;
+  result.pf_useful_by_metadata = lhs.pf_useful_by_metadata - rhs.pf_useful_by_metadata;
+  result.pf_useless_by_metadata = lhs.pf_useless_by_metadata - rhs.pf_useless_by_metadata;
+  result.pf_late_by_metadata = lhs.pf_late_by_metadata - rhs.pf_late_by_metadata;
+  result.pf_pollution_by_metadata = lhs.pf_pollution_by_metadata - rhs.pf_pollution_by_metadata;
+  result.pf_issued_by_component = lhs.pf_issued_by_component - rhs.pf_issued_by_component;
+  result.pf_useful_by_component = lhs.pf_useful_by_component - rhs.pf_useful_by_component;
+  result.pf_useless_by_component = lhs.pf_useless_by_component - rhs.pf_useless_by_component;
+  result.pf_duplicate_by_component = lhs.pf_duplicate_by_component - rhs.pf_duplicate_by_component;
+  result.pf_over_quota_by_component = lhs.pf_over_quota_by_component - rhs.pf_over_quota_by_component;
+  result.way_allocation = lhs.way_allocation;
+  result.repartitions = lhs.repartitions - rhs.repartitions;
+  result.back_invalidations = lhs.back_invalidations - rhs.back_invalidations;
+  result.inclusion_victims = lhs.inclusion_victims - rhs.inclusion_victims;
 
   result.hits = lhs.hits - rhs.hits;
   result.misses = lhs.misses - rhs.misses;
 
+  result.sets = lhs.sets;
+  result.sampled_sets = lhs.sampled_sets;
+  result.sampled_hits = lhs.sampled_hits - rhs.sampled_hits;
+  result.sampled_misses = lhs.sampled_misses - rhs.sampled_misses;
+
   result.total_miss_latency_cycles = lhs.total_miss_latency_cycles - rhs.total_miss_latency_cycles;
   return result;
 }
@@ -0,0 +1,205 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "cache_sweep.h"
+
+#include <algorithm>
+#include <cassert>
+#include <map>
+#include <numeric>
+#include <stdexcept>
+#include <fmt/core.h>
+
+#include "util/bits.h"
+#include "util/lru_table.h"
+
+namespace
+{
+// Sets are swept from NUM_SET/16 to NUM_SET*16, and ways from 1 to NUM_WAY*2
+constexpr std::size_t SWEEP_SET_FACTOR = 16;
+constexpr std::size_t SWEEP_WAY_FACTOR = 2;
+
+struct block_projection {
+  auto operator()(champsim::block_number block) const { return block.to<uint64_t>(); }
+};
+
+struct sweep_level {
+  champsim::stack_distance_profile profile;
+  champsim::lru_table<champsim::block_number, block_projection, block_projection> configured;
+  sweep_level* lower = nullptr;
+
+  explicit sweep_level(const CACHE& cache)
+      : profile(std::max(std::size_t{1}, cache.NUM_SET / SWEEP_SET_FACTOR), cache.NUM_SET * SWEEP_SET_FACTOR, cache.NUM_WAY * SWEEP_WAY_FACTOR),
+        configured(cache.NUM_SET, cache.NUM_WAY)
+  {
+  }
+
+  void access(champsim::block_number block)
+  {
+    profile.access(block);
+    if (!configured.check_hit(block).has_value()) {
+      configured.fill(block);
+      if (lower != nullptr) {
+        lower->access(block);
+      }
+    }
+  }
+};
+} // namespace
+
+champsim::stack_distance_profile::stack_distance_profile(std::size_t min_sets, std::size_t max_sets, std::size_t max_ways) : max_ways_(max_ways)
+{
+  assert(min_sets > 0 && (min_sets & (min_sets - 1)) == 0);
+  for (auto sets = min_sets; sets <= max_sets; sets *= 2) {
+    set_counts_.push_back(sets);
+    stacks_.emplace_back(sets * max_ways_, 0);
+    histogram_.emplace_back(max_ways_, 0);
+  }
+}
+
+void champsim::stack_distance_profile::access(champsim::block_number block)
+{
+  const auto tag = block.to<uint64_t>() + 1;
+  ++accesses_;
+
+  for (std::size_t i = 0; i < std::size(set_counts_); ++i) {
+    auto set_idx = static_cast<std::size_t>(block.to<uint64_t>() & (set_counts_[i] - 1));
+    auto set_begin = std::next(std::begin(stacks_[i]), static_cast<std::ptrdiff_t>(set_idx * max_ways_));
+    auto set_end = std::next(set_begin, static_cast<std::ptrdiff_t>(max_ways_));
+
+    auto found = std::find(set_begin, set_end, tag);
+    if (found != set_end) {
+      ++histogram_[i][static_cast<std::size_t>(std::distance(set_begin, found))];
+    } else {
+      found = std::prev(set_end); // the LRU entry falls out of the deepest tracked way
+    }
+
+    // Move to the top of the stack
+    std::rotate(set_begin, found, std::next(found));
+    *set_begin = tag;
+  }
+}
+
+void champsim::stack_distance_profile::clear_stats()
+{
+  accesses_ = 0;
+  for (auto& hist : histogram_) {
+    std::fill(std::begin(hist), std::end(hist), 0);
+  }
+}
+
+uint64_t champsim::stack_distance_profile::accesses() const { return accesses_; }
+
+uint64_t champsim::stack_distance_profile::misses(std::size_t sets, std::size_t ways) const
+{
+  auto set_it = std::find(std::begin(set_counts_), std::end(set_counts_), sets);
+  if (set_it == std::end(set_counts_)) {
+    throw std::out_of_range{"Set count was not profiled: " + std::to_string(sets)};
+  }
+  if (ways > max_ways_) {
+    throw std::out_of_range{"Way count was not profiled: " + std::to_string(ways)};
+  }
+
+  const auto& hist = histogram_.at(static_cast<std::size_t>(std::distance(std::begin(set_counts_), set_it)));
+  return accesses_ - std::accumulate(std::begin(hist), std::next(std::begin(hist), static_cast<std::ptrdiff_t>(ways)), uint64_t{0});
+}
+
+auto champsim::stack_distance_profile::set_counts() const -> const std::vector<std::size_t>& { return set_counts_; }
+
+std::size_t champsim::stack_distance_profile::max_ways() const { return max_ways_; }
+
+std::vector<champsim::miss_ratio_curve> champsim::cache_sweep_main(environment& env, std::vector<phase_info>& phases, std::vector<tracereader>& traces)
+{
+  auto caches = env.cache_view();
+  auto cpus = env.cpu_view();
+
+  auto find_below = [&caches](const champsim::channel* upper) -> CACHE* {
+    auto found = std::find_if(std::begin(caches), std::end(caches), [upper](const CACHE& cache) {
+      return std::find(std::begin(cache.upper_levels), std::end(cache.upper_levels), upper) != std::end(cache.upper_levels);
+    });
+    return found == std::end(caches) ? nullptr : &found->get();
+  };
+
+  // Follow each core's data path down to the last level, sharing the levels that are shared in the configuration
+  std::map<const CACHE*, sweep_level> levels;
+  std::vector<sweep_level*> first_level(std::size(cpus), nullptr);
+  for (std::size_t i = 0; i < std::size(cpus); ++i) {
+    sweep_level* upper = nullptr;
+    for (CACHE* cache = find_below(cpus.at(i).get().L1D_bus.lower()); cache != nullptr; cache = find_below(cache->lower_level)) {
+      auto& level = levels.try_emplace(cache, *cache).first->second;
+      if (upper == nullptr) {
+        first_level.at(i) = &level;
+      } else {
+        upper->lower = &level;
+      }
+      upper = &level;
+    }
+  }
+
+  for (const auto& phase : phases) {
+    // Interleave the cores one instruction at a time so that shared levels see a mixed stream
+    std::vector<long long> streamed(std::size(cpus), 0);
+    for (bool active = true; active;) {
+      active = false;
+      for (std::size_t i = 0; i < std::size(cpus); ++i) {
+        auto& trace = traces.at(phase.trace_index.at(cpus.at(i).get().cpu));
+        if (streamed.at(i) < phase.length && !trace.eof()) {
+          active = true;
+          ++streamed.at(i);
+
+          auto instr = trace();
+          if (first_level.at(i) != nullptr) {
+            for (auto addr : instr.source_memory) {
+              first_level.at(i)->access(champsim::block_number{addr});
+            }
+            for (auto addr : instr.destination_memory) {
+              first_level.at(i)->access(champsim::block_number{addr});
+            }
+          }
+        }
+      }
+    }
+
+    for (std::size_t i = 0; i < std::size(cpus); ++i) {
+      fmt::print("{} complete CPU {} instructions: {}\n", phase.name, cpus.at(i).get().cpu, streamed.at(i));
+    }
+
+    if (phase.is_warmup) {
+      for (auto& [cache, level] : levels) {
+        level.profile.clear_stats();
+      }
+    }
+  }
+
+  std::vector<miss_ratio_curve> curves;
+  for (const CACHE& cache : caches) {
+    if (auto level = levels.find(&cache); level != std::end(levels)) {
+      const auto& profile = level->second.profile;
+      miss_ratio_curve curve{cache.NAME, cache.NUM_SET, cache.NUM_WAY};
+      curve.sets = profile.set_counts();
+      curve.ways.resize(profile.max_ways());
+      std::iota(std::begin(curve.ways), std::end(curve.ways), 1);
+      curve.accesses = profile.accesses();
+      for (auto sets : curve.sets) {
+        auto& row = curve.misses.emplace_back();
+        std::transform(std::begin(curve.ways), std::end(curve.ways), std::back_inserter(row), [&profile, sets](auto ways) { return profile.misses(sets, ways); });
+      }
+      curves.push_back(curve);
+    }
+  }
+
+  return curves;
+}
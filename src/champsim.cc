@@ -156,6 +156,10 @@ phase_stats do_phase(const phase_info& phase, environment& env, std::vector<trac
                cpu.sim_instr(), cpu.sim_cycle(), std::ceil(cpu.sim_instr()) / std::ceil(cpu.sim_cycle()), elapsed_time());
   }
 
+  for (const CACHE& cache : env.cache_view()) {
+    cache.write_profile(phase_name);
+  }
+
   phase_stats stats;
   stats.name = phase.name;
 
@@ -180,6 +184,60 @@ phase_stats do_phase(const phase_info& phase, environment& env, std::vector<trac
   return stats;
 }
 
+phase_stats do_branch_phase(const phase_info& phase, environment& env, std::vector<tracereader>& traces)
+{
+  auto [phase_name, is_warmup, length, trace_index, trace_names] = phase;
+
+  for (O3_CPU& cpu : env.cpu_view()) {
+    cpu.warmup = is_warmup;
+    cpu.begin_phase();
+  }
+
+  // The predictors of each core are private, so each trace can be streamed to completion independently
+  for (O3_CPU& cpu : env.cpu_view()) {
+    auto& trace = traces.at(trace_index.at(cpu.cpu));
+    while (!trace.eof() && cpu.sim_instr() < length) {
+      auto instr = trace();
+      cpu.do_evaluate_branch(instr);
+    }
+
+    cpu.end_phase(cpu.cpu);
+
+    fmt::print("{} complete CPU {} instructions: {} (Simulation time: {:%H hr %M min %S sec})\n", phase_name, cpu.cpu, cpu.sim_instr(), elapsed_time());
+  }
+
+  phase_stats stats;
+  stats.name = phase.name;
+
+  for (std::size_t i = 0; i < std::size(trace_index); ++i) {
+    stats.trace_names.push_back(trace_names.at(trace_index.at(i)));
+  }
+
+  auto cpus = env.cpu_view();
+  std::transform(std::begin(cpus), std::end(cpus), std::back_inserter(stats.sim_cpu_stats), [](const O3_CPU& cpu) { return cpu.sim_stats; });
+  std::transform(std::begin(cpus), std::end(cpus), std::back_inserter(stats.roi_cpu_stats), [](const O3_CPU& cpu) { return cpu.roi_stats; });
+
+  return stats;
+}
+
+// branch-only entry point: drives the branch predictor and BTB of each core directly from the trace, without the timing model
+std::vector<phase_stats> branch_main(environment& env, std::vector<phase_info>& phases, std::vector<tracereader>& traces)
+{
+  for (O3_CPU& cpu : env.cpu_view()) {
+    cpu.initialize();
+  }
+
+  std::vector<phase_stats> results;
+  for (auto phase : phases) {
+    auto stats = do_branch_phase(phase, env, traces);
+    if (!phase.is_warmup) {
+      results.push_back(stats);
+    }
+  }
+
+  return results;
+}
+
 // simulation entry point
 std::vector<phase_stats> main(environment& env, std::vector<phase_info>& phases, std::vector<tracereader>& traces)
 {
@@ -27,57 +27,137 @@
 champsim::channel::channel(std::size_t rq_size, std::size_t pq_size, std::size_t wq_size, champsim::data::bits offset_bits, bool match_offset)
     : RQ_SIZE(rq_size), PQ_SIZE(pq_size), WQ_SIZE(wq_size), OFFSET_BITS(offset_bits), match_offset_bits(match_offset)
 {
+  // Bounded queues never need to allocate once the simulation starts
+  for (auto [queue, size] : {std::pair{&RQ, RQ_SIZE}, std::pair{&PQ, PQ_SIZE}, std::pair{&WQ, WQ_SIZE}}) {
+    if (size != std::numeric_limits<std::size_t>::max()) {
+      queue->reserve(size);
+    }
+  }
+}
+
+namespace
+{
+uint64_t index_key(champsim::address address, champsim::data::bits shamt) { return address.slice_upper(shamt).to<uint64_t>(); }
+} // namespace
+
+void champsim::channel::request_index::push_back(uint64_t key)
+{
+  order.push_back({next_sequence, key});
+  sequences_by_key.emplace(key, next_sequence);
+  ++next_sequence;
+}
+
+void champsim::channel::request_index::erase(std::size_t pos)
+{
+  auto erased = std::next(std::begin(order), static_cast<long>(pos));
+  auto [first, last] = sequences_by_key.equal_range(erased->key);
+  sequences_by_key.erase(std::find_if(first, last, [seq = erased->sequence](const auto& x) { return x.second == seq; }));
+  order.erase(erased);
 }
 
-template <typename Iter, typename F>
-bool do_collision_for(Iter begin, Iter end, champsim::channel::request_type& packet, champsim::data::bits shamt, F&& func)
+void champsim::channel::request_index::drop_front(std::size_t queue_size)
+{
+  while (std::size(order) > queue_size) {
+    erase(0);
+  }
+}
+
+void champsim::channel::request_index::clear()
+{
+  order.clear();
+  sequences_by_key.clear();
+}
+
+bool champsim::channel::request_index::matches_ends(uint64_t front_key, uint64_t back_key) const
+{
+  return !std::empty(order) && order.front().key == front_key && order.back().key == back_key;
+}
+
+std::optional<std::size_t> champsim::channel::request_index::find(uint64_t key) const
+{
+  auto [first, last] = sequences_by_key.equal_range(key);
+  if (first == last) {
+    return std::nullopt;
+  }
+
+  // The oldest request with this key is the one that a search from the front of the queue would find
+  auto oldest = std::min_element(first, last, [](const auto& lhs, const auto& rhs) { return lhs.second < rhs.second; })->second;
+  auto found = std::lower_bound(std::begin(order), std::end(order), oldest, [](const auto& x, uint64_t seq) { return x.sequence < seq; });
+  return static_cast<std::size_t>(std::distance(std::begin(order), found));
+}
+
+template <typename R>
+void champsim::channel::sync_index(const R& queue, request_index& index, champsim::data::bits shamt)
+{
+  // Forget the requests that were consumed from the front
+  index.drop_front(std::size(queue));
+
+  if (!std::empty(queue) && !index.matches_ends(::index_key(queue.front().address, shamt), ::index_key(queue.back().address, shamt))) {
+    index.clear();
+    for (const auto& pkt : queue) {
+      index.push_back(::index_key(pkt.address, shamt));
+    }
+  }
+}
+
+champsim::data::bits champsim::channel::read_shamt() const { return OFFSET_BITS; }
+
+champsim::data::bits champsim::channel::write_shamt() const { return match_offset_bits ? champsim::data::bits{} : OFFSET_BITS; }
+
+template <typename R, typename Index, typename F>
+bool do_collision_for(R& queue, const Index& index, std::size_t limit, champsim::channel::request_type& packet, champsim::data::bits shamt, F&& func)
 {
   // We make sure that both merge packet address have been translated. If
   // not this can happen: package with address virtual and physical X
   // (not translated) is inserted, package with physical address
   // (already translated) X.
-  if (auto found =
-          std::find_if(begin, end, [match = packet.address.slice_upper(shamt), shamt](const auto& x) { return x.address.slice_upper(shamt) == match; });
-      found != end && packet.is_translated == found->is_translated) {
-    func(packet, *found);
+  if (auto found = index.find(::index_key(packet.address, shamt));
+      found.has_value() && *found < limit && packet.is_translated == queue.at(*found).is_translated) {
+    func(packet, queue.at(*found));
     return true;
   }
 
   return false;
 }
 
-template <typename Iter>
-bool do_collision_for_merge(Iter begin, Iter end, champsim::channel::request_type& packet, champsim::data::bits shamt)
+template <typename R, typename Index>
+bool do_collision_for_merge(R& queue, const Index& index, std::size_t limit, champsim::channel::request_type& packet, champsim::data::bits shamt)
 {
-  return do_collision_for(begin, end, packet, shamt, [](champsim::channel::request_type& source, champsim::channel::request_type& destination) {
+  return do_collision_for(queue, index, limit, packet, shamt, [](champsim::channel::request_type& source, champsim::channel::request_type& destination) {
     destination.response_requested |= source.response_requested;
-    auto instr_copy = std::move(destination.instr_depend_on_me);
-
-    std::set_union(std::begin(instr_copy), std::end(instr_copy), std::begin(source.instr_depend_on_me), std::end(source.instr_depend_on_me),
-                   std::back_inserter(destination.instr_depend_on_me));
+    destination.clean = destination.clean && source.clean;
+    destination.instr_depend_on_me = champsim::shared_list<uint64_t>::set_union(destination.instr_depend_on_me, source.instr_depend_on_me);
   });
 }
 
-template <typename Iter>
-bool do_collision_for_return(Iter begin, Iter end, champsim::channel::request_type& packet, champsim::data::bits shamt,
-                             std::deque<champsim::channel::response_type>& returned)
+template <typename R, typename Index>
+bool do_collision_for_return(R& queue, const Index& index, champsim::channel::request_type& packet, champsim::data::bits shamt,
+                             champsim::ring_buffer<champsim::channel::response_type>& returned)
 {
-  return do_collision_for(begin, end, packet, shamt, [&](champsim::channel::request_type& source, champsim::channel::request_type& destination) {
+  auto forward = [&](champsim::channel::request_type& source, champsim::channel::request_type& destination) {
     if (source.response_requested) {
       returned.emplace_back(source.address, source.v_address, destination.data, destination.pf_metadata, source.instr_depend_on_me);
     }
-  });
+  };
+  return do_collision_for(queue, index, std::size(queue), packet, shamt, forward);
 }
 
 void champsim::channel::check_collision()
 {
-  auto write_shamt = match_offset_bits ? champsim::data::bits{} : OFFSET_BITS;
-  auto read_shamt = OFFSET_BITS;
+  // Forget the requests that were consumed since the last check
+  sync_index(RQ, RQ_index, read_shamt());
+  sync_index(PQ, PQ_index, read_shamt());
+  sync_index(WQ, WQ_index, write_shamt());
+
+  auto position = [](auto& queue, auto it) {
+    return static_cast<std::size_t>(std::distance(std::begin(queue), it));
+  };
 
   // Check WQ for duplicates, merging if they are found
   for (auto wq_it = std::find_if(std::begin(WQ), std::end(WQ), std::not_fn(&request_type::forward_checked)); wq_it != std::end(WQ);) {
-    if (do_collision_for_merge(std::begin(WQ), wq_it, *wq_it, write_shamt)) {
+    if (do_collision_for_merge(WQ, WQ_index, position(WQ, wq_it), *wq_it, write_shamt())) {
       sim_stats.WQ_MERGED++;
+      WQ_index.erase(position(WQ, wq_it));
       wq_it = WQ.erase(wq_it);
     } else {
       wq_it->forward_checked = true;
@@ -87,11 +167,13 @@ void champsim::channel::check_collision()
 
   // Check RQ for forwarding from WQ (return if found), then for duplicates (merge if found)
   for (auto rq_it = std::find_if(std::begin(RQ), std::end(RQ), std::not_fn(&request_type::forward_checked)); rq_it != std::end(RQ);) {
-    if (do_collision_for_return(std::begin(WQ), std::end(WQ), *rq_it, write_shamt, returned)) {
+    if (do_collision_for_return(WQ, WQ_index, *rq_it, write_shamt(), returned)) {
       sim_stats.WQ_FORWARD++;
+      RQ_index.erase(position(RQ, rq_it));
       rq_it = RQ.erase(rq_it);
-    } else if (do_collision_for_merge(std::begin(RQ), rq_it, *rq_it, read_shamt)) {
+    } else if (do_collision_for_merge(RQ, RQ_index, position(RQ, rq_it), *rq_it, read_shamt())) {
       sim_stats.RQ_MERGED++;
+      RQ_index.erase(position(RQ, rq_it));
       rq_it = RQ.erase(rq_it);
     } else {
       rq_it->forward_checked = true;
@@ -101,11 +183,13 @@ void champsim::channel::check_collision()
 
   // Check PQ for forwarding from WQ (return if found), then for duplicates (merge if found)
   for (auto pq_it = std::find_if(std::begin(PQ), std::end(PQ), std::not_fn(&request_type::forward_checked)); pq_it != std::end(PQ);) {
-    if (do_collision_for_return(std::begin(WQ), std::end(WQ), *pq_it, write_shamt, returned)) {
+    if (do_collision_for_return(WQ, WQ_index, *pq_it, write_shamt(), returned)) {
       sim_stats.WQ_FORWARD++;
+      PQ_index.erase(position(PQ, pq_it));
       pq_it = PQ.erase(pq_it);
-    } else if (do_collision_for_merge(std::begin(PQ), pq_it, *pq_it, read_shamt)) {
+    } else if (do_collision_for_merge(PQ, PQ_index, position(PQ, pq_it), *pq_it, read_shamt())) {
       sim_stats.PQ_MERGED++;
+      PQ_index.erase(position(PQ, pq_it));
       pq_it = PQ.erase(pq_it);
     } else {
       pq_it->forward_checked = true;
@@ -115,7 +199,8 @@ void champsim::channel::check_collision()
 }
 
 template <typename R>
-bool champsim::channel::do_add_queue(R& queue, std::size_t queue_size, const typename R::value_type& packet)
+bool champsim::channel::do_add_queue(R& queue, request_index& index, champsim::data::bits shamt, std::size_t queue_size,
+                                     const typename R::value_type& packet)
 {
   // check occupancy
   if (std::size(queue) >= queue_size) {
@@ -125,6 +210,8 @@ bool champsim::channel::do_add_queue(R& queue, std::size_t queue_size, const typ
   // Insert the packet ahead of the translation misses
   auto fwd_pkt = packet;
   fwd_pkt.forward_checked = false;
+  sync_index(queue, index, shamt);
+  index.push_back(::index_key(fwd_pkt.address, shamt));
   queue.push_back(fwd_pkt);
 
   return true;
@@ -139,7 +226,7 @@ bool champsim::channel::add_rq(const request_type& packet)
 
   sim_stats.RQ_ACCESS++;
 
-  auto result = do_add_queue(RQ, RQ_SIZE, packet);
+  auto result = do_add_queue(RQ, RQ_index, read_shamt(), RQ_SIZE, packet);
 
   if (result) {
     sim_stats.RQ_TO_CACHE++;
@@ -159,7 +246,7 @@ bool champsim::channel::add_wq(const request_type& packet)
 
   sim_stats.WQ_ACCESS++;
 
-  auto result = do_add_queue(WQ, WQ_SIZE, packet);
+  auto result = do_add_queue(WQ, WQ_index, write_shamt(), WQ_SIZE, packet);
 
   if (result) {
     sim_stats.WQ_TO_CACHE++;
@@ -180,7 +267,7 @@ bool champsim::channel::add_pq(const request_type& packet)
   sim_stats.PQ_ACCESS++;
 
   auto fwd_pkt = packet;
-  auto result = do_add_queue(PQ, PQ_SIZE, fwd_pkt);
+  auto result = do_add_queue(PQ, PQ_index, read_shamt(), PQ_SIZE, fwd_pkt);
   if (result) {
     sim_stats.PQ_TO_CACHE++;
   } else {
@@ -10,6 +10,7 @@ cpu_stats operator-(cpu_stats lhs, cpu_stats rhs)
 
   lhs.total_branch_types -= rhs.total_branch_types;
   lhs.branch_type_misses -= rhs.branch_type_misses;
+  lhs.cpi_stack -= rhs.cpi_stack;
 
   return lhs;
 }
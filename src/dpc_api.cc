@@ -0,0 +1,89 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "dpc_api.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "environment.h"
+
+namespace
+{
+struct dpc_api_state {
+  MEMORY_CONTROLLER* dram = nullptr;
+  std::vector<O3_CPU*> cpus{};
+  std::vector<CACHE*> llcs{};
+};
+
+dpc_api_state state{};
+} // namespace
+
+void champsim::attach_dpc_api(environment& env)
+{
+  state = dpc_api_state{};
+  state.dram = &env.dram_view();
+  for (O3_CPU& cpu : env.cpu_view())
+    state.cpus.push_back(&cpu);
+
+  // The last-level caches are those that send their misses to DRAM
+  const auto& dram_queues = state.dram->channels.front().upper_levels;
+  for (CACHE& cache : env.cache_view()) {
+    if (std::find(std::begin(dram_queues), std::end(dram_queues), cache.lower_level) != std::end(dram_queues))
+      state.llcs.push_back(&cache);
+  }
+}
+
+uint8_t get_dram_bw() { return state.dram == nullptr ? 0 : state.dram->get_bw(); }
+
+std::size_t get_dram_channels() { return state.dram == nullptr ? 0 : std::size(state.dram->channels); }
+
+uint8_t get_dram_read_bw(std::size_t channel) { return state.dram == nullptr ? 0 : state.dram->get_read_bw(channel); }
+
+uint8_t get_dram_write_bw(std::size_t channel) { return state.dram == nullptr ? 0 : state.dram->get_write_bw(channel); }
+
+uint8_t get_dram_core_share(uint32_t cpu) { return state.dram == nullptr ? 0 : state.dram->get_cpu_share(cpu); }
+
+uint64_t get_dram_queue_latency()
+{
+  if (state.dram == nullptr)
+    return 0;
+  return static_cast<uint64_t>(state.dram->get_queue_latency() / state.dram->clock_period);
+}
+
+uint8_t get_llc_mshr_occupancy()
+{
+  std::size_t occupancy = 0;
+  std::size_t size = 0;
+  for (const CACHE* llc : state.llcs) {
+    occupancy += llc->get_mshr_occupancy();
+    size += llc->get_mshr_size();
+  }
+  if (size == 0)
+    return 0;
+  return static_cast<uint8_t>(std::min<std::size_t>(occupancy * 16 / size, 15));
+}
+
+double get_core_ipc(uint32_t cpu)
+{
+  if (cpu >= std::size(state.cpus))
+    return 0;
+  auto cycles = state.cpus[cpu]->sim_cycle();
+  if (cycles <= 0)
+    return 0;
+  return static_cast<double>(state.cpus[cpu]->sim_instr()) / static_cast<double>(cycles);
+}
@@ -17,8 +17,11 @@
 #include "dram_controller.h"
 
 #include <algorithm>
+#include <cassert>
 #include <cfenv>
 #include <cmath>
+#include <functional>
+#include <memory>
 #include <fmt/core.h>
 
 #include "deadlock.h"
@@ -30,13 +33,19 @@
 MEMORY_CONTROLLER::MEMORY_CONTROLLER(champsim::chrono::picoseconds dbus_period, champsim::chrono::picoseconds mc_period, std::size_t t_rp, std::size_t t_rcd,
                                      std::size_t t_cas, std::size_t t_ras, champsim::chrono::microseconds refresh_period, std::vector<channel_type*>&& ul,
                                      std::size_t rq_size, std::size_t wq_size, std::size_t chans, champsim::data::bytes chan_width, std::size_t rows,
-                                     std::size_t columns, std::size_t ranks, std::size_t bankgroups, std::size_t banks, std::size_t refreshes_per_period)
+                                     std::size_t columns, std::size_t ranks, std::size_t bankgroups, std::size_t banks, std::size_t refreshes_per_period,
+                                     champsim::dram_scheduler sched)
     : champsim::operable(mc_period), queues(std::move(ul)), channel_width(chan_width),
-      address_mapping(chan_width, BLOCK_SIZE / chan_width.count(), chans, bankgroups, banks, columns, ranks, rows), data_bus_period(dbus_period)
+      address_mapping(chan_width, BLOCK_SIZE / chan_width.count(), chans, bankgroups, banks, columns, ranks, rows), data_bus_period(dbus_period),
+      bw_read_by_channel(chans), bw_write_by_channel(chans), bw_by_cpu(NUM_CPUS)
 {
+  assert(std::size(queues) <= std::numeric_limits<decltype(DRAM_CHANNEL::request_type::to_return)>::digits);
+
   for (std::size_t i{0}; i < chans; ++i) {
     channels.emplace_back(dbus_period, mc_period, t_rp, t_rcd, t_cas, t_ras, refresh_period, refreshes_per_period, chan_width, rq_size, wq_size,
                           address_mapping);
+    channels.back().upper_levels = queues;
+    channels.back().scheduler = sched;
   }
 }
 
@@ -57,6 +66,8 @@ DRAM_CHANNEL::DRAM_CHANNEL(champsim::chrono::picoseconds dbus_period, champsim::
   request_array_type br(address_mapping.ranks() * address_mapping.banks() * address_mapping.bankgroups());
   bank_request = br;
   active_request = std::end(bank_request);
+  RQ_banks.banks.resize(std::size(bank_request));
+  WQ_banks.banks.resize(std::size(bank_request));
   dq_payload_until = champsim::chrono::clock::time_point{}; // epoch => idle
 }
 
@@ -105,8 +116,18 @@ long MEMORY_CONTROLLER::operate()
   // Cross-channel step
   // Count how many channels are payload-active *this* cycle
   uint16_t active = 0;
-  for (auto& ch : channels)
-    active += (current_time < ch.dq_payload_until) ? (uint16_t)1 : (uint16_t)0;
+  for (std::size_t i = 0; i < std::size(channels); ++i) {
+    bool ch_active = current_time < channels[i].dq_payload_until;
+    if (ch_active)
+      ++active;
+    bw_read_by_channel[i].step((ch_active && !channels[i].dq_payload_write) ? (uint16_t)1 : (uint16_t)0);
+    bw_write_by_channel[i].step((ch_active && channels[i].dq_payload_write) ? (uint16_t)1 : (uint16_t)0);
+  }
+  for (uint32_t cpu = 0; cpu < std::size(bw_by_cpu); ++cpu) {
+    auto cpu_active = std::count_if(std::begin(channels), std::end(channels),
+                                    [cpu, now = current_time](const auto& ch) { return now < ch.dq_payload_until && ch.dq_payload_cpu == cpu; });
+    bw_by_cpu[cpu].step(static_cast<uint16_t>(cpu_active));
+  }
   bw_sys.step(active);
   bw_bucket16_sys = bw_sys.bucket16(static_cast<uint16_t>(channels.size()));
   operate_total++;
@@ -115,17 +136,40 @@ long MEMORY_CONTROLLER::operate()
   return progress;
 }
 
+uint8_t MEMORY_CONTROLLER::get_read_bw(std::size_t channel) const { return bw_read_by_channel.at(channel).bucket16(1); }
+
+uint8_t MEMORY_CONTROLLER::get_write_bw(std::size_t channel) const { return bw_write_by_channel.at(channel).bucket16(1); }
+
+uint8_t MEMORY_CONTROLLER::get_cpu_share(uint32_t cpu) const
+{
+  if (cpu >= std::size(bw_by_cpu) || bw_sys.sum_active == 0)
+    return 0;
+  return static_cast<uint8_t>(std::min<uint64_t>(uint64_t{bw_by_cpu[cpu].sum_active} * 16 / bw_sys.sum_active, 15));
+}
+
+champsim::chrono::clock::duration MEMORY_CONTROLLER::get_queue_latency() const
+{
+  champsim::chrono::clock::duration total{};
+  for (const auto& chan : channels)
+    total += chan.avg_queue_latency;
+  return total / static_cast<champsim::chrono::clock::rep>(std::size(channels));
+}
+
 long DRAM_CHANNEL::operate()
 {
   long progress{0};
 
+  // Nothing changes until the next event, except the passing of time
+  if (current_time < idle_until) {
+    scheduler.tick();
+    return idle_progress;
+  }
+
   if (warmup) {
     for (auto& entry : RQ) {
       if (entry.has_value()) {
         response_type response{entry->address, entry->v_address, entry->data, entry->pf_metadata, entry->instr_depend_on_me};
-        for (auto* ret : entry.value().to_return) {
-          ret->push_back(response);
-        }
+        champsim::for_each_set_bit(entry->to_return, [&](std::size_t i) { upper_levels.at(i)->returned.push_back(response); });
 
         ++progress;
         entry.reset();
@@ -138,8 +182,17 @@ long DRAM_CHANNEL::operate()
       }
       entry.reset();
     }
+
+    for (auto* index : {&RQ_banks, &WQ_banks}) {
+      for (auto& bank : index->banks) {
+        bank.clear();
+      }
+      index->occupancy = 0;
+    }
   }
 
+  scheduler.tick();
+
   check_write_collision();
   check_read_collision();
   progress += finish_dbus_request();
@@ -148,9 +201,36 @@ long DRAM_CHANNEL::operate()
   progress += populate_dbus();
   progress += service_packet(schedule_packet());
 
+  if (idle()) {
+    idle_until = next_event_time();
+    idle_progress = std::count_if(std::begin(bank_request), std::end(bank_request), [](const auto& b_req) { return b_req.under_refresh; });
+  }
+
   return progress;
 }
 
+bool DRAM_CHANNEL::idle() const
+{
+  // An empty write queue must also be below the high watermark, or the channel would switch to writes
+  const std::size_t DRAM_WRITE_HIGH_WM = ((std::size(WQ) * 7) >> 3);
+  return !write_mode && DRAM_WRITE_HIGH_WM > 0 && RQ_banks.occupancy == 0 && WQ_banks.occupancy == 0 && active_request == std::end(bank_request)
+         && std::none_of(std::begin(bank_request), std::end(bank_request), [](const auto& b_req) { return b_req.valid || b_req.need_refresh; });
+}
+
+champsim::chrono::clock::time_point DRAM_CHANNEL::next_event_time() const
+{
+  auto next_event = last_refresh + tREF;
+  if (active_request != std::end(bank_request)) {
+    next_event = std::min(next_event, active_request->ready_time);
+  }
+  for (const auto& b_req : bank_request) {
+    if (b_req.valid || b_req.under_refresh) {
+      next_event = std::min(next_event, b_req.ready_time);
+    }
+  }
+  return next_event;
+}
+
 long DRAM_CHANNEL::finish_dbus_request()
 {
   long progress{0};
@@ -158,12 +238,11 @@ long DRAM_CHANNEL::finish_dbus_request()
   if (active_request != std::end(bank_request) && active_request->ready_time <= current_time) {
     response_type response{active_request->pkt->value().address, active_request->pkt->value().v_address, active_request->pkt->value().data,
                            active_request->pkt->value().pf_metadata, active_request->pkt->value().instr_depend_on_me};
-    for (auto* ret : active_request->pkt->value().to_return) {
-      ret->push_back(response);
-    }
+    champsim::for_each_set_bit(active_request->pkt->value().to_return, [&](std::size_t i) { upper_levels.at(i)->returned.push_back(response); });
 
     active_request->valid = false;
 
+    dequeue(active_request->pkt);
     active_request->pkt->reset();
     active_request = std::end(bank_request);
     ++progress;
@@ -219,9 +298,9 @@ void DRAM_CHANNEL::swap_write_mode()
   const std::size_t DRAM_WRITE_LOW_WM = ((std::size(WQ) * 6) >> 3);  // 6/8th
   // const std::size_t MIN_DRAM_WRITES_PER_SWITCH = ((std::size(WQ) * 1) >> 2); // 1/4
 
-  // Check queue occupancy
-  auto wq_occu = static_cast<std::size_t>(std::count_if(std::begin(WQ), std::end(WQ), [](const auto& x) { return x.has_value(); }));
-  auto rq_occu = static_cast<std::size_t>(std::count_if(std::begin(RQ), std::end(RQ), [](const auto& x) { return x.has_value(); }));
+  // Check queue occupancy. Every request has passed the collision check by now, so each one is in its bank's queue.
+  auto wq_occu = WQ_banks.occupancy;
+  auto rq_occu = RQ_banks.occupancy;
 
   // Change modes if the queues are unbalanced
   if ((!write_mode && (wq_occu >= DRAM_WRITE_HIGH_WM || (rq_occu == 0 && wq_occu > 0)))
@@ -237,8 +316,10 @@ void DRAM_CHANNEL::swap_write_mode()
 
         // This bank is ready for another DRAM request
         it->valid = false;
+        dequeue(it->pkt);
         it->pkt->value().scheduled = false;
         it->pkt->value().ready_time = current_time;
+        enqueue(it->pkt);
       }
     }
 
@@ -276,6 +357,10 @@ long DRAM_CHANNEL::populate_dbus()
       // Data beats start when bankgroup is ready (may be >= current_time)
       auto xfer_start = std::max(current_time, bankgroup_ready_time);
       dq_payload_until = xfer_start + DRAM_DBUS_RETURN_TIME;
+      dq_payload_write = write_mode;
+      dq_payload_cpu = iter_next_process->pkt->value().cpu;
+      avg_queue_latency += ((xfer_start - iter_next_process->pkt->value().arrival_time) - avg_queue_latency) / 16;
+      scheduler.record_transfer(dq_payload_cpu, static_cast<double>(DRAM_DBUS_RETURN_TIME.count()) / static_cast<double>(clock_period.count()));
 
       // set return time. Incur penalty if bankgroup is on cooldown
       if (bankgroup_ready_time > current_time)
@@ -286,6 +371,16 @@ long DRAM_CHANNEL::populate_dbus()
       // set when bankgroup dbus will be next ready
       bankgroup_readytime[op_bankgroup] = current_time + DRAM_DBUS_RETURN_TIME + DRAM_DBUS_BANKGROUP_STALL;
 
+      if (dq_payload_cpu < NUM_CPUS) {
+        if (write_mode) {
+          sim_stats.writes_by_cpu.increment(dq_payload_cpu);
+        } else {
+          sim_stats.reads_by_cpu.increment(dq_payload_cpu);
+          auto latency = (active_request->ready_time - iter_next_process->pkt->value().arrival_time) / clock_period;
+          sim_stats.read_latency_by_cpu.set(dq_payload_cpu, sim_stats.read_latency_by_cpu.value_or(dq_payload_cpu, 0) + latency);
+        }
+      }
+
       if (iter_next_process->row_buffer_hit) {
         if (write_mode) {
           ++sim_stats.WQ_ROW_BUFFER_HIT;
@@ -328,40 +423,101 @@ std::size_t DRAM_CHANNEL::bankgroup_request_index(champsim::address addr) const
   return (op_rank * address_mapping.bankgroups() + op_bankgroup);
 }
 
+bool DRAM_CHANNEL::in_write_queue(queue_type::const_iterator pkt) const
+{
+  const auto* ptr = std::addressof(*pkt);
+  return !std::less<>{}(ptr, std::data(WQ)) && std::less<>{}(ptr, std::data(WQ) + std::size(WQ));
+}
+
+void DRAM_CHANNEL::enqueue(queue_type::iterator pkt)
+{
+  auto& queue = in_write_queue(pkt) ? WQ : RQ;
+  auto& index = in_write_queue(pkt) ? WQ_banks : RQ_banks;
+  auto slot = static_cast<std::size_t>(std::distance(std::begin(queue), pkt));
+  auto& bank = index.banks.at(pkt->value().bank);
+
+  auto fcfs_order = [&queue](std::size_t lhs, std::size_t rhs) {
+    return (queue[lhs]->ready_time == queue[rhs]->ready_time) ? lhs > rhs : queue[lhs]->ready_time < queue[rhs]->ready_time;
+  };
+  bank.insert(std::upper_bound(std::begin(bank), std::end(bank), slot, fcfs_order), slot);
+  ++index.occupancy;
+}
+
+void DRAM_CHANNEL::dequeue(queue_type::iterator pkt)
+{
+  if (!pkt->has_value()) {
+    return;
+  }
+
+  auto& queue = in_write_queue(pkt) ? WQ : RQ;
+  auto& index = in_write_queue(pkt) ? WQ_banks : RQ_banks;
+  auto slot = static_cast<std::size_t>(std::distance(std::begin(queue), pkt));
+  auto& bank = index.banks.at(pkt->value().bank);
+
+  if (auto found = std::find(std::begin(bank), std::end(bank), slot); found != std::end(bank)) {
+    bank.erase(found);
+    --index.occupancy;
+  }
+}
+
 // Look for queued packets that have not been scheduled
 DRAM_CHANNEL::queue_type::iterator DRAM_CHANNEL::schedule_packet()
 {
-  // Look for queued packets that have not been scheduled
+  auto& queue = write_mode ? WQ : RQ;
+  const auto& index = write_mode ? WQ_banks : RQ_banks;
+
   // prioritize packets that are ready to execute, bank is free
-  auto next_schedule = [this](const auto& lhs, const auto& rhs) {
-    if (!(rhs.has_value() && !rhs.value().scheduled)) {
-      return true;
+  // Among requests that are equally ready, those of the cores the scheduler ranks first go first, then the oldest
+  struct candidate {
+    bool ready;
+    unsigned rank;
+    champsim::chrono::clock::time_point ready_time;
+    std::size_t slot;
+  };
+  auto before = [](const candidate& lhs, const candidate& rhs) {
+    if (lhs.ready != rhs.ready) {
+      return lhs.ready;
     }
-    if (!(lhs.has_value() && !lhs.value().scheduled)) {
-      return false;
+    if (lhs.rank != rhs.rank) {
+      return lhs.rank < rhs.rank;
     }
-
-    auto lop_idx = this->bank_request_index(lhs.value().address);
-    auto rop_idx = this->bank_request_index(rhs.value().address);
-    auto rready = !this->bank_request[rop_idx].valid;
-    auto lready = !this->bank_request[lop_idx].valid;
-    return (rready == lready) ? lhs.value().ready_time <= rhs.value().ready_time : lready;
+    return (lhs.ready_time == rhs.ready_time) ? lhs.slot > rhs.slot : lhs.ready_time < rhs.ready_time;
   };
-  queue_type::iterator iter_next_schedule;
-  if (write_mode) {
-    iter_next_schedule = std::min_element(std::begin(WQ), std::end(WQ), next_schedule);
-  } else {
-    iter_next_schedule = std::min_element(std::begin(RQ), std::end(RQ), next_schedule);
+
+  // Each bank's queue is in FR-FCFS order, so the first unscheduled request of the lowest rank is the bank's best
+  std::optional<candidate> best;
+  for (std::size_t bank = 0; bank < std::size(index.banks) && index.occupancy > 0; ++bank) {
+    std::optional<candidate> head;
+    for (auto slot : index.banks[bank]) {
+      const auto& entry = queue[slot].value();
+      if (!entry.scheduled) {
+        candidate next{!bank_request[bank].valid, scheduler.rank(entry.cpu), entry.ready_time, slot};
+        if (!head.has_value() || next.rank < head->rank) {
+          head = next;
+        }
+        if (head->rank == 0) {
+          break;
+        }
+      }
+    }
+
+    if (head.has_value() && (!best.has_value() || before(*head, *best))) {
+      best = head;
+    }
   }
-  return (iter_next_schedule);
+
+  if (!best.has_value()) {
+    return std::end(queue);
+  }
+  return std::next(std::begin(queue), static_cast<queue_type::difference_type>(best->slot));
 }
 
 long DRAM_CHANNEL::service_packet(DRAM_CHANNEL::queue_type::iterator pkt)
 {
   long progress{0};
-  if (pkt->has_value() && pkt->value().ready_time <= current_time) {
-    auto op_row = address_mapping.get_row(pkt->value().address);
-    auto op_idx = bank_request_index(pkt->value().address);
+  if (pkt != std::end(write_mode ? WQ : RQ) && pkt->has_value() && pkt->value().ready_time <= current_time) {
+    auto op_row = pkt->value().row;
+    auto op_idx = pkt->value().bank;
 
     if (!bank_request[op_idx].valid && !bank_request[op_idx].under_refresh) {
       bool row_buffer_hit = (bank_request[op_idx].open_row.has_value() && *(bank_request[op_idx].open_row) == op_row);
@@ -371,8 +527,10 @@ long DRAM_CHANNEL::service_packet(DRAM_CHANNEL::queue_type::iterator pkt)
       bank_request[op_idx] = {true,  row_buffer_hit,        false,
                               false, std::optional{op_row}, current_time + tCAS + (row_buffer_hit ? champsim::chrono::clock::duration{} : row_charge_delay),
                               pkt};
+      dequeue(pkt);
       pkt->value().scheduled = true;
       pkt->value().ready_time = champsim::chrono::clock::time_point::max();
+      enqueue(pkt);
 
       ++progress;
     }
@@ -439,71 +597,86 @@ bool DRAM_ADDRESS_MAPPING::is_collision(champsim::address a, champsim::address b
 
 void DRAM_CHANNEL::check_write_collision()
 {
-  for (auto wq_it = std::begin(WQ); wq_it != std::end(WQ); ++wq_it) {
-    if (wq_it->has_value() && !wq_it->value().forward_checked) {
-      auto checker = [addr_map = address_mapping, check_val = wq_it->value().address](const auto& pkt) {
-        return pkt.has_value() && addr_map.is_collision(pkt.value().address, check_val);
-      };
+  // Find the requests that arrived since the last check
+  std::vector<std::size_t> arrivals;
+  for (std::size_t slot = 0; slot < std::size(WQ); ++slot) {
+    if (WQ[slot].has_value() && !WQ[slot]->forward_checked) {
+      WQ[slot]->bank = bank_request_index(WQ[slot]->address);
+      WQ[slot]->row = address_mapping.get_row(WQ[slot]->address);
+      arrivals.push_back(slot);
+    }
+  }
 
-      auto found = std::find_if(std::begin(WQ), wq_it, checker); // Forward check
-      if (found == wq_it) {
-        found = std::find_if(std::next(wq_it), std::end(WQ), checker); // Backward check
-      }
+  // Colliding requests share a bank, so only that bank's queue and the other arrivals are checked
+  for (auto arrival = std::begin(arrivals); arrival != std::end(arrivals); ++arrival) {
+    auto& entry = WQ[*arrival];
+    auto checker = [this, &entry](std::size_t slot) {
+      return WQ[slot].has_value() && WQ[slot]->bank == entry->bank && address_mapping.is_collision(WQ[slot]->address, entry->address);
+    };
 
-      if (found != std::end(WQ)) {
-        wq_it->reset();
-      } else {
-        wq_it->value().forward_checked = true;
-      }
+    const auto& queued = WQ_banks.banks[entry->bank];
+    if (std::any_of(std::begin(queued), std::end(queued), checker) || std::any_of(std::next(arrival), std::end(arrivals), checker)) {
+      entry.reset();
+    } else {
+      entry->forward_checked = true;
+      enqueue(std::next(std::begin(WQ), static_cast<queue_type::difference_type>(*arrival)));
     }
   }
 }
 
 void DRAM_CHANNEL::check_read_collision()
 {
-  for (auto rq_it = std::begin(RQ); rq_it != std::end(RQ); ++rq_it) {
-    if (rq_it->has_value() && !rq_it->value().forward_checked) {
-      auto checker = [addr_map = address_mapping, check_val = rq_it->value().address](const auto& x) {
-        return x.has_value() && addr_map.is_collision(x.value().address, check_val);
-      };
-      // write forward
-      if (auto wq_it = std::find_if(std::begin(WQ), std::end(WQ), checker); wq_it != std::end(WQ)) {
-        response_type response{rq_it->value().address, rq_it->value().v_address, wq_it->value().data, rq_it->value().pf_metadata,
-                               rq_it->value().instr_depend_on_me};
-        for (auto* ret : rq_it->value().to_return) {
-          ret->push_back(response);
-        }
-
-        rq_it->reset();
+  // Find the requests that arrived since the last check
+  std::vector<std::size_t> arrivals;
+  for (std::size_t slot = 0; slot < std::size(RQ); ++slot) {
+    if (RQ[slot].has_value() && !RQ[slot]->forward_checked) {
+      RQ[slot]->bank = bank_request_index(RQ[slot]->address);
+      RQ[slot]->row = address_mapping.get_row(RQ[slot]->address);
+      arrivals.push_back(slot);
+    }
+  }
 
-      }
-      // backwards check
-      else if (auto found = std::find_if(std::begin(RQ), rq_it, checker); found != rq_it) {
-        auto instr_copy = std::move(found->value().instr_depend_on_me);
-        auto ret_copy = std::move(found->value().to_return);
+  // Colliding requests share a bank, so only that bank's queues and the other arrivals are checked
+  for (auto arrival = std::begin(arrivals); arrival != std::end(arrivals); ++arrival) {
+    auto& entry = RQ[*arrival];
+    auto checker = [this, &entry](const queue_type& queue) {
+      return [this, &entry, &queue](std::size_t slot) {
+        return queue[slot].has_value() && queue[slot]->bank == entry->bank && address_mapping.is_collision(queue[slot]->address, entry->address);
+      };
+    };
 
-        std::set_union(std::begin(instr_copy), std::end(instr_copy), std::begin(rq_it->value().instr_depend_on_me), std::end(rq_it->value().instr_depend_on_me),
-                       std::back_inserter(found->value().instr_depend_on_me));
-        std::set_union(std::begin(ret_copy), std::end(ret_copy), std::begin(rq_it->value().to_return), std::end(rq_it->value().to_return),
-                       std::back_inserter(found->value().to_return));
+    // write forward
+    const auto& wq_queued = WQ_banks.banks[entry->bank];
+    if (auto wq_slot = std::find_if(std::begin(wq_queued), std::end(wq_queued), checker(WQ)); wq_slot != std::end(wq_queued)) {
+      response_type response{entry->address, entry->v_address, WQ[*wq_slot]->data, entry->pf_metadata, entry->instr_depend_on_me};
+      champsim::for_each_set_bit(entry->to_return, [&](std::size_t i) { upper_levels.at(i)->returned.push_back(response); });
 
-        rq_it->reset();
+      entry.reset();
+      continue;
+    }
 
+    // Merge into the first colliding request before this one (backwards check), or else the first after it (forwards check).
+    // The requests before this one have all been checked, so they are in the bank's queue.
+    std::optional<std::size_t> before;
+    std::optional<std::size_t> after;
+    for (auto slot : RQ_banks.banks[entry->bank]) {
+      if (checker(RQ)(slot)) {
+        auto& nearest = (slot < *arrival) ? before : after;
+        nearest = std::min(nearest.value_or(slot), slot);
       }
-      // forwards check
-      else if (found = std::find_if(std::next(rq_it), std::end(RQ), checker); found != std::end(RQ)) {
-        auto instr_copy = std::move(found->value().instr_depend_on_me);
-        auto ret_copy = std::move(found->value().to_return);
+    }
+    if (auto later = std::find_if(std::next(arrival), std::end(arrivals), checker(RQ)); later != std::end(arrivals)) {
+      after = std::min(after.value_or(*later), *later);
+    }
 
-        std::set_union(std::begin(instr_copy), std::end(instr_copy), std::begin(rq_it->value().instr_depend_on_me), std::end(rq_it->value().instr_depend_on_me),
-                       std::back_inserter(found->value().instr_depend_on_me));
-        std::set_union(std::begin(ret_copy), std::end(ret_copy), std::begin(rq_it->value().to_return), std::end(rq_it->value().to_return),
-                       std::back_inserter(found->value().to_return));
+    if (auto found = before.has_value() ? before : after; found.has_value()) {
+      RQ[*found]->instr_depend_on_me = champsim::shared_list<uint64_t>::set_union(RQ[*found]->instr_depend_on_me, entry->instr_depend_on_me);
+      RQ[*found]->to_return |= entry->to_return;
 
-        rq_it->reset();
-      } else {
-        rq_it->value().forward_checked = true;
-      }
+      entry.reset();
+    } else {
+      entry->forward_checked = true;
+      enqueue(std::next(std::begin(RQ), static_cast<queue_type::difference_type>(*arrival)));
     }
   }
 }
@@ -511,9 +684,11 @@ void DRAM_CHANNEL::check_read_collision()
 void MEMORY_CONTROLLER::initiate_requests()
 {
   // Initiate read requests
-  for (auto* ul : queues) {
+  for (std::size_t ul_index = 0; ul_index < std::size(queues); ++ul_index) {
+    auto* ul = queues[ul_index];
     for (auto q : {std::ref(ul->RQ), std::ref(ul->PQ)}) {
-      auto [begin, end] = champsim::get_span_p(std::cbegin(q.get()), std::cend(q.get()), [ul, this](const auto& pkt) { return this->add_rq(pkt, ul); });
+      auto [begin, end] =
+          champsim::get_span_p(std::cbegin(q.get()), std::cend(q.get()), [ul_index, this](const auto& pkt) { return this->add_rq(pkt, ul_index); });
       q.get().erase(begin, end);
     }
 
@@ -524,13 +699,13 @@ void MEMORY_CONTROLLER::initiate_requests()
 }
 
 DRAM_CHANNEL::request_type::request_type(const typename champsim::channel::request_type& req)
-    : pf_metadata(req.pf_metadata), address(req.address), v_address(req.address), data(req.data), instr_depend_on_me(req.instr_depend_on_me)
+    : pf_metadata(req.pf_metadata), cpu(req.cpu), address(req.address), v_address(req.address), data(req.data), instr_depend_on_me(req.instr_depend_on_me)
 {
   asid[0] = req.asid[0];
   asid[1] = req.asid[1];
 }
 
-bool MEMORY_CONTROLLER::add_rq(const request_type& packet, champsim::channel* ul)
+bool MEMORY_CONTROLLER::add_rq(const request_type& packet, std::size_t upper_level)
 {
   auto& channel = channels[address_mapping.get_channel(packet.address)];
 
@@ -540,8 +715,10 @@ bool MEMORY_CONTROLLER::add_rq(const request_type& packet, champsim::channel* ul
     rq_it->value().forward_checked = false;
     rq_it->value().scheduled = false;
     rq_it->value().ready_time = current_time;
+    rq_it->value().arrival_time = current_time;
     if (packet.response_requested)
-      rq_it->value().to_return = {&ul->returned};
+      rq_it->value().to_return = uint64_t{1} << upper_level;
+    channel.wake();
 
     return true;
   }
@@ -560,6 +737,8 @@ bool MEMORY_CONTROLLER::add_wq(const request_type& packet)
     wq_it->value().forward_checked = false;
     wq_it->value().scheduled = false;
     wq_it->value().ready_time = current_time;
+    wq_it->value().arrival_time = current_time;
+    channel.wake();
 
     return true;
   }
@@ -0,0 +1,96 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "dram_scheduler.h"
+
+#include <algorithm>
+#include <numeric>
+
+champsim::dram_scheduler::dram_scheduler(dram_scheduling_policy policy_, std::size_t cpus, double cap)
+    : policy(policy_), num_cpus(cpus), bandwidth_cap(cap), epoch_busy(cpus), blacklisted(cpus), attained_service(cpus), quantum_service(cpus),
+      ranks(cpus)
+{
+}
+
+void champsim::dram_scheduler::tick()
+{
+  ++cycle;
+
+  if (policy == dram_scheduling_policy::BANDWIDTH_CAP && cycle % cap_epoch == 0) {
+    std::fill(std::begin(epoch_busy), std::end(epoch_busy), 0.0);
+  }
+
+  if (policy == dram_scheduling_policy::BLISS && cycle % bliss_clear_interval == 0) {
+    std::fill(std::begin(blacklisted), std::end(blacklisted), false);
+  }
+
+  if (policy == dram_scheduling_policy::ATLAS && cycle % atlas_quantum == 0) {
+    for (std::size_t cpu = 0; cpu < num_cpus; ++cpu) {
+      attained_service[cpu] = atlas_history * attained_service[cpu] + (1 - atlas_history) * quantum_service[cpu];
+    }
+    std::fill(std::begin(quantum_service), std::end(quantum_service), 0.0);
+    rank_by_attained_service();
+  }
+}
+
+void champsim::dram_scheduler::rank_by_attained_service()
+{
+  std::vector<std::size_t> order(num_cpus);
+  std::iota(std::begin(order), std::end(order), std::size_t{0});
+  std::stable_sort(std::begin(order), std::end(order), [this](auto lhs, auto rhs) { return attained_service[lhs] < attained_service[rhs]; });
+  for (std::size_t position = 0; position < num_cpus; ++position) {
+    ranks[order[position]] = static_cast<unsigned>(position);
+  }
+}
+
+void champsim::dram_scheduler::record_transfer(uint32_t cpu, double busy_cycles)
+{
+  if (cpu >= num_cpus) {
+    return;
+  }
+
+  epoch_busy[cpu] += busy_cycles;
+  quantum_service[cpu] += busy_cycles;
+
+  if (cpu == last_cpu) {
+    ++streak;
+  } else {
+    last_cpu = cpu;
+    streak = 1;
+  }
+  if (streak >= bliss_streak) {
+    blacklisted[cpu] = true;
+  }
+}
+
+unsigned champsim::dram_scheduler::rank(uint32_t cpu) const
+{
+  if (cpu >= num_cpus) {
+    return 0;
+  }
+
+  switch (policy) {
+  case dram_scheduling_policy::BANDWIDTH_CAP:
+    return (epoch_busy[cpu] >= bandwidth_cap * static_cast<double>(cap_epoch)) ? 1 : 0;
+  case dram_scheduling_policy::BLISS:
+    return blacklisted[cpu] ? 1 : 0;
+  case dram_scheduling_policy::ATLAS:
+    return ranks[cpu];
+  default:
+    return 0;
+  }
+}
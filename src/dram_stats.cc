@@ -9,5 +9,8 @@ dram_stats operator-(dram_stats lhs, dram_stats rhs)
   lhs.RQ_ROW_BUFFER_HIT -= rhs.RQ_ROW_BUFFER_HIT;
   lhs.RQ_ROW_BUFFER_MISS -= rhs.RQ_ROW_BUFFER_MISS;
   lhs.WQ_FULL -= rhs.WQ_FULL;
+  lhs.reads_by_cpu -= rhs.reads_by_cpu;
+  lhs.writes_by_cpu -= rhs.writes_by_cpu;
+  lhs.read_latency_by_cpu -= rhs.read_latency_by_cpu;
   return lhs;
 }
@@ -15,6 +15,7 @@
  */
 
 #include <algorithm>
+#include <set>
 #include <utility>
 #include <nlohmann/json.hpp>
 
@@ -33,10 +34,16 @@ void to_json(nlohmann::json& j, const O3_CPU::stats_type& stats)
     mpki.emplace(branch_type_names.at(champsim::to_underlying(type)), stats.branch_type_misses.value_or(type, 0));
   }
 
+  std::map<std::string, long> cpi_stack{};
+  for (std::size_t idx = 0; idx < std::size(cpi_component_names); ++idx) {
+    cpi_stack.emplace(cpi_component_names.at(idx), stats.cpi_stack.value_or(static_cast<cpi_component>(idx), 0));
+  }
+
   j = nlohmann::json{{"instructions", stats.instrs()},
                      {"cycles", stats.cycles()},
                      {"Avg ROB occupancy at mispredict", std::ceil(stats.total_rob_occupancy_at_branch_mispredict) / std::ceil(total_mispredictions)},
-                     {"mispredict", mpki}};
+                     {"mispredict", mpki},
+                     {"CPI stack", cpi_stack}};
 }
 
 void to_json(nlohmann::json& j, const CACHE::stats_type& stats)
@@ -51,6 +58,17 @@ void to_json(nlohmann::json& j, const CACHE::stats_type& stats)
   statsmap.emplace("prefetch issued", stats.pf_issued);
   statsmap.emplace("useful prefetch", stats.pf_useful);
   statsmap.emplace("useless prefetch", stats.pf_useless);
+  statsmap.emplace("late prefetch", stats.pf_late);
+  statsmap.emplace("late prefetch cycles saved", stats.pf_late_cycles_saved);
+  statsmap.emplace("late prefetch cycles lost", stats.pf_late_cycles_lost);
+  statsmap.emplace("prefetch pollution", stats.pf_pollution);
+  statsmap.emplace("throttled prefetch", stats.pf_throttled);
+  statsmap.emplace("filtered prefetch", stats.pf_filtered);
+  statsmap.emplace("prefetch candidates", stats.pf_candidates);
+  statsmap.emplace("filtered prefetch candidates", stats.pf_candidates_filtered);
+  statsmap.emplace("dropped prefetch candidates", stats.pf_candidates_dropped);
+  statsmap.emplace("back invalidations", stats.back_invalidations);
+  statsmap.emplace("inclusion victims", stats.inclusion_victims);
 
   uint64_t total_downstream_demands = stats.mshr_return.total();
   for (std::size_t cpu = 0; cpu < NUM_CPUS; ++cpu)
@@ -68,7 +86,67 @@ void to_json(nlohmann::json& j, const CACHE::stats_type& stats)
       mshr_merges.push_back(stats.mshr_merge.value_or(std::pair{type, cpu}, mshr_merge_value_type{}));
     }
 
-    statsmap.emplace(access_type_names.at(champsim::to_underlying(type)), nlohmann::json{{"hit", hits}, {"miss", misses}, {"mshr_merge", mshr_merges}});
+    nlohmann::json type_stats{{"hit", hits}, {"miss", misses}, {"mshr_merge", mshr_merges}};
+    if (stats.sampled_sets < stats.sets) {
+      std::vector<hits_value_type> sampled_hits;
+      std::vector<misses_value_type> sampled_misses;
+      for (std::size_t cpu = 0; cpu < NUM_CPUS; ++cpu) {
+        sampled_hits.push_back(stats.sampled_hits.value_or(std::pair{type, cpu}, hits_value_type{}));
+        sampled_misses.push_back(stats.sampled_misses.value_or(std::pair{type, cpu}, misses_value_type{}));
+      }
+      type_stats["sampled hit"] = sampled_hits;
+      type_stats["sampled miss"] = sampled_misses;
+    }
+
+    statsmap.emplace(access_type_names.at(champsim::to_underlying(type)), type_stats);
+  }
+
+  if (stats.sampled_sets < stats.sets) {
+    statsmap.emplace("sampled sets", stats.sampled_sets);
+  }
+
+  if (!std::empty(stats.way_allocation)) {
+    statsmap.emplace("way allocation", stats.way_allocation);
+    statsmap.emplace("repartitions", stats.repartitions);
+  }
+
+  // Prefetches may be issued in one phase and used or evicted in the next, so every metadata seen in the phase is reported
+  std::set<uint32_t> metadata_seen;
+  for (const auto& counter : {stats.pf_issued_by_metadata, stats.pf_useful_by_metadata, stats.pf_useless_by_metadata, stats.pf_late_by_metadata,
+                              stats.pf_pollution_by_metadata}) {
+    auto keys = counter.get_keys();
+    metadata_seen.insert(std::begin(keys), std::end(keys));
+  }
+
+  std::map<std::string, nlohmann::json> by_metadata;
+  for (auto metadata : metadata_seen) {
+    by_metadata.emplace(std::to_string(metadata), nlohmann::json{{"issued", stats.pf_issued_by_metadata.value_or(metadata, 0)},
+                                                                 {"useful", stats.pf_useful_by_metadata.value_or(metadata, 0)},
+                                                                 {"useless", stats.pf_useless_by_metadata.value_or(metadata, 0)},
+                                                                 {"late", stats.pf_late_by_metadata.value_or(metadata, 0)},
+                                                                 {"pollution", stats.pf_pollution_by_metadata.value_or(metadata, 0)}});
+  }
+  if (!std::empty(by_metadata)) {
+    statsmap.emplace("prefetch by metadata", by_metadata);
+  }
+
+  std::set<std::size_t> components_seen;
+  for (const auto& counter : {stats.pf_issued_by_component, stats.pf_useful_by_component, stats.pf_useless_by_component,
+                              stats.pf_duplicate_by_component, stats.pf_over_quota_by_component}) {
+    auto keys = counter.get_keys();
+    components_seen.insert(std::begin(keys), std::end(keys));
+  }
+
+  std::map<std::string, nlohmann::json> by_component;
+  for (auto component : components_seen) {
+    by_component.emplace(std::to_string(component), nlohmann::json{{"issued", stats.pf_issued_by_component.value_or(component, 0)},
+                                                                   {"useful", stats.pf_useful_by_component.value_or(component, 0)},
+                                                                   {"useless", stats.pf_useless_by_component.value_or(component, 0)},
+                                                                   {"duplicate", stats.pf_duplicate_by_component.value_or(component, 0)},
+                                                                   {"over quota", stats.pf_over_quota_by_component.value_or(component, 0)}});
+  }
+  if (!std::empty(by_component)) {
+    statsmap.emplace("prefetch by component", by_component);
   }
 
   j = statsmap;
@@ -76,16 +154,50 @@ void to_json(nlohmann::json& j, const CACHE::stats_type& stats)
 
 void to_json(nlohmann::json& j, const DRAM_CHANNEL::stats_type stats)
 {
+  std::vector<long> reads;
+  std::vector<long> writes;
+  std::vector<double> read_latency;
+  for (uint32_t cpu = 0; cpu < NUM_CPUS; ++cpu) {
+    reads.push_back(stats.reads_by_cpu.value_or(cpu, 0));
+    writes.push_back(stats.writes_by_cpu.value_or(cpu, 0));
+    read_latency.push_back(std::ceil(stats.read_latency_by_cpu.value_or(cpu, 0)) / std::ceil(stats.reads_by_cpu.value_or(cpu, 0)));
+  }
+
   j = nlohmann::json{{"RQ ROW_BUFFER_HIT", stats.RQ_ROW_BUFFER_HIT},
                      {"RQ ROW_BUFFER_MISS", stats.RQ_ROW_BUFFER_MISS},
                      {"WQ ROW_BUFFER_HIT", stats.WQ_ROW_BUFFER_HIT},
                      {"WQ ROW_BUFFER_MISS", stats.WQ_ROW_BUFFER_MISS},
                      {"AVG DBUS CONGESTED CYCLE", (std::ceil(stats.dbus_cycle_congested) / std::ceil(stats.dbus_count_congested))},
-                     {"REFRESHES ISSUED", stats.refresh_cycles}};
+                     {"REFRESHES ISSUED", stats.refresh_cycles},
+                     {"READS", reads},
+                     {"WRITES", writes},
+                     {"AVG READ LATENCY", read_latency}};
 }
 
 namespace champsim
 {
+void to_json(nlohmann::json& j, const champsim::miss_ratio_curve& curve)
+{
+  j = nlohmann::json{{"name", curve.name},
+                     {"configured", {{"sets", curve.NUM_SET}, {"ways", curve.NUM_WAY}}},
+                     {"sets", curve.sets},
+                     {"ways", curve.ways},
+                     {"accesses", curve.accesses},
+                     {"misses", curve.misses}};
+}
+
+void to_json(nlohmann::json& j, const champsim::prefetch_replay_stats& stats)
+{
+  j = nlohmann::json{{"name", stats.name},
+                     {"records", stats.records},
+                     {"demand accesses", stats.demand_accesses},
+                     {"recorded misses", stats.demand_misses},
+                     {"issued", stats.issued},
+                     {"covered", stats.covered},
+                     {"late", stats.late},
+                     {"useless", stats.useless}};
+}
+
 void to_json(nlohmann::json& j, const champsim::phase_stats stats)
 {
   std::map<std::string, nlohmann::json> roi_stats;
@@ -110,3 +222,5 @@ void to_json(nlohmann::json& j, const champsim::phase_stats stats)
 } // namespace champsim
 
 void champsim::json_printer::print(std::vector<phase_stats>& stats) { stream << nlohmann::json::array_t{std::begin(stats), std::end(stats)}; }
+void champsim::json_printer::print(std::vector<miss_ratio_curve>& curves) { stream << nlohmann::json::array_t{std::begin(curves), std::end(curves)}; }
+void champsim::json_printer::print(const prefetch_replay_stats& stats) { stream << nlohmann::json(stats); }
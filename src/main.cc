@@ -23,6 +23,7 @@
 #include <fmt/core.h>
 
 #include "cache.h" // for CACHE
+#include "cache_sweep.h"
 #include "champsim.h"
 #ifndef CHAMPSIM_TEST_BUILD
 #include "core_inst.inc"
@@ -32,6 +33,7 @@
 #include "environment.h"
 #include "ooo_cpu.h" // for O3_CPU
 #include "phase_info.h"
+#include "prefetch_replay.h"
 #include "stats_printer.h"
 #include "tracereader.h"
 #include "vmem.h"
@@ -39,6 +41,7 @@
 namespace champsim
 {
 std::vector<phase_stats> main(environment& env, std::vector<phase_info>& phases, std::vector<tracereader>& traces);
+std::vector<phase_stats> branch_main(environment& env, std::vector<phase_info>& phases, std::vector<tracereader>& traces);
 }
 
 #ifndef CHAMPSIM_TEST_BUILD
@@ -52,16 +55,6 @@ const unsigned PAGE_SIZE = configured_environment::page_size;
 const unsigned LOG2_BLOCK_SIZE = champsim::lg2(BLOCK_SIZE);
 const unsigned LOG2_PAGE_SIZE = champsim::lg2(PAGE_SIZE);
 
-// Singleton environment pointer
-static configured_environment* g_env;
-
-// API
-uint8_t get_dram_bw()
-{
-  MEMORY_CONTROLLER& mc = g_env->dram_view();
-  return mc.get_bw();
-}
-
 #ifndef CHAMPSIM_TEST_BUILD
 int main(int argc, char** argv) // NOLINT(bugprone-exception-escape)
 {
@@ -70,16 +63,64 @@ int main(int argc, char** argv) // NOLINT(bugprone-exception-escape)
   CLI::App app{"A microarchitecture simulator for research and education"};
 
   bool knob_cloudsuite{false};
+  bool knob_classed{false};
   long long warmup_instructions = 0;
   long long simulation_instructions = std::numeric_limits<long long>::max();
   std::string json_file_name;
   std::vector<std::string> trace_names;
   bool hide_heartbeat{false};
+  bool branch_only{false};
+  bool cache_sweep{false};
   long long heartbeat_interval = 500000;
-
-  app.add_flag("-c,--cloudsuite", knob_cloudsuite, "Read all traces using the cloudsuite format");
+  std::string pipeline_trace_name;
+  uint64_t pipeline_trace_begin = 0;
+  uint64_t pipeline_trace_end = std::numeric_limits<uint64_t>::max();
+  uint64_t pipeline_trace_period = 1;
+  std::string cache_profile_name;
+  std::size_t cache_profile_top_ips = 16;
+  std::string prefetch_trace_name;
+  std::string prefetch_replay_name;
+  std::string prefetch_trace_cache = "cpu0_L2C";
+  uint64_t prefetch_replay_latency = 100;
+
+  auto* cloudsuite_option = app.add_flag("-c,--cloudsuite", knob_cloudsuite, "Read all traces using the cloudsuite format");
+  app.add_flag("--classed", knob_classed, "Read all traces using the format extended with instruction classes")->excludes(cloudsuite_option);
   app.add_flag("--hide-heartbeat", hide_heartbeat, "Hide the heartbeat output");
   app.add_option("--heartbeat-interval", heartbeat_interval, "The frequency of printing heartbeat");
+  auto* branch_only_option = app.add_flag("--branch-only", branch_only, "Evaluate only the branch predictor and BTB, without the timing model");
+  auto* cache_sweep_option = app.add_flag("--cache-sweep", cache_sweep, "Profile LRU miss ratios over a range of sets and ways for each data cache level, without the timing model")
+      ->excludes(branch_only_option);
+  auto* pipeline_trace_option =
+      app.add_option("--pipeline-trace", pipeline_trace_name,
+                     "The name of the file to receive an O3PipeView pipeline trace. With more than one core, the core index is appended.")
+          ->excludes(branch_only_option)
+          ->excludes(cache_sweep_option);
+  app.add_option("--pipeline-trace-begin", pipeline_trace_begin, "The ID of the first instruction in the pipeline trace")->needs(pipeline_trace_option);
+  app.add_option("--pipeline-trace-end", pipeline_trace_end, "The ID of the instruction after the last in the pipeline trace")->needs(pipeline_trace_option);
+  app.add_option("--pipeline-trace-period", pipeline_trace_period, "Trace one of every this many instructions")
+      ->needs(pipeline_trace_option)
+      ->check(CLI::PositiveNumber);
+  auto* cache_profile_option =
+      app.add_option("--cache-profile", cache_profile_name,
+                     "The name of the file to receive the hits, misses, and evictions of each cache set and the load instructions that miss most often")
+          ->excludes(branch_only_option)
+          ->excludes(cache_sweep_option);
+  app.add_option("--cache-profile-top", cache_profile_top_ips, "The number of load instructions to track in each cache profile")
+      ->needs(cache_profile_option)
+      ->check(CLI::PositiveNumber);
+  auto* prefetch_trace_option =
+      app.add_option("--prefetch-trace", prefetch_trace_name, "The name of the file to receive a binary record of the calls to the prefetcher of a cache")
+          ->excludes(branch_only_option)
+          ->excludes(cache_sweep_option);
+  auto* prefetch_replay_option = app.add_option("--prefetch-replay", prefetch_replay_name,
+                                                "Replay a recorded prefetcher trace through the prefetcher of a cache, without the timing model")
+                                     ->excludes(branch_only_option)
+                                     ->excludes(cache_sweep_option)
+                                     ->excludes(prefetch_trace_option)
+                                     ->check(CLI::ExistingFile);
+  app.add_option("--prefetch-trace-cache", prefetch_trace_cache, "The name of the cache whose prefetcher is recorded or replayed");
+  app.add_option("--prefetch-replay-latency", prefetch_replay_latency, "The number of cycles after which a replayed prefetch arrives")
+      ->needs(prefetch_replay_option);
   auto* warmup_instr_option = app.add_option("-w,--warmup-instructions", warmup_instructions, "The number of instructions in the warmup phase");
   auto* deprec_warmup_instr_option =
       app.add_option("--warmup_instructions", warmup_instructions, "[deprecated] use --warmup-instructions instead")->excludes(warmup_instr_option);
@@ -91,17 +132,79 @@ int main(int argc, char** argv) // NOLINT(bugprone-exception-escape)
   auto* json_option =
       app.add_option("--json", json_file_name, "The name of the file to receive JSON output. If no name is specified, stdout will be used")->expected(0, 1);
 
-  app.add_option("traces", trace_names, "The paths to the traces")->required()->expected(NUM_CPUS)->check(CLI::ExistingFile);
+  auto* traces_option = app.add_option("traces", trace_names, "The paths to the traces")->expected(NUM_CPUS)->check(CLI::ExistingFile);
 
   CLI11_PARSE(app, argc, argv);
 
-  g_env = &gen_environment;
+  // The traces are required, except to replay a prefetcher trace
+  if (prefetch_replay_option->count() == 0 && traces_option->count() == 0) {
+    fmt::print(stderr, "traces is required\n");
+    return 1;
+  }
+
+  champsim::attach_dpc_api(gen_environment);
+
+  CACHE* prefetch_trace_target = nullptr;
+  if (prefetch_trace_option->count() > 0 || prefetch_replay_option->count() > 0) {
+    for (CACHE& cache : gen_environment.cache_view()) {
+      if (cache.NAME == prefetch_trace_cache) {
+        prefetch_trace_target = &cache;
+      }
+    }
+    if (prefetch_trace_target == nullptr) {
+      fmt::print(stderr, "No cache is named {}\n", prefetch_trace_cache);
+      return 1;
+    }
+  }
+
+  if (prefetch_replay_option->count() > 0) {
+    std::ifstream prefetch_replay_file{prefetch_replay_name, std::ios::binary};
+    prefetch_trace_target->initialize();
+    auto replay_stats = champsim::prefetch_replay_main(*prefetch_trace_target, prefetch_replay_file, prefetch_replay_latency);
+    prefetch_trace_target->impl_prefetcher_final_stats();
+
+    champsim::plain_printer{std::cout}.print(replay_stats);
+
+    if (json_option->count() > 0) {
+      if (json_file_name.empty()) {
+        champsim::json_printer{std::cout}.print(replay_stats);
+      } else {
+        std::ofstream json_file{json_file_name};
+        champsim::json_printer{json_file}.print(replay_stats);
+      }
+    }
+
+    return 0;
+  }
 
   for (O3_CPU& cpu : gen_environment.cpu_view()) {
     cpu.show_heartbeat = hide_heartbeat ? false : true;
     cpu.heartbeat_interval = heartbeat_interval;
   }
 
+  std::vector<std::ofstream> pipeline_trace_files;
+  if (pipeline_trace_option->count() > 0) {
+    pipeline_trace_files.reserve(std::size(gen_environment.cpu_view()));
+    for (O3_CPU& cpu : gen_environment.cpu_view()) {
+      auto name = (NUM_CPUS > 1) ? pipeline_trace_name + "." + std::to_string(cpu.cpu) : pipeline_trace_name;
+      cpu.enable_pipeline_trace(pipeline_trace_files.emplace_back(name), pipeline_trace_begin, pipeline_trace_end, pipeline_trace_period);
+    }
+  }
+
+  std::ofstream cache_profile_file;
+  if (cache_profile_option->count() > 0) {
+    cache_profile_file.open(cache_profile_name);
+    for (CACHE& cache : gen_environment.cache_view()) {
+      cache.enable_profile(cache_profile_file, cache_profile_top_ips);
+    }
+  }
+
+  std::ofstream prefetch_trace_file;
+  if (prefetch_trace_option->count() > 0) {
+    prefetch_trace_file.open(prefetch_trace_name, std::ios::binary);
+    prefetch_trace_target->enable_prefetch_trace(prefetch_trace_file);
+  }
+
   const bool warmup_given = (warmup_instr_option->count() > 0) || (deprec_warmup_instr_option->count() > 0);
   const bool simulation_given = (sim_instr_option->count() > 0) || (deprec_sim_instr_option->count() > 0);
 
@@ -122,7 +225,9 @@ int main(int argc, char** argv) // NOLINT(bugprone-exception-escape)
   std::vector<champsim::tracereader> traces;
   std::transform(
       std::begin(trace_names), std::end(trace_names), std::back_inserter(traces),
-      [knob_cloudsuite, repeat = simulation_given, i = uint8_t(0)](auto name) mutable { return get_tracereader(name, i++, knob_cloudsuite, repeat); });
+      [knob_cloudsuite, knob_classed, repeat = simulation_given, i = uint8_t(0)](auto name) mutable {
+        return knob_classed ? get_classed_tracereader(name, i++, repeat) : get_tracereader(name, i++, knob_cloudsuite, repeat);
+      });
 
   std::vector<champsim::phase_info> phases{
       {champsim::phase_info{"Warmup", true, warmup_instructions, std::vector<std::size_t>(std::size(trace_names), 0), trace_names},
@@ -135,18 +240,39 @@ int main(int argc, char** argv) // NOLINT(bugprone-exception-escape)
   fmt::print("\n*** ChampSim Multicore Out-of-Order Simulator ***\nWarmup Instructions: {}\nSimulation Instructions: {}\nNumber of CPUs: {}\nPage size: {}\n\n",
              phases.at(0).length, phases.at(1).length, std::size(gen_environment.cpu_view()), PAGE_SIZE);
 
-  auto phase_stats = champsim::main(gen_environment, phases, traces);
+  if (cache_sweep) {
+    auto curves = champsim::cache_sweep_main(gen_environment, phases, traces);
+
+    fmt::print("\nChampSim completed all CPUs\n\n");
+
+    champsim::plain_printer{std::cout}.print(curves);
+
+    if (json_option->count() > 0) {
+      if (json_file_name.empty()) {
+        champsim::json_printer{std::cout}.print(curves);
+      } else {
+        std::ofstream json_file{json_file_name};
+        champsim::json_printer{json_file}.print(curves);
+      }
+    }
+
+    return 0;
+  }
+
+  auto phase_stats = branch_only ? champsim::branch_main(gen_environment, phases, traces) : champsim::main(gen_environment, phases, traces);
 
   fmt::print("\nChampSim completed all CPUs\n\n");
 
   champsim::plain_printer{std::cout}.print(phase_stats);
 
-  for (CACHE& cache : gen_environment.cache_view()) {
-    cache.impl_prefetcher_final_stats();
-  }
+  if (!branch_only) {
+    for (CACHE& cache : gen_environment.cache_view()) {
+      cache.impl_prefetcher_final_stats();
+    }
 
-  for (CACHE& cache : gen_environment.cache_view()) {
-    cache.impl_replacement_final_stats();
+    for (CACHE& cache : gen_environment.cache_view()) {
+      cache.impl_replacement_final_stats();
+    }
   }
 
   if (json_option->count() > 0) {
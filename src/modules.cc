@@ -23,6 +23,12 @@ bool champsim::modules::prefetcher::prefetch_line(champsim::address pf_addr, boo
   return intern_->prefetch_line(pf_addr, fill_this_level, prefetch_metadata);
 }
 
+bool champsim::modules::prefetcher::push_prefetch_candidate(champsim::address pf_addr, bool fill_this_level, uint32_t prefetch_metadata,
+                                                          uint32_t priority) const
+{
+  return intern_->push_prefetch_candidate(pf_addr, fill_this_level, prefetch_metadata, priority);
+}
+
 // LCOV_EXCL_START Exclude deprecated function
 bool champsim::modules::prefetcher::prefetch_line(uint64_t pf_addr, bool fill_this_level, uint32_t prefetch_metadata) const
 {
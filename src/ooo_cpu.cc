@@ -34,12 +34,17 @@ std::chrono::seconds elapsed_time();
 
 long O3_CPU::operate()
 {
-  long progress{0};
-  progress += retire_rob();                    // retire
+  const auto retire_count = retire_rob(); // retire
+
+  long progress{retire_count};
   progress += complete_inflight_instruction(); // finalize execution
   progress += execute_instruction();           // execute instructions
   progress += schedule_instruction();          // schedule instructions
-  progress += handle_memory_return();          // finalize memory transactions
+
+  // Attribute the cycle once scheduling has found whether the register file is full
+  record_cpi_component(retire_count);
+
+  progress += handle_memory_return(); // finalize memory transactions
   progress += operate_lsq();                   // execute memory transactions
 
   progress += dispatch_instruction(); // dispatch
@@ -87,10 +92,19 @@ void O3_CPU::begin_phase()
   stats.begin_instrs = num_retired;
   stats.begin_cycles = begin_phase_time.time_since_epoch() / clock_period;
   sim_stats = stats;
+
+  pending_memory_stall_cycles = 0;
 }
 
 void O3_CPU::end_phase(unsigned finished_cpu)
 {
+  // The load at the ROB head has not returned, so the level it waits on is not known. A load that is still in flight when the phase ends is
+  // most likely a long-latency miss, so its cycles are charged to DRAM. This keeps the CPI stack summing to the cycles of the phase.
+  if (pending_memory_stall_cycles > 0) {
+    sim_stats.cpi_stack.set(cpi_component::DRAM_BOUND, sim_stats.cpi_stack.value_or(cpi_component::DRAM_BOUND, 0) + pending_memory_stall_cycles);
+    pending_memory_stall_cycles = 0;
+  }
+
   // Record where the phase ended (overwrite if this is later)
   sim_stats.end_instrs = num_retired;
   sim_stats.end_cycles = current_time.time_since_epoch() / clock_period;
@@ -119,6 +133,9 @@ void O3_CPU::initialize_instruction()
     input_queue.pop_front();
 
     IFETCH_BUFFER.back().ready_time = current_time;
+    if (pipeline_trace.tracks(IFETCH_BUFFER.back().instr_id)) {
+      pipeline_trace.begin(IFETCH_BUFFER.back().instr_id, IFETCH_BUFFER.back().ip, current_time);
+    }
   }
 }
 
@@ -143,6 +160,13 @@ void do_stack_pointer_folding(ooo_model_instr& arch_instr)
     }
   }
 }
+
+bool is_branch_mispredicted(const ooo_model_instr& arch_instr, champsim::address predicted_branch_target)
+{
+  // conditional branches are re-evaluated at decode when the target is computed
+  return predicted_branch_target != arch_instr.branch_target
+         || (((arch_instr.branch == BRANCH_CONDITIONAL) || (arch_instr.branch == BRANCH_OTHER)) && arch_instr.branch_taken != arch_instr.branch_prediction);
+}
 } // namespace
 
 bool O3_CPU::do_predict_branch(ooo_model_instr& arch_instr)
@@ -165,9 +189,7 @@ bool O3_CPU::do_predict_branch(ooo_model_instr& arch_instr)
     // call code prefetcher every time the branch predictor is used
     l1i->impl_prefetcher_branch_operate(arch_instr.ip, arch_instr.branch, predicted_branch_target);
 
-    if (predicted_branch_target != arch_instr.branch_target
-        || (((arch_instr.branch == BRANCH_CONDITIONAL) || (arch_instr.branch == BRANCH_OTHER))
-            && arch_instr.branch_taken != arch_instr.branch_prediction)) { // conditional branches are re-evaluated at decode when the target is computed
+    if (::is_branch_mispredicted(arch_instr, predicted_branch_target)) {
       sim_stats.total_rob_occupancy_at_branch_mispredict += std::size(ROB);
       sim_stats.branch_type_misses.increment(arch_instr.branch);
       if (!warmup) {
@@ -186,6 +208,32 @@ bool O3_CPU::do_predict_branch(ooo_model_instr& arch_instr)
   return stop_fetch;
 }
 
+bool O3_CPU::do_evaluate_branch(ooo_model_instr& arch_instr)
+{
+  // Branch-only evaluation: the same prediction and update sequence as do_predict_branch(), without the timing model
+  ++num_retired;
+  sim_stats.total_branch_types.increment(arch_instr.branch);
+  auto [predicted_branch_target, always_taken] = impl_btb_prediction(arch_instr.ip, arch_instr.branch);
+  arch_instr.branch_prediction = impl_predict_branch(arch_instr.ip, predicted_branch_target, always_taken, arch_instr.branch) || always_taken;
+  if (!arch_instr.branch_prediction) {
+    predicted_branch_target = champsim::address{};
+  }
+
+  if (!arch_instr.is_branch) {
+    return false;
+  }
+
+  arch_instr.branch_mispredicted = ::is_branch_mispredicted(arch_instr, predicted_branch_target);
+  if (arch_instr.branch_mispredicted) {
+    sim_stats.branch_type_misses.increment(arch_instr.branch);
+  }
+
+  impl_update_btb(arch_instr.ip, arch_instr.branch_target, arch_instr.branch_taken, arch_instr.branch);
+  impl_last_branch_result(arch_instr.ip, arch_instr.branch_target, arch_instr.branch_taken, arch_instr.branch);
+
+  return arch_instr.branch_mispredicted;
+}
+
 bool O3_CPU::do_init_instruction(ooo_model_instr& arch_instr)
 {
   // fast warmup eliminates register dependencies between instructions branch predictor, cache contents, and prefetchers are still warmed up
@@ -271,7 +319,9 @@ bool O3_CPU::do_fetch_instruction(std::deque<ooo_model_instr>::iterator begin, s
   fetch_packet.instr_id = begin->instr_id;
   fetch_packet.ip = begin->ip;
 
-  std::transform(begin, end, std::back_inserter(fetch_packet.instr_depend_on_me), [](const auto& instr) { return instr.instr_id; });
+  std::vector<uint64_t> dependents;
+  std::transform(begin, end, std::back_inserter(dependents), [](const auto& instr) { return instr.instr_id; });
+  fetch_packet.instr_depend_on_me = std::move(dependents);
 
   if constexpr (champsim::debug_print) {
     fmt::print("[IFETCH] {} instr_id: {} ip: {} dependents: {} event_cycle: {}\n", __func__, begin->instr_id, begin->ip,
@@ -377,6 +427,7 @@ long O3_CPU::decode_instruction()
     }
     // Add to dispatch
     db_entry.ready_time = this->current_time + (this->warmup ? champsim::chrono::clock::duration{} : this->DISPATCH_LATENCY);
+    this->record_pipeline_stage(db_entry.instr_id, champsim::pipeline_tracer::stage::DECODE);
 
     if constexpr (champsim::debug_print) {
       fmt::print("[DECODE] do_decode instr_id: {} time: {}\n", db_entry.instr_id, this->current_time.time_since_epoch() / this->clock_period);
@@ -385,6 +436,7 @@ long O3_CPU::decode_instruction()
 
   auto do_dib_hit = [&, this](auto& dib_entry) {
     dib_entry.ready_time = this->current_time + (this->warmup ? champsim::chrono::clock::duration{} : this->DISPATCH_LATENCY);
+    this->record_pipeline_stage(dib_entry.instr_id, champsim::pipeline_tracer::stage::DECODE);
   };
 
   std::for_each(decode_buffer_begin, decode_buffer_end, do_decode);
@@ -418,6 +470,7 @@ long O3_CPU::dispatch_instruction()
 
     available_dispatch_bandwidth.consume();
     ROB.back().ready_time = current_time + (warmup ? champsim::chrono::clock::duration{} : SCHEDULING_LATENCY);
+    record_pipeline_stage(ROB.back().instr_id, champsim::pipeline_tracer::stage::DISPATCH);
   }
 
   return available_dispatch_bandwidth.amount_consumed();
@@ -427,11 +480,13 @@ long O3_CPU::schedule_instruction()
 {
   champsim::bandwidth search_bw{SCHEDULER_SIZE};
   int progress{0};
+  register_file_stall = false;
   for (auto rob_it = std::begin(ROB); rob_it != std::end(ROB) && search_bw.has_remaining(); ++rob_it) {
     // if there aren't enough physical registers available for the next instruction, stop scheduling
     unsigned long sources_to_allocate = std::count_if(rob_it->source_registers.begin(), rob_it->source_registers.end(),
                                                       [&alloc = std::as_const(reg_allocator)](auto srcreg) { return !alloc.isAllocated(srcreg); });
     if (reg_allocator.count_free_registers() < (sources_to_allocate + rob_it->destination_registers.size())) {
+      register_file_stall = true;
       break;
     }
     if (!rob_it->scheduled && rob_it->ready_time <= current_time) {
@@ -461,6 +516,7 @@ void O3_CPU::do_scheduling(ooo_model_instr& instr)
   }
 
   instr.scheduled = true;
+  record_pipeline_stage(instr.instr_id, champsim::pipeline_tracer::stage::SCHEDULE);
 }
 
 long O3_CPU::execute_instruction()
@@ -470,7 +526,7 @@ long O3_CPU::execute_instruction()
     if (rob_it->scheduled && !rob_it->executed && rob_it->ready_time <= current_time) {
       bool ready = std::all_of(std::begin(rob_it->source_registers), std::end(rob_it->source_registers),
                                [&alloc = std::as_const(reg_allocator)](auto srcreg) { return alloc.isValid(srcreg); });
-      if (ready) {
+      if (ready && functional_unit_available(*rob_it)) {
         do_execution(*rob_it);
         exec_bw.consume();
       }
@@ -480,22 +536,50 @@ long O3_CPU::execute_instruction()
   return exec_bw.amount_consumed();
 }
 
+auto O3_CPU::make_functional_units(const champsim::detail::core_builder_base& b) -> functional_unit_table
+{
+  functional_unit_table units;
+  for (std::size_t i = 0; i < std::size(units); ++i) {
+    // Unspecified classes behave as if every instruction had the generic latency and could use any execution port
+    auto spec = b.m_execute_classes.at(i).value_or(champsim::detail::execute_class_spec{b.m_execute_latency, b.m_execute_width, true});
+    auto latency = spec.latency * b.m_clock_period;
+    units.at(i).latency = latency;
+    units.at(i).occupancy = spec.pipelined ? champsim::chrono::clock::duration{b.m_clock_period} : latency;
+    units.at(i).busy_until.resize(static_cast<std::size_t>(champsim::to_underlying(spec.ports)));
+  }
+  return units;
+}
+
+bool O3_CPU::functional_unit_available(const ooo_model_instr& instr) const
+{
+  const auto& units = functional_units.at(champsim::to_underlying(instr.exec_class));
+  return std::any_of(std::begin(units.busy_until), std::end(units.busy_until), [time = current_time](auto busy) { return busy <= time; });
+}
+
 void O3_CPU::do_execution(ooo_model_instr& instr)
 {
+  auto& units = functional_units.at(champsim::to_underlying(instr.exec_class));
+  auto free_unit = std::find_if(std::begin(units.busy_until), std::end(units.busy_until), [time = current_time](auto busy) { return busy <= time; });
+  if (free_unit != std::end(units.busy_until)) {
+    *free_unit = current_time + (warmup ? champsim::chrono::clock::duration{} : units.occupancy);
+  }
+
+  const auto exec_latency = warmup ? champsim::chrono::clock::duration{} : units.latency;
   instr.executed = true;
-  instr.ready_time = current_time + (warmup ? champsim::chrono::clock::duration{} : EXEC_LATENCY);
+  instr.ready_time = current_time + exec_latency;
+  record_pipeline_stage(instr.instr_id, champsim::pipeline_tracer::stage::EXECUTE);
 
   // Mark LQ entries as ready to translate
   for (auto& lq_entry : LQ) {
     if (lq_entry.has_value() && lq_entry->instr_id == instr.instr_id) {
-      lq_entry->ready_time = current_time + (warmup ? champsim::chrono::clock::duration{} : EXEC_LATENCY);
+      lq_entry->ready_time = current_time + exec_latency;
     }
   }
 
   // Mark SQ entries as ready to translate
   for (auto& sq_entry : SQ) {
     if (sq_entry.instr_id == instr.instr_id) {
-      sq_entry.ready_time = current_time + (warmup ? champsim::chrono::clock::duration{} : EXEC_LATENCY);
+      sq_entry.ready_time = current_time + exec_latency;
     }
   }
 
@@ -575,6 +659,7 @@ long O3_CPU::operate_lsq()
       if (success) {
         load_bw.consume();
         lq_entry->fetch_issued = true;
+        record_pipeline_stage(lq_entry->instr_id, champsim::pipeline_tracer::stage::MEMORY_ISSUE);
       }
     }
   }
@@ -589,12 +674,14 @@ void O3_CPU::do_finish_store(const LSQ_ENTRY& sq_entry)
   }
 
   sq_entry.finish(std::begin(ROB), std::end(ROB));
+  record_pipeline_stage(sq_entry.instr_id, champsim::pipeline_tracer::stage::MEMORY_ISSUE);
 
   // Release dependent loads
   for (std::optional<LSQ_ENTRY>& dependent : sq_entry.lq_depend_on_me) {
     assert(dependent.has_value()); // LQ entry is still allocated
     assert(dependent->producer_id == sq_entry.instr_id);
 
+    record_pipeline_stage(dependent->instr_id, champsim::pipeline_tracer::stage::MEMORY_RETURN);
     dependent->finish(std::begin(ROB), std::end(ROB));
     dependent.reset();
   }
@@ -636,6 +723,7 @@ void O3_CPU::do_complete_execution(ooo_model_instr& instr)
   }
 
   instr.completed = true;
+  record_pipeline_stage(instr.instr_id, champsim::pipeline_tracer::stage::COMPLETE);
 
   if (instr.branch_mispredicted) {
     fetch_resume_time = current_time + BRANCH_MISPREDICT_PENALTY;
@@ -656,6 +744,15 @@ long O3_CPU::complete_inflight_instruction()
   return complete_bw.amount_consumed();
 }
 
+namespace
+{
+cpi_component memory_cpi_component(unsigned miss_levels)
+{
+  constexpr std::array components{cpi_component::L1D_BOUND, cpi_component::L2C_BOUND, cpi_component::LLC_BOUND, cpi_component::DRAM_BOUND};
+  return components.at(std::min<std::size_t>(miss_levels, std::size(components) - 1));
+}
+} // namespace
+
 long O3_CPU::handle_memory_return()
 {
   long progress{0};
@@ -676,7 +773,7 @@ long O3_CPU::handle_memory_return()
         }
       }
 
-      l1i_entry.instr_depend_on_me.erase(std::begin(l1i_entry.instr_depend_on_me));
+      l1i_entry.instr_depend_on_me.pop_front();
     }
 
     // remove this entry if we have serviced all of its instructions
@@ -690,6 +787,14 @@ long O3_CPU::handle_memory_return()
   for (champsim::bandwidth l1d_bw{L1D_BANDWIDTH}; l1d_bw.has_remaining() && l1d_it != std::end(L1D_bus.lower_level->returned); l1d_bw.consume(), ++l1d_it) {
     for (auto& lq_entry : LQ) {
       if (lq_entry.has_value() && lq_entry->fetch_issued && champsim::block_number{lq_entry->virtual_address} == champsim::block_number{l1d_it->v_address}) {
+        // The ROB head was waiting on this load, so the level that served it is now known
+        if (lq_entry->instr_id == ROB.front().instr_id && pending_memory_stall_cycles > 0) {
+          const auto component = ::memory_cpi_component(l1d_it->miss_levels);
+          sim_stats.cpi_stack.set(component, sim_stats.cpi_stack.value_or(component, 0) + pending_memory_stall_cycles);
+          pending_memory_stall_cycles = 0;
+        }
+
+        record_pipeline_stage(lq_entry->instr_id, champsim::pipeline_tracer::stage::MEMORY_RETURN);
         lq_entry->finish(std::begin(ROB), std::end(ROB));
         lq_entry.reset();
         ++progress;
@@ -719,6 +824,10 @@ long O3_CPU::retire_rob()
     for (auto dreg : rob_it->destination_registers) {
       reg_allocator.retire_dest_register(dreg);
     }
+
+    if (pipeline_trace.tracks(rob_it->instr_id)) {
+      pipeline_trace.retire(rob_it->instr_id, current_time);
+    }
   }
 
   auto retire_count = std::distance(retire_begin, retire_end);
@@ -728,6 +837,52 @@ long O3_CPU::retire_rob()
   return retire_count;
 }
 
+void O3_CPU::record_cpi_component(long retire_count)
+{
+  auto component = cpi_component::CORE_BOUND;
+  auto head_load_in_flight = [this](const auto& lq_entry) {
+    return lq_entry.has_value() && lq_entry->fetch_issued && lq_entry->instr_id == ROB.front().instr_id;
+  };
+  auto lq_free = [this]() {
+    return static_cast<std::size_t>(std::count_if(std::begin(LQ), std::end(LQ), [](const auto& lq_entry) { return !lq_entry.has_value(); }));
+  };
+
+  if (retire_count > 0) {
+    component = cpi_component::RETIRING;
+  } else if (!std::empty(ROB) && std::any_of(std::begin(LQ), std::end(LQ), head_load_in_flight)) {
+    // Which level this stall belongs to is not known until the load returns
+    ++pending_memory_stall_cycles;
+    return;
+  } else if (!std::empty(DISPATCH_BUFFER) && std::size(ROB) == ROB_SIZE) {
+    component = cpi_component::ROB_FULL;
+  } else if (!std::empty(DISPATCH_BUFFER) && lq_free() < std::size(DISPATCH_BUFFER.front().source_memory)) {
+    component = cpi_component::LQ_FULL;
+  } else if (!std::empty(DISPATCH_BUFFER) && (std::size(DISPATCH_BUFFER.front().destination_memory) + std::size(SQ)) > SQ_SIZE) {
+    component = cpi_component::SQ_FULL;
+  } else if (register_file_stall) {
+    component = cpi_component::REGISTERS_FULL;
+  } else if (std::empty(ROB)) {
+    const auto waiting_on_l1i = std::empty(DISPATCH_BUFFER) && std::empty(DECODE_BUFFER) && std::empty(DIB_HIT_BUFFER) && !std::empty(IFETCH_BUFFER)
+                                && IFETCH_BUFFER.front().fetch_issued && !IFETCH_BUFFER.front().fetch_completed;
+    if (current_time < fetch_resume_time) {
+      component = cpi_component::BRANCH_MISPREDICT;
+    } else if (waiting_on_l1i) {
+      component = cpi_component::ICACHE_MISS;
+    } else {
+      component = cpi_component::FRONTEND_STARVED;
+    }
+  }
+
+  sim_stats.cpi_stack.increment(component);
+}
+
+void O3_CPU::enable_pipeline_trace(std::ostream& out, uint64_t begin_id, uint64_t end_id, uint64_t period)
+{
+  // Every instruction between the oldest in the ROB and the youngest in the fetch buffer may be in flight
+  const auto in_flight = IFETCH_BUFFER_SIZE + DECODE_BUFFER_SIZE + DIB_HIT_BUFFER_SIZE + DISPATCH_BUFFER_SIZE + ROB_SIZE;
+  pipeline_trace = champsim::pipeline_tracer{out, begin_id, end_id, period, in_flight};
+}
+
 void O3_CPU::impl_initialize_branch_predictor() const { branch_module_pimpl->impl_initialize_branch_predictor(); }
 
 void O3_CPU::impl_last_branch_result(champsim::address ip, champsim::address target, bool taken, uint8_t branch_type) const
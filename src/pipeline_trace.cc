@@ -0,0 +1,81 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pipeline_trace.h"
+
+#include <stdexcept>
+#include <utility>
+#include <fmt/core.h>
+#include <fmt/ostream.h>
+
+#include "util/to_underlying.h"
+
+champsim::pipeline_tracer::pipeline_tracer(std::ostream& out_, uint64_t begin, uint64_t end, uint64_t period_, std::size_t capacity)
+    : out(&out_), begin_id(begin), end_id(end), period(period_), ring(capacity)
+{
+  if (period == 0) {
+    throw std::invalid_argument{"The pipeline trace period must be positive"};
+  }
+  if (capacity == 0) {
+    throw std::invalid_argument{"The pipeline trace must hold at least one instruction"};
+  }
+}
+
+void champsim::pipeline_tracer::begin(uint64_t instr_id, champsim::address ip, champsim::chrono::clock::time_point time)
+{
+  auto& entry = slot(instr_id);
+  entry = record{};
+  entry.instr_id = instr_id;
+  entry.ip = ip;
+  entry.times.at(champsim::to_underlying(stage::FETCH)) = time;
+}
+
+void champsim::pipeline_tracer::record_stage(uint64_t instr_id, stage which, champsim::chrono::clock::time_point time)
+{
+  auto& entry = slot(instr_id);
+  if (entry.instr_id == instr_id) {
+    entry.times.at(champsim::to_underlying(which)) = time;
+  }
+}
+
+void champsim::pipeline_tracer::retire(uint64_t instr_id, champsim::chrono::clock::time_point time)
+{
+  auto& entry = slot(instr_id);
+  if (entry.instr_id != instr_id) {
+    return;
+  }
+  entry.times.at(champsim::to_underlying(stage::RETIRE)) = time;
+
+  auto tick = [&entry](stage which) {
+    return entry.times.at(champsim::to_underlying(which)).time_since_epoch().count();
+  };
+
+  // O3PipeView has no memory stages, so they follow as extra lines that viewers skip
+  fmt::print(*out, "O3PipeView:fetch:{}:{:#x}:0:{}:\n", tick(stage::FETCH), entry.ip.to<uint64_t>(), entry.instr_id);
+  fmt::print(*out, "O3PipeView:decode:{}\n", tick(stage::DECODE));
+  fmt::print(*out, "O3PipeView:rename:{}\n", tick(stage::DISPATCH));
+  fmt::print(*out, "O3PipeView:dispatch:{}\n", tick(stage::SCHEDULE));
+  fmt::print(*out, "O3PipeView:issue:{}\n", tick(stage::EXECUTE));
+  fmt::print(*out, "O3PipeView:complete:{}\n", tick(stage::COMPLETE));
+  fmt::print(*out, "O3PipeView:retire:{}:store:0\n", tick(stage::RETIRE));
+  for (auto [which, name] : {std::pair{stage::MEMORY_ISSUE, "memory_issue"}, std::pair{stage::MEMORY_RETURN, "memory_return"}}) {
+    if (tick(which) != 0) {
+      fmt::print(*out, "O3PipeView:{}:{}\n", name, tick(which));
+    }
+  }
+
+  entry = record{};
+}
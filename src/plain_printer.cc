@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <cmath>
 #include <numeric>
 #include <ratio>
@@ -62,6 +63,12 @@ std::vector<std::string> champsim::plain_printer::format(O3_CPU::stats_type stat
                                 ::print_ratio(std::kilo::num * stats.branch_type_misses.value_or(idx, 0), stats.instrs())));
   }
 
+  lines.emplace_back("CPI stack");
+  for (std::size_t idx = 0; idx < std::size(cpi_component_names); ++idx) {
+    lines.push_back(
+        fmt::format("{}: {}", cpi_component_names.at(idx), ::print_ratio(stats.cpi_stack.value_or(static_cast<cpi_component>(idx), 0), stats.instrs())));
+  }
+
   return lines;
 }
 
@@ -119,9 +126,29 @@ std::vector<std::string> champsim::plain_printer::format(CACHE::stats_type stats
     lines.push_back(fmt::format("cpu{}->{} PREFETCH REQUESTED: {:10} ISSUED: {:10} USEFUL: {:10} USELESS: {:10}", cpu, stats.name, stats.pf_requested,
                                 stats.pf_issued, stats.pf_useful, stats.pf_useless));
 
+    if (stats.back_invalidations > 0 || stats.inclusion_victims > 0) {
+      lines.push_back(fmt::format("cpu{}->{} BACK INVALIDATIONS: {:10} INCLUSION VICTIMS: {:10}", cpu, stats.name, stats.back_invalidations,
+                                  stats.inclusion_victims));
+    }
+
+    if (cpu < std::size(stats.way_allocation)) {
+      lines.push_back(fmt::format("cpu{}->{} WAY ALLOCATION: {:3d} REPARTITIONS: {:10d}", cpu, stats.name, stats.way_allocation.at(cpu), stats.repartitions));
+    }
+
     uint64_t total_downstream_demands = total_mshr_return - stats.mshr_return.value_or(std::pair{access_type::PREFETCH, cpu}, mshr_return_value_type{});
     lines.push_back(
         fmt::format("cpu{}->{} AVERAGE MISS LATENCY: {} cycles", cpu, stats.name, ::print_ratio(stats.total_miss_latency_cycles, total_downstream_demands)));
+
+    if (stats.sampled_sets < stats.sets) {
+      hits_value_type sampled_hits = 0;
+      misses_value_type sampled_misses = 0;
+      for (const auto type : {access_type::LOAD, access_type::RFO, access_type::PREFETCH, access_type::WRITE, access_type::TRANSLATION}) {
+        sampled_hits += stats.sampled_hits.value_or(std::pair{type, cpu}, hits_value_type{});
+        sampled_misses += stats.sampled_misses.value_or(std::pair{type, cpu}, misses_value_type{});
+      }
+      lines.push_back(fmt::format("cpu{}->{} SAMPLED SETS: {:6d} OF {:6d} ACCESS: {:10d} HIT: {:10d} MISS: {:10d}", cpu, stats.name, stats.sampled_sets,
+                                  stats.sets, sampled_hits + sampled_misses, sampled_hits, sampled_misses));
+    }
   }
 
   return lines;
@@ -142,6 +169,22 @@ std::vector<std::string> champsim::plain_printer::format(DRAM_CHANNEL::stats_typ
   else
     lines.push_back(fmt::format("{} REFRESHES ISSUED: -", stats.name));
 
+  // The traffic of each core is shown only when the channel is shared
+  std::vector<uint32_t> cpus = stats.reads_by_cpu.get_keys();
+  for (auto cpu : stats.writes_by_cpu.get_keys()) {
+    if (std::find(std::begin(cpus), std::end(cpus), cpu) == std::end(cpus)) {
+      cpus.push_back(cpu);
+    }
+  }
+  std::sort(std::begin(cpus), std::end(cpus));
+  if (std::size(cpus) > 1) {
+    for (auto cpu : cpus) {
+      lines.push_back(fmt::format("{} cpu{} READS: {:10} WRITES: {:10} AVG READ LATENCY: {} cycles", stats.name, cpu, stats.reads_by_cpu.value_or(cpu, 0),
+                                  stats.writes_by_cpu.value_or(cpu, 0),
+                                  ::print_ratio(stats.read_latency_by_cpu.value_or(cpu, 0), stats.reads_by_cpu.value_or(cpu, 0))));
+    }
+  }
+
   return lines;
 }
 
@@ -210,3 +253,51 @@ void champsim::plain_printer::print(std::vector<phase_stats>& stats)
     print(p);
   }
 }
+
+std::vector<std::string> champsim::plain_printer::format(const champsim::miss_ratio_curve& curve)
+{
+  std::vector<std::string> lines{};
+  lines.push_back(fmt::format("{} MISS RATIO CURVE (configured SETS: {} WAYS: {}) ACCESSES: {}", curve.name, curve.NUM_SET, curve.NUM_WAY, curve.accesses));
+
+  std::string header = fmt::format("{} {:>8}", curve.name, "SETS");
+  for (auto ways : curve.ways) {
+    header += fmt::format(" {:>8}", ways);
+  }
+  lines.push_back(header);
+
+  for (std::size_t i = 0; i < std::size(curve.sets); ++i) {
+    std::string row = fmt::format("{} {:>8}", curve.name, curve.sets.at(i));
+    for (auto misses : curve.misses.at(i)) {
+      row += fmt::format(" {:>8}", ::print_ratio(misses, curve.accesses));
+    }
+    lines.push_back(row);
+  }
+
+  return lines;
+}
+
+std::vector<std::string> champsim::plain_printer::format(const champsim::prefetch_replay_stats& stats)
+{
+  std::vector<std::string> lines{};
+  lines.push_back(fmt::format("{} PREFETCH REPLAY RECORDS: {} DEMAND ACCESSES: {} RECORDED MISSES: {}", stats.name, stats.records, stats.demand_accesses,
+                              stats.demand_misses));
+  lines.push_back(fmt::format("{} PREFETCH ISSUED: {} COVERED: {} LATE: {} USELESS: {}", stats.name, stats.issued, stats.covered, stats.late, stats.useless));
+  lines.push_back(fmt::format("{} PREFETCH ACCURACY: {} COVERAGE: {}", stats.name, ::print_ratio(stats.covered + stats.late, stats.issued),
+                              ::print_ratio(stats.covered, stats.demand_misses)));
+  return lines;
+}
+
+void champsim::plain_printer::print(const champsim::prefetch_replay_stats& stats)
+{
+  auto lines = format(stats);
+  std::copy(std::begin(lines), std::end(lines), std::ostream_iterator<std::string>(stream, "\n"));
+}
+
+void champsim::plain_printer::print(std::vector<champsim::miss_ratio_curve>& curves)
+{
+  for (const auto& curve : curves) {
+    auto lines = format(curve);
+    lines.emplace_back("");
+    std::copy(std::begin(lines), std::end(lines), std::ostream_iterator<std::string>(stream, "\n"));
+  }
+}
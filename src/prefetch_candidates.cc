@@ -0,0 +1,53 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "prefetch_candidates.h"
+
+#include <algorithm>
+
+champsim::prefetch_candidate_queue::prefetch_candidate_queue(std::size_t capacity_) : capacity(std::max<std::size_t>(capacity_, 1)) {}
+
+auto champsim::prefetch_candidate_queue::push(candidate_type candidate) -> push_result
+{
+  auto by_priority = [](const candidate_type& lhs, const candidate_type& rhs) {
+    return lhs.priority > rhs.priority;
+  };
+
+  if (auto found = std::find_if(std::begin(entries), std::end(entries), [block = candidate.block](const auto& entry) { return entry.block == block; });
+      found != std::end(entries)) {
+    if (found->priority < candidate.priority) {
+      auto updated = *found;
+      updated.priority = candidate.priority;
+      entries.erase(found);
+      entries.insert(std::upper_bound(std::begin(entries), std::end(entries), updated, by_priority), updated);
+    }
+    return push_result::MERGED;
+  }
+
+  auto result = push_result::ADDED;
+  if (full()) {
+    if (entries.back().priority >= candidate.priority) {
+      return push_result::DROPPED;
+    }
+    entries.pop_back();
+    result = push_result::REPLACED;
+  }
+
+  entries.insert(std::upper_bound(std::begin(entries), std::end(entries), candidate, by_priority), candidate);
+  return result;
+}
+
+void champsim::prefetch_candidate_queue::pop_front() { entries.erase(std::begin(entries)); }
@@ -0,0 +1,74 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "prefetch_ensemble.h"
+
+#include <algorithm>
+#include <limits>
+
+champsim::prefetch_ensemble::prefetch_ensemble(std::size_t num_components) : components(num_components) {}
+
+double champsim::prefetch_ensemble::accuracy(std::size_t component) const
+{
+  const auto& counts = components.at(component);
+  return std::min(static_cast<double>(counts.useful + 1) / static_cast<double>(counts.issued + 2), 1.0);
+}
+
+std::size_t champsim::prefetch_ensemble::quota(std::size_t component, std::size_t pq_size) const
+{
+  double total = 0;
+  for (std::size_t i = 0; i < std::size(components); ++i) {
+    total += accuracy(i);
+  }
+  const auto share = static_cast<double>(pq_size) * accuracy(component) / total;
+  return std::max<std::size_t>(static_cast<std::size_t>(share), 1);
+}
+
+auto champsim::prefetch_ensemble::try_admit(std::size_t component, uint64_t block, std::size_t occupancy, std::size_t pq_size) -> admission
+{
+  if (!charges(component)) {
+    return admission::ADMIT;
+  }
+
+  if (auto found = recent.check_hit({block, component}); found.has_value() && found->component != component) {
+    return admission::DUPLICATE;
+  }
+
+  // An unbounded prefetch queue is not shared out
+  if (pq_size != std::numeric_limits<std::size_t>::max() && occupancy >= quota(component, pq_size)) {
+    return admission::OVER_QUOTA;
+  }
+
+  recent.fill({block, component});
+  ++components.at(component).issued;
+
+  if (++admitted_in_window >= window) {
+    for (auto& counts : components) {
+      counts.issued /= 2;
+      counts.useful /= 2;
+    }
+    admitted_in_window = 0;
+  }
+
+  return admission::ADMIT;
+}
+
+void champsim::prefetch_ensemble::record_useful(std::size_t component)
+{
+  if (component < std::size(components)) {
+    ++components[component].useful;
+  }
+}
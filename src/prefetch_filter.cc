@@ -0,0 +1,102 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "prefetch_filter.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "msl/bits.h"
+
+champsim::prefetch_filter::prefetch_filter(std::size_t num_counters)
+    : counters(champsim::msl::next_pow2(std::max<uint64_t>(num_counters, counters_per_block)))
+{
+}
+
+std::size_t champsim::prefetch_filter::index(uint64_t block, std::size_t hash) const
+{
+  // Each hash is a multiplicative hash with a different odd multiplier
+  constexpr uint64_t multipliers[num_hashes] = {0x9e3779b97f4a7c15ull, 0xc2b2ae3d27d4eb4full};
+  const auto mixed = block * multipliers[hash];
+  return static_cast<std::size_t>((mixed ^ (mixed >> 32)) & (std::size(counters) - 1));
+}
+
+void champsim::prefetch_filter::add(uint64_t block, int delta)
+{
+  for (std::size_t hash = 0; hash < num_hashes; ++hash) {
+    auto& counter = counters.at(index(block, hash));
+    // A saturated counter is never decremented, since it may count more blocks than it can hold
+    if (counter != std::numeric_limits<uint8_t>::max()) {
+      counter = static_cast<uint8_t>(counter + delta);
+    }
+  }
+}
+
+bool champsim::prefetch_filter::contains(uint64_t block) const
+{
+  if (!enabled()) {
+    return false;
+  }
+
+  for (std::size_t hash = 0; hash < num_hashes; ++hash) {
+    if (counters.at(index(block, hash)) == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void champsim::prefetch_filter::insert(uint64_t block)
+{
+  if (!enabled()) {
+    return;
+  }
+
+  auto is_current = [this](const auto& entry) {
+    auto found = newest.find(entry.first);
+    return found != std::end(newest) && found->second == entry.second;
+  };
+
+  // The entries of blocks erased or inserted again are left in place, and are removed together once the history is twice its capacity
+  if (std::size(history) >= 2 * capacity()) {
+    history.erase(std::remove_if(std::begin(history), std::end(history), [is_current](const auto& entry) { return !is_current(entry); }),
+                  std::end(history));
+  }
+
+  // Forget the oldest block, passing over the entries that are no longer current
+  while (std::size(newest) >= capacity() && newest.count(block) == 0) {
+    if (is_current(history.front())) {
+      newest.erase(history.front().first);
+      add(history.front().first, -1);
+    }
+    history.pop_front();
+  }
+
+  // A block remembered again is only made the newest
+  auto [found, added] = newest.insert_or_assign(block, ++insertions);
+  history.emplace_back(block, found->second);
+  if (added) {
+    add(block, 1);
+  }
+}
+
+void champsim::prefetch_filter::erase(uint64_t block)
+{
+  if (auto found = newest.find(block); found != std::end(newest)) {
+    newest.erase(found);
+    add(block, -1);
+  }
+}
@@ -0,0 +1,135 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "prefetch_replay.h"
+
+#include <deque>
+#include <unordered_map>
+
+#include "cache.h"
+#include "prefetch_trace.h"
+
+namespace
+{
+struct prefetched_type {
+  champsim::address address;
+  uint64_t ready_cycle;
+  uint64_t serial; // distinguishes a prefetch from a later prefetch of the same block
+};
+} // namespace
+
+champsim::prefetch_replay_stats champsim::prefetch_replay_main(CACHE& cache, std::istream& trace, uint64_t latency)
+{
+  prefetch_replay_stats stats;
+  stats.name = cache.NAME;
+
+  const auto capacity = std::max<std::size_t>(std::size_t{cache.NUM_SET} * cache.NUM_WAY, 1);
+  auto block_of = [offset = champsim::to_underlying(cache.OFFSET_BITS)](champsim::address addr) {
+    return addr.to<uint64_t>() >> offset;
+  };
+
+  std::unordered_map<uint64_t, prefetched_type> prefetched; // by block
+  std::deque<prefetched_type> issue_order;                  // the prefetches not yet displaced, oldest first
+  std::deque<prefetched_type> unfilled;                     // the prefetches not yet arrived, oldest first
+  uint64_t serial = 0;
+
+  auto is_current = [&prefetched, &block_of](const prefetched_type& entry) {
+    auto found = prefetched.find(block_of(entry.address));
+    return found != std::end(prefetched) && found->second.serial == entry.serial;
+  };
+
+  auto collect_prefetches = [&](uint64_t cycle) {
+    for (auto pf_addr : cache.drain_prefetch_queue()) {
+      const auto block = block_of(pf_addr);
+      if (prefetched.count(block) > 0) {
+        continue;
+      }
+
+      ++stats.issued;
+      prefetched_type entry{pf_addr, cycle + latency, serial++};
+      prefetched.emplace(block, entry);
+      issue_order.push_back(entry);
+      unfilled.push_back(entry);
+
+      // Displace the oldest prefetched block that is still held
+      while (std::size(prefetched) > capacity) {
+        if (is_current(issue_order.front())) {
+          prefetched.erase(block_of(issue_order.front().address));
+          ++stats.useless;
+        }
+        issue_order.pop_front();
+      }
+    }
+  };
+
+  auto arrive_until = [&](uint64_t cycle) {
+    while (!std::empty(unfilled) && unfilled.front().ready_cycle <= cycle) {
+      auto entry = unfilled.front();
+      unfilled.pop_front();
+      cache.current_time = champsim::chrono::clock::time_point{} + cache.clock_period * static_cast<long>(entry.ready_cycle);
+      const auto set = static_cast<long>(block_of(entry.address) & (cache.NUM_SET - 1));
+      cache.begin_prefetch_invocation();
+      [[maybe_unused]] auto metadata = cache.impl_prefetcher_cache_fill(entry.address, set, 0, true, champsim::address{}, 0);
+      collect_prefetches(entry.ready_cycle);
+    }
+  };
+
+  champsim::prefetch_trace_record record;
+  while (champsim::read_prefetch_trace(trace, record)) {
+    ++stats.records;
+    arrive_until(record.cycle);
+    cache.current_time = champsim::chrono::clock::time_point{} + cache.clock_period * static_cast<long>(record.cycle);
+
+    const champsim::address addr{record.address};
+    if (record.kind == champsim::prefetch_trace_record::CACHE_OPERATE) {
+      const auto type = static_cast<access_type>(record.type);
+      // A hit on a block that the recorded prefetcher brought in would have missed without it
+      bool hit = record.hit != 0 && record.flag == 0;
+      bool useful_prefetch = false;
+
+      if (type != access_type::PREFETCH && type != access_type::WRITE) {
+        ++stats.demand_accesses;
+        if (!hit) {
+          ++stats.demand_misses;
+          if (auto found = prefetched.find(block_of(addr)); found != std::end(prefetched)) {
+            if (found->second.ready_cycle <= record.cycle) {
+              ++stats.covered;
+              hit = true;
+              useful_prefetch = true;
+            } else {
+              ++stats.late;
+            }
+            prefetched.erase(found);
+          }
+        }
+      }
+
+      cache.begin_prefetch_invocation();
+      [[maybe_unused]] auto metadata = cache.impl_prefetcher_cache_operate(addr, champsim::address{record.ip}, hit, useful_prefetch, type, record.metadata);
+    } else if (record.flag == 0) {
+      cache.begin_prefetch_invocation();
+      [[maybe_unused]] auto metadata =
+          cache.impl_prefetcher_cache_fill(addr, record.set, record.way, false, champsim::address{record.evicted_address}, record.metadata);
+    }
+
+    cache.begin_prefetch_invocation();
+    cache.impl_prefetcher_cycle_operate();
+    collect_prefetches(record.cycle);
+  }
+
+  stats.useless += std::size(prefetched);
+  return stats;
+}
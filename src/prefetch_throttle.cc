@@ -0,0 +1,106 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "prefetch_throttle.h"
+
+#include <algorithm>
+
+champsim::prefetch_throttle::prefetch_throttle(uint64_t interval) : interval_fills(interval) {}
+
+bool champsim::prefetch_throttle::try_admit(std::size_t pq_occupancy, std::size_t pq_size)
+{
+  if (!enabled()) {
+    return true;
+  }
+
+  const auto& limits = levels.at(level);
+  if (admitted >= limits.degree) {
+    return false;
+  }
+
+  // An unbounded prefetch queue is limited only by the degree
+  if (pq_size != std::numeric_limits<std::size_t>::max() && pq_occupancy >= std::max<std::size_t>(pq_size * limits.pq_eighths / 8, 1)) {
+    return false;
+  }
+
+  ++admitted;
+  return true;
+}
+
+bool champsim::prefetch_throttle::count_fill()
+{
+  if (!enabled()) {
+    return false;
+  }
+
+  ++fills;
+  if (fills < interval_fills) {
+    return false;
+  }
+
+  fills = 0;
+  return true;
+}
+
+void champsim::prefetch_throttle::end_interval(const feedback_type& totals, uint8_t dram_bw)
+{
+  const auto issued = totals.issued - last.issued;
+  const auto useful = totals.useful - last.useful;
+  const auto late = totals.late - last.late;
+  const auto polluted = totals.pollution - last.pollution;
+  const auto demand_misses = totals.demand_misses - last.demand_misses;
+  last = totals;
+
+  // Each interval counts as much as all of the intervals before it
+  auto average = [](double previous, uint64_t num, uint64_t denom) {
+    return denom == 0 ? previous : (previous + static_cast<double>(num) / static_cast<double>(denom)) / 2;
+  };
+  accuracy = average(accuracy, useful, issued);
+  lateness = average(lateness, late, useful);
+  pollution = average(pollution, polluted, demand_misses);
+
+  const bool is_late = lateness > lateness_threshold;
+  const bool is_polluting = pollution > pollution_threshold;
+
+  int step = 0;
+  if (accuracy >= accuracy_high) {
+    if (is_late) {
+      step = 1;
+    } else if (is_polluting) {
+      step = -1;
+    }
+  } else if (accuracy >= accuracy_low) {
+    if (is_polluting) {
+      step = -1;
+    } else if (is_late) {
+      step = 1;
+    }
+  } else if (is_late || is_polluting) {
+    step = -1;
+  }
+
+  // Inaccurate prefetches are not worth the bandwidth when memory is busy
+  if (dram_bw >= high_bandwidth && accuracy < accuracy_high) {
+    step = -1;
+  }
+
+  if (step > 0 && level + 1 < std::size(levels)) {
+    ++level;
+  } else if (step < 0 && level > 0) {
+    --level;
+  }
+}
@@ -0,0 +1,41 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "prefetch_trace.h"
+
+#include <array>
+#include <cstring>
+
+void champsim::prefetch_trace_writer::write(const prefetch_trace_record& record) const
+{
+  if (enabled()) {
+    std::array<char, sizeof(prefetch_trace_record)> raw_buf;
+    std::memcpy(std::data(raw_buf), &record, sizeof(record));
+    out->write(std::data(raw_buf), std::size(raw_buf));
+  }
+}
+
+bool champsim::read_prefetch_trace(std::istream& in, prefetch_trace_record& record)
+{
+  std::array<char, sizeof(prefetch_trace_record)> raw_buf;
+  in.read(std::data(raw_buf), std::size(raw_buf));
+  if (static_cast<std::size_t>(in.gcount()) != std::size(raw_buf)) {
+    return false;
+  }
+
+  std::memcpy(&record, std::data(raw_buf), sizeof(record));
+  return true;
+}
@@ -16,6 +16,7 @@
 
 #include "ptw.h"
 
+#include <cassert>
 #include <cmath>
 #include <numeric>
 #include <fmt/chrono.h>
@@ -36,6 +37,8 @@ PageTableWalker::PageTableWalker(champsim::ptw_builder b)
       MAX_FILL(b.m_max_fill.value_or(champsim::bandwidth::maximum_type{b.scaled_by_ul_size(b.m_bandwidth_factor)})),
       HIT_LATENCY(b.m_clock_period * b.m_latency), vmem(b.m_vmem), CR3_addr(b.m_vmem->get_pte_pa(b.m_cpu, champsim::page_number{}, b.m_vmem->pt_levels).first)
 {
+  assert(std::size(upper_levels) <= std::numeric_limits<decltype(mshr_type::to_return)>::digits);
+
   std::vector<decltype(b.m_pscl)::value_type> local_pscl_dims{};
   std::remove_copy_if(std::begin(b.m_pscl), std::end(b.m_pscl), std::back_inserter(local_pscl_dims), [](auto x) { return std::get<0>(x) == 0; });
   std::sort(std::begin(local_pscl_dims), std::end(local_pscl_dims), std::greater{});
@@ -53,7 +56,7 @@ PageTableWalker::mshr_type::mshr_type(const request_type& req, std::size_t level
   asid[1] = req.asid[1];
 }
 
-auto PageTableWalker::handle_read(const request_type& handle_pkt, channel_type* ul) -> std::optional<mshr_type>
+auto PageTableWalker::handle_read(const request_type& handle_pkt, std::size_t upper_level) -> std::optional<mshr_type>
 {
   pscl_entry walk_init = {handle_pkt.v_address, CR3_addr, std::size(pscl)};
   std::vector<std::optional<pscl_entry>> pscl_hits;
@@ -69,7 +72,7 @@ auto PageTableWalker::handle_read(const request_type& handle_pkt, channel_type*
   fwd_mshr.address = champsim::address{champsim::splice(champsim::page_number{walk_init.ptw_addr}, champsim::page_offset{walk_offset})};
   fwd_mshr.v_address = handle_pkt.address;
   if (handle_pkt.response_requested) {
-    fwd_mshr.to_return = {&ul->returned};
+    fwd_mshr.to_return = uint64_t{1} << upper_level;
   }
 
   if constexpr (champsim::debug_print) {
@@ -134,10 +137,11 @@ long PageTableWalker::operate()
 
   champsim::bandwidth fill_bw{MAX_FILL};
   auto [complete_begin, complete_end] = champsim::get_span_p(std::cbegin(completed), std::cend(completed), fill_bw, is_ready);
-  std::for_each(complete_begin, complete_end, [](auto& mshr_entry) {
-    for (auto ret : mshr_entry.to_return) {
-      ret->emplace_back(mshr_entry.v_address, mshr_entry.v_address, *mshr_entry.data, mshr_entry.pf_metadata, mshr_entry.instr_depend_on_me);
-    }
+  std::for_each(complete_begin, complete_end, [this](auto& mshr_entry) {
+    champsim::for_each_set_bit(mshr_entry.to_return, [&](std::size_t i) {
+      upper_levels.at(i)->returned.emplace_back(mshr_entry.v_address, mshr_entry.v_address, *mshr_entry.data, mshr_entry.pf_metadata,
+                                                mshr_entry.instr_depend_on_me);
+    });
   });
   fill_bw.consume(std::distance(complete_begin, complete_end));
   completed.erase(complete_begin, complete_end);
@@ -154,9 +158,10 @@ long PageTableWalker::operate()
   finished.erase(mshr_begin, mshr_end);
 
   champsim::bandwidth tag_bw{MAX_READ};
-  for (auto* ul : upper_levels) {
-    auto [rq_begin, rq_end] = champsim::get_span_p(std::cbegin(ul->RQ), std::cend(ul->RQ), tag_bw, [&next_steps, ul, this](const auto& pkt) {
-      auto result = this->handle_read(pkt, ul);
+  for (std::size_t ul_index = 0; ul_index < std::size(upper_levels); ++ul_index) {
+    auto* ul = upper_levels[ul_index];
+    auto [rq_begin, rq_end] = champsim::get_span_p(std::cbegin(ul->RQ), std::cend(ul->RQ), tag_bw, [&next_steps, ul_index, this](const auto& pkt) {
+      auto result = this->handle_read(pkt, ul_index);
       if (result.has_value()) {
         next_steps.emplace_back(*result);
       }
@@ -166,7 +171,9 @@ long PageTableWalker::operate()
     ul->RQ.erase(rq_begin, rq_end);
   }
 
-  MSHR.insert(std::cend(MSHR), std::begin(next_steps), std::end(next_steps));
+  for (auto& step : next_steps) {
+    MSHR.push_back(std::move(step));
+  }
   progress += fill_bw.amount_consumed() + tag_bw.amount_consumed();
 
   if constexpr (champsim::debug_print) {
@@ -206,20 +213,14 @@ void PageTableWalker::finish_packet(const response_type& packet)
     return champsim::waitable{champsim::address{ppage}, this->current_time + penalty + (this->warmup ? champsim::chrono::clock::duration{} : HIT_LATENCY)};
   };
 
-  auto matches_addr = [block = champsim::block_number{packet.address}](auto x) {
-    return champsim::block_number{x.address} == block;
-  };
-  auto is_last_step = [](auto x) {
+  auto is_last_step = [](const auto& x) {
     return x.translation_level <= 0;
   };
-  auto last_finished = std::partition(std::begin(MSHR), std::end(MSHR), matches_addr);
-
-  std::for_each(std::begin(MSHR), last_finished, [is_last_step, finish_step, finish_last_step](auto& mshr_entry) {
-    mshr_entry.data = is_last_step(mshr_entry) ? finish_last_step(mshr_entry) : finish_step(mshr_entry);
-  });
 
-  std::partition_copy(std::begin(MSHR), last_finished, std::back_inserter(completed), std::back_inserter(finished), is_last_step);
-  MSHR.erase(std::begin(MSHR), last_finished);
+  for (auto mshr_entry : MSHR.find_all(mshr_indexer{}(packet.address))) {
+    mshr_entry->data = is_last_step(*mshr_entry) ? finish_last_step(*mshr_entry) : finish_step(*mshr_entry);
+    (is_last_step(*mshr_entry) ? completed : finished).push_back(MSHR.extract(mshr_entry));
+  }
 }
 
 void PageTableWalker::begin_phase()
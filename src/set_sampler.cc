@@ -0,0 +1,87 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "set_sampler.h"
+
+#include <cassert>
+
+#include "util/bits.h"
+
+void champsim::sampled_rate::observe(bool occurred)
+{
+  ++observations;
+  if (occurred) {
+    ++occurrences;
+  }
+
+  if (observations >= window) {
+    observations /= 2;
+    occurrences /= 2;
+  }
+}
+
+double champsim::sampled_rate::rate() const
+{
+  if (observations == 0) {
+    return prior;
+  }
+  return static_cast<double>(occurrences) / static_cast<double>(observations);
+}
+
+bool champsim::sampled_rate::peek() const { return carry + rate() >= 1.0; }
+
+void champsim::sampled_rate::commit(bool occurred) { carry += rate() - (occurred ? 1.0 : 0.0); }
+
+void champsim::sampled_latency::observe(champsim::chrono::clock::duration latency, unsigned levels)
+{
+  ++observations;
+  latency_total += latency;
+  levels_total += levels;
+
+  if (observations >= sampled_rate::window) {
+    observations /= 2;
+    latency_total /= 2;
+    levels_total /= 2;
+  }
+}
+
+champsim::chrono::clock::duration champsim::sampled_latency::latency() const
+{
+  if (observations == 0) {
+    return {};
+  }
+  return latency_total / static_cast<champsim::chrono::clock::rep>(observations);
+}
+
+unsigned champsim::sampled_latency::levels() const
+{
+  if (observations == 0) {
+    return 0;
+  }
+  return static_cast<unsigned>((levels_total + observations / 2) / observations);
+}
+
+champsim::set_sampler::set_sampler(uint32_t num_sets, uint32_t num_sampled) : sampled(num_sets, false), sampled_count(num_sampled)
+{
+  assert(champsim::is_power_of_2(num_sets));
+  assert(num_sampled > 0 && champsim::is_power_of_2(num_sampled) && num_sampled <= num_sets);
+
+  const auto group_size = num_sets / num_sampled;
+  for (uint64_t group = 0; group < num_sampled; ++group) {
+    const auto offset = ((group * 0x9e3779b97f4a7c15ull) >> 32) & (group_size - 1);
+    sampled.at(group * group_size + offset) = true;
+  }
+}
@@ -70,3 +70,12 @@ champsim::tracereader get_tracereader(const std::string& fname, uint8_t cpu, boo
 
   return champsim::get_tracereader_for_type<champsim::bulk_tracereader, input_instr>(fname, cpu);
 }
+
+champsim::tracereader get_classed_tracereader(const std::string& fname, uint8_t cpu, bool repeat)
+{
+  if (repeat) {
+    return champsim::get_tracereader_for_type<repeatable_reader_t, classed_instr>(fname, cpu);
+  }
+
+  return champsim::get_tracereader_for_type<champsim::bulk_tracereader, classed_instr>(fname, cpu);
+}
@@ -0,0 +1,171 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "way_partitioner.h"
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+
+champsim::way_partitioner::way_partitioner(std::size_t cpus, std::size_t sets, std::size_t ways, uint64_t repartition_interval)
+    : num_cpus(cpus), num_sets(sets), num_ways(ways), monitor_stride(std::max<std::size_t>(sets / monitored_sets, 1)), interval(repartition_interval),
+      next_repartition(repartition_interval), shadow_tags(cpus * ((sets + monitor_stride - 1) / monitor_stride)), stack_hits(cpus * ways),
+      owners(sets * ways, no_owner), last_touch(sets * ways), occupancy(cpus)
+{
+  // Until the monitors have counted any hits, the ways are shared equally
+  for (std::size_t cpu = 0; cpu < num_cpus; ++cpu) {
+    allocation.push_back(static_cast<uint32_t>(num_ways / num_cpus + (cpu < num_ways % num_cpus ? 1 : 0)));
+  }
+}
+
+std::size_t champsim::way_partitioner::block_index(long set, long way) const
+{
+  return static_cast<std::size_t>(set) * num_ways + static_cast<std::size_t>(way);
+}
+
+void champsim::way_partitioner::observe(uint32_t cpu, long set, uint64_t block, uint64_t cycle)
+{
+  if (!enabled() || cpu >= num_cpus) {
+    return;
+  }
+
+  if (cycle >= next_repartition) {
+    repartition();
+    next_repartition = cycle + interval;
+  }
+
+  const auto set_idx = static_cast<std::size_t>(set);
+  if (set_idx % monitor_stride != 0) {
+    return;
+  }
+
+  auto& stack = shadow_tags.at(cpu * (std::size(shadow_tags) / num_cpus) + set_idx / monitor_stride);
+  if (auto found = std::find(std::begin(stack), std::end(stack), block); found != std::end(stack)) {
+    ++stack_hits.at(cpu * num_ways + static_cast<std::size_t>(std::distance(std::begin(stack), found)));
+    std::rotate(std::begin(stack), found, std::next(found));
+  } else {
+    if (std::size(stack) == num_ways) {
+      stack.pop_back();
+    }
+    stack.insert(std::begin(stack), block);
+  }
+}
+
+void champsim::way_partitioner::repartition()
+{
+  if (!enabled()) {
+    return;
+  }
+  ++repartition_count;
+
+  // The hits each core would have with the given number of ways
+  std::vector<uint64_t> utility(num_cpus * (num_ways + 1));
+  for (std::size_t cpu = 0; cpu < num_cpus; ++cpu) {
+    auto hits_begin = std::next(std::begin(stack_hits), static_cast<long>(cpu * num_ways));
+    auto utility_begin = std::next(std::begin(utility), static_cast<long>(cpu * (num_ways + 1) + 1));
+    std::partial_sum(hits_begin, std::next(hits_begin, static_cast<long>(num_ways)), utility_begin);
+  }
+
+  // Lookahead: give the ways, a block of them at a time, to the core with the most hits per way
+  const uint32_t min_ways = (num_ways >= num_cpus) ? 1 : 0;
+  allocation.assign(num_cpus, min_ways);
+  auto balance = num_ways - min_ways * num_cpus;
+  while (balance > 0) {
+    double best_utility = 0;
+    std::size_t best_cpu = num_cpus;
+    std::size_t best_ways = 0;
+    for (std::size_t cpu = 0; cpu < num_cpus; ++cpu) {
+      const auto base = cpu * (num_ways + 1) + allocation[cpu];
+      for (std::size_t ways = 1; ways <= balance; ++ways) {
+        auto marginal = static_cast<double>(utility[base + ways] - utility[base]) / static_cast<double>(ways);
+        if (marginal > best_utility) {
+          best_utility = marginal;
+          best_cpu = cpu;
+          best_ways = ways;
+        }
+      }
+    }
+
+    // If no core would gain any hits, the remaining ways are spread evenly
+    if (best_cpu == num_cpus) {
+      for (; balance > 0; --balance) {
+        ++*std::min_element(std::begin(allocation), std::end(allocation));
+      }
+    } else {
+      allocation[best_cpu] += static_cast<uint32_t>(best_ways);
+      balance -= best_ways;
+    }
+  }
+
+  for (auto& hits : stack_hits) {
+    hits /= 2;
+  }
+}
+
+void champsim::way_partitioner::touch(long set, long way)
+{
+  if (enabled()) {
+    last_touch.at(block_index(set, way)) = ++touches;
+  }
+}
+
+void champsim::way_partitioner::fill(uint32_t cpu, long set, long way)
+{
+  if (enabled()) {
+    owners.at(block_index(set, way)) = cpu;
+    last_touch.at(block_index(set, way)) = ++touches;
+  }
+}
+
+long champsim::way_partitioner::restrict_victim(uint32_t cpu, long set, const cache_block* current_set, long chosen)
+{
+  // A bypass is not restricted
+  if (!enabled() || cpu >= num_cpus || chosen < 0 || static_cast<std::size_t>(chosen) >= num_ways) {
+    return chosen;
+  }
+
+  std::fill(std::begin(occupancy), std::end(occupancy), 0);
+  for (std::size_t way = 0; way < num_ways; ++way) {
+    auto owner = owners[block_index(set, static_cast<long>(way))];
+    if (current_set[way].valid && owner < num_cpus) {
+      ++occupancy[owner];
+    }
+  }
+
+  const bool below_allocation = occupancy[cpu] < allocation[cpu];
+  auto may_evict = [&, this](long way) {
+    auto owner = owners[block_index(set, way)];
+    if (below_allocation) {
+      return owner != cpu && (owner >= num_cpus || occupancy[owner] > allocation[owner]);
+    }
+    return owner == cpu;
+  };
+
+  if (may_evict(chosen)) {
+    return chosen;
+  }
+
+  long victim = chosen;
+  uint64_t oldest = std::numeric_limits<uint64_t>::max();
+  for (long way = 0; way < static_cast<long>(num_ways); ++way) {
+    if (may_evict(way) && last_touch[block_index(set, way)] < oldest) {
+      victim = way;
+      oldest = last_touch[block_index(set, way)];
+    }
+  }
+  return victim;
+}
@@ -0,0 +1,92 @@
+#include <catch.hpp>
+#include <random>
+
+#include "cache_sweep.h"
+#include "util/lru_table.h"
+
+namespace
+{
+struct block_getter {
+  auto operator()(champsim::block_number block) const { return block.to<uint64_t>(); }
+};
+} // namespace
+
+TEST_CASE("A stack distance profile profiles every power-of-two set count in its range")
+{
+  champsim::stack_distance_profile uut{4, 64, 8};
+  REQUIRE_THAT(uut.set_counts(), Catch::Matchers::RangeEquals(std::vector<std::size_t>{4, 8, 16, 32, 64}));
+  REQUIRE(uut.max_ways() == 8);
+}
+
+TEST_CASE("A stack distance profile counts a re-reference as a hit only for associativities deeper than its stack distance")
+{
+  champsim::stack_distance_profile uut{1, 1, 4};
+  for (uint64_t block : {0xa, 0xb, 0xc, 0xa}) {
+    uut.access(champsim::block_number{block});
+  }
+
+  REQUIRE(uut.accesses() == 4);
+  REQUIRE(uut.misses(1, 1) == 4);
+  REQUIRE(uut.misses(1, 2) == 4);
+  REQUIRE(uut.misses(1, 3) == 3);
+  REQUIRE(uut.misses(1, 4) == 3);
+}
+
+TEST_CASE("A stack distance profile separates blocks that map to different sets")
+{
+  champsim::stack_distance_profile uut{1, 2, 1};
+  for (uint64_t block : {0x0, 0x1, 0x0}) {
+    uut.access(champsim::block_number{block});
+  }
+
+  REQUIRE(uut.misses(1, 1) == 3);
+  REQUIRE(uut.misses(2, 1) == 2);
+}
+
+TEST_CASE("A stack distance profile matches an LRU table of every profiled geometry")
+{
+  constexpr std::size_t max_ways = 8;
+  champsim::stack_distance_profile uut{1, 32, max_ways};
+
+  std::vector<champsim::block_number> stream;
+  std::mt19937_64 rng{0xdeadbeef};
+  std::uniform_int_distribution<uint64_t> dist{0, 255};
+  std::generate_n(std::back_inserter(stream), 10000, [&] { return champsim::block_number{dist(rng)}; });
+
+  for (auto block : stream) {
+    uut.access(block);
+  }
+
+  for (auto sets : uut.set_counts()) {
+    for (std::size_t ways = 1; ways <= max_ways; ++ways) {
+      champsim::lru_table<champsim::block_number, ::block_getter, ::block_getter> reference{sets, ways};
+      uint64_t misses = 0;
+      for (auto block : stream) {
+        if (!reference.check_hit(block).has_value()) {
+          ++misses;
+          reference.fill(block);
+        }
+      }
+
+      CHECK(uut.misses(sets, ways) == misses);
+    }
+  }
+}
+
+TEST_CASE("Clearing a stack distance profile keeps its contents")
+{
+  champsim::stack_distance_profile uut{1, 1, 2};
+  uut.access(champsim::block_number{0xa});
+  uut.clear_stats();
+  uut.access(champsim::block_number{0xa});
+
+  REQUIRE(uut.accesses() == 1);
+  REQUIRE(uut.misses(1, 1) == 0);
+}
+
+TEST_CASE("A stack distance profile rejects geometries it did not profile")
+{
+  champsim::stack_distance_profile uut{4, 16, 2};
+  REQUIRE_THROWS_AS(uut.misses(2, 1), std::out_of_range);
+  REQUIRE_THROWS_AS(uut.misses(4, 3), std::out_of_range);
+}
@@ -0,0 +1,33 @@
+#include <catch.hpp>
+#include <numeric>
+#include <vector>
+
+#include "util/tag_match.h"
+
+TEST_CASE("Tag matching finds the way that holds a tag")
+{
+  const auto ways = GENERATE(as<std::size_t>{}, 1, 2, 3, 4, 5, 8, 11, 12, 16, 20, 32);
+  std::vector<uint64_t> tags(ways);
+  std::iota(std::begin(tags), std::end(tags), uint64_t{100});
+
+  for (std::size_t i = 0; i < ways; ++i) {
+    CHECK(champsim::find_tag(std::data(tags), ways, tags.at(i)) == i);
+  }
+}
+
+TEST_CASE("Tag matching returns the number of ways on a miss")
+{
+  const auto ways = GENERATE(as<std::size_t>{}, 0, 1, 4, 7, 8, 12, 16);
+  std::vector<uint64_t> tags(ways, 0);
+  REQUIRE(champsim::find_tag(std::data(tags), ways, 0xdeadbeef) == ways);
+}
+
+TEST_CASE("Tag matching finds the first of several matching ways")
+{
+  std::vector<uint64_t> tags{1, 2, 3, 7, 5, 7, 7, 8, 7};
+  REQUIRE(champsim::find_tag(std::data(tags), std::size(tags), 7) == 3);
+  REQUIRE(champsim::find_tag(std::data(tags) + 4, std::size(tags) - 4, 7) == 1);
+
+  std::vector<uint64_t> twelve{1, 2, 3, 4, 5, 6, 7, 8, 9, 7, 11, 7};
+  REQUIRE(champsim::find_tag(std::data(twelve), std::size(twelve), 7) == 6);
+}
@@ -0,0 +1,94 @@
+#include <catch.hpp>
+#include <utility>
+
+#include "util/indexed_list.h"
+
+namespace
+{
+struct first_of_pair {
+  int operator()(const std::pair<int, int>& x) const { return x.first; }
+};
+
+using test_list = champsim::indexed_list<std::pair<int, int>, ::first_of_pair>;
+
+std::vector<std::pair<int, int>> contents(const test_list& uut) { return {std::begin(uut), std::end(uut)}; }
+} // namespace
+
+TEST_CASE("An indexed list finds an entry by its key")
+{
+  ::test_list uut;
+  uut.push_back({1, 10});
+  uut.push_back({2, 20});
+  uut.push_back({3, 30});
+
+  REQUIRE(std::size(uut) == 3);
+  REQUIRE(uut.find(2)->second == 20);
+  REQUIRE(uut.find(4) == std::end(uut));
+}
+
+TEST_CASE("An indexed list keeps its entries in insertion order")
+{
+  ::test_list uut;
+  uut.push_back({3, 30});
+  uut.push_back({1, 10});
+  uut.push_back({2, 20});
+
+  REQUIRE_THAT(::contents(uut), Catch::Matchers::RangeEquals(std::vector<std::pair<int, int>>{{3, 30}, {1, 10}, {2, 20}}));
+}
+
+TEST_CASE("An indexed list finds every entry with a key in insertion order")
+{
+  ::test_list uut;
+  for (int i = 0; i < 10; ++i) {
+    uut.push_back({i % 3, i});
+  }
+
+  std::vector<int> found;
+  for (auto it : uut.find_all(1)) {
+    found.push_back(it->second);
+  }
+  REQUIRE_THAT(found, Catch::Matchers::RangeEquals(std::vector<int>{1, 4, 7}));
+}
+
+TEST_CASE("An erased entry can no longer be found")
+{
+  ::test_list uut;
+  uut.push_back({1, 10});
+  uut.push_back({2, 20});
+  uut.push_back({3, 30});
+
+  uut.erase(std::begin(uut), std::next(std::begin(uut), 2));
+  REQUIRE(std::size(uut) == 1);
+  REQUIRE(uut.find(1) == std::end(uut));
+  REQUIRE(uut.find(2) == std::end(uut));
+  REQUIRE(uut.find(3)->second == 30);
+
+  auto extracted = uut.extract(uut.find(3));
+  REQUIRE(extracted.second == 30);
+  REQUIRE(std::empty(uut));
+  REQUIRE(uut.find(3) == std::end(uut));
+}
+
+TEST_CASE("Moving an entry within an indexed list keeps it findable")
+{
+  ::test_list uut;
+  uut.push_back({1, 10});
+  uut.push_back({2, 20});
+  uut.push_back({3, 30});
+
+  auto* address_before = &*uut.find(3);
+  uut.move_before(std::begin(uut), uut.find(3));
+  REQUIRE_THAT(::contents(uut), Catch::Matchers::RangeEquals(std::vector<std::pair<int, int>>{{3, 30}, {1, 10}, {2, 20}}));
+  REQUIRE(&*uut.find(3) == address_before);
+}
+
+TEST_CASE("A copied indexed list has its own index")
+{
+  ::test_list original;
+  original.push_back({1, 10});
+
+  ::test_list uut{original};
+  uut.find(1)->second = 11;
+  REQUIRE(original.find(1)->second == 10);
+  REQUIRE(uut.find(1)->second == 11);
+}
@@ -0,0 +1,116 @@
+#include <catch.hpp>
+#include <deque>
+#include <random>
+
+#include "util/algorithm.h"
+#include "util/ring_buffer.h"
+
+TEST_CASE("A ring buffer rounds its capacity up to a power of two")
+{
+  champsim::ring_buffer<int> uut{5};
+  REQUIRE(uut.capacity() == 8);
+  REQUIRE(uut.empty());
+}
+
+TEST_CASE("A ring buffer is first-in, first-out")
+{
+  champsim::ring_buffer<int> uut{4};
+  for (int i = 0; i < 4; ++i) {
+    uut.push_back(i);
+  }
+  uut.pop_front();
+  uut.push_back(4);
+
+  REQUIRE(uut.capacity() == 4);
+  REQUIRE(uut.front() == 1);
+  REQUIRE(uut.back() == 4);
+  REQUIRE_THAT(uut, Catch::Matchers::RangeEquals(std::vector{1, 2, 3, 4}));
+}
+
+TEST_CASE("A ring buffer grows when it is pushed beyond its capacity")
+{
+  champsim::ring_buffer<int> uut{2};
+  uut.push_back(0);
+  uut.pop_front();
+  for (int i = 1; i < 6; ++i) {
+    uut.push_back(i);
+  }
+
+  REQUIRE(uut.capacity() == 8);
+  REQUIRE_THAT(uut, Catch::Matchers::RangeEquals(std::vector{1, 2, 3, 4, 5}));
+}
+
+TEST_CASE("Clearing a ring buffer keeps its capacity")
+{
+  champsim::ring_buffer<int> uut{4};
+  uut.push_back(1);
+  uut.clear();
+  REQUIRE(uut.empty());
+  REQUIRE(uut.capacity() == 4);
+}
+
+TEST_CASE("A ring buffer rejects positions past its end")
+{
+  champsim::ring_buffer<int> uut{4};
+  uut.push_back(1);
+  REQUIRE(uut.at(0) == 1);
+  REQUIRE_THROWS_AS(uut.at(1), std::out_of_range);
+}
+
+TEST_CASE("Erasing from a ring buffer matches erasing from a deque")
+{
+  std::mt19937_64 rng{0xdeadbeef};
+  champsim::ring_buffer<int> uut{16};
+  std::deque<int> reference;
+
+  for (int i = 0; i < 10000; ++i) {
+    if (std::size(reference) < 12) {
+      uut.push_back(i);
+      reference.push_back(i);
+    } else {
+      std::uniform_int_distribution<long> pos_dist{0, static_cast<long>(std::size(reference))};
+      auto first = pos_dist(rng);
+      auto last = pos_dist(rng);
+      if (first > last) {
+        std::swap(first, last);
+      }
+
+      auto uut_it = uut.erase(std::next(std::cbegin(uut), first), std::next(std::cbegin(uut), last));
+      auto ref_it = reference.erase(std::next(std::cbegin(reference), first), std::next(std::cbegin(reference), last));
+      REQUIRE(std::distance(std::begin(uut), uut_it) == std::distance(std::begin(reference), ref_it));
+    }
+    REQUIRE_THAT(uut, Catch::Matchers::RangeEquals(reference));
+  }
+  REQUIRE(uut.capacity() == 16);
+}
+
+TEST_CASE("A ring buffer supports extracting elements")
+{
+  champsim::ring_buffer<int> uut{8};
+  champsim::ring_buffer<int> extracted{8};
+  for (int i = 0; i < 8; ++i) {
+    uut.push_back(i);
+  }
+
+  auto [last_kept, extracted_end] = champsim::extract_if(std::begin(uut), std::end(uut), std::back_inserter(extracted), [](int x) { return x % 2 == 0; });
+  uut.erase(last_kept, std::end(uut));
+
+  REQUIRE_THAT(uut, Catch::Matchers::RangeEquals(std::vector{1, 3, 5, 7}));
+  REQUIRE_THAT(extracted, Catch::Matchers::RangeEquals(std::vector{0, 2, 4, 6}));
+}
+
+TEST_CASE("A ring buffer supports transforming a prefix into another queue")
+{
+  champsim::ring_buffer<int> uut{8};
+  champsim::ring_buffer<int> transformed{8};
+  for (int i = 0; i < 8; ++i) {
+    uut.push_back(i);
+  }
+
+  champsim::bandwidth bw{champsim::bandwidth::maximum_type{8}};
+  auto count = champsim::transform_while_n(uut, std::back_inserter(transformed), bw, [](int x) { return x < 3; }, [](int x) { return 10 * x; });
+
+  REQUIRE(count == 3);
+  REQUIRE_THAT(uut, Catch::Matchers::RangeEquals(std::vector{3, 4, 5, 6, 7}));
+  REQUIRE_THAT(transformed, Catch::Matchers::RangeEquals(std::vector{0, 10, 20}));
+}
@@ -0,0 +1,52 @@
+#include <catch.hpp>
+#include <vector>
+
+#include "util/shared_list.h"
+
+TEST_CASE("An empty shared list holds no storage")
+{
+  champsim::shared_list<uint64_t> uut{};
+  REQUIRE(uut.empty());
+  REQUIRE(std::begin(uut) == nullptr);
+  REQUIRE(std::begin(champsim::shared_list<uint64_t>{std::vector<uint64_t>{}}) == nullptr);
+}
+
+TEST_CASE("Copies of a shared list share its storage")
+{
+  champsim::shared_list<uint64_t> uut{1, 2, 3};
+  auto copy = uut;
+  REQUIRE(std::begin(copy) == std::begin(uut));
+  REQUIRE(copy == uut);
+}
+
+TEST_CASE("Removing the front of a shared list does not affect its copies")
+{
+  champsim::shared_list<uint64_t> uut{1, 2, 3};
+  auto copy = uut;
+  uut.pop_front();
+
+  REQUIRE_THAT(uut, Catch::Matchers::RangeEquals(std::vector<uint64_t>{2, 3}));
+  REQUIRE_THAT(copy, Catch::Matchers::RangeEquals(std::vector<uint64_t>{1, 2, 3}));
+
+  uut.pop_front();
+  uut.pop_front();
+  REQUIRE(uut.empty());
+}
+
+TEST_CASE("The union of shared lists keeps one copy of each element")
+{
+  champsim::shared_list<uint64_t> lhs{1, 3, 5};
+  champsim::shared_list<uint64_t> rhs{2, 3, 4};
+  REQUIRE_THAT((champsim::shared_list<uint64_t>::set_union(lhs, rhs)), Catch::Matchers::RangeEquals(std::vector<uint64_t>{1, 2, 3, 4, 5}));
+}
+
+TEST_CASE("The union of a shared list with a list it contains shares its storage")
+{
+  champsim::shared_list<uint64_t> lhs{1, 2, 3};
+  champsim::shared_list<uint64_t> rhs{2};
+  auto merged = champsim::shared_list<uint64_t>::set_union(lhs, rhs);
+  REQUIRE(std::begin(merged) == std::begin(lhs));
+
+  auto merged_empty = champsim::shared_list<uint64_t>::set_union(champsim::shared_list<uint64_t>{}, lhs);
+  REQUIRE(std::begin(merged_empty) == std::begin(lhs));
+}
@@ -0,0 +1,80 @@
+#include <catch.hpp>
+#include <random>
+
+#include "util/space_saving.h"
+
+TEST_CASE("A space-saving sketch counts keys exactly while it has free counters")
+{
+  champsim::space_saving<int> uut{4};
+  for (int key : {1, 2, 1, 3, 1, 2})
+    uut.add(key);
+
+  auto top = uut.top();
+  REQUIRE(std::size(top) == 3);
+  REQUIRE(top.at(0).key == 1);
+  REQUIRE(top.at(0).count == 3);
+  REQUIRE(top.at(1).key == 2);
+  REQUIRE(top.at(1).count == 2);
+  REQUIRE(top.at(2).key == 3);
+  REQUIRE(top.at(2).count == 1);
+  for (const auto& entry : top)
+    REQUIRE(entry.error == 0);
+}
+
+TEST_CASE("A space-saving sketch replaces its smallest counter and records the error")
+{
+  champsim::space_saving<int> uut{2};
+  for (int key : {1, 1, 1, 2, 3})
+    uut.add(key);
+
+  auto top = uut.top();
+  REQUIRE(std::size(top) == 2);
+  REQUIRE(top.at(0).key == 1);
+  REQUIRE(top.at(0).count == 3);
+  REQUIRE(top.at(1).key == 3);
+  REQUIRE(top.at(1).count == 2);
+  REQUIRE(top.at(1).error == 1);
+  REQUIRE(uut.total() == 5);
+}
+
+TEST_CASE("A space-saving sketch keeps every key more frequent than its guarantee")
+{
+  constexpr std::size_t num_counters = 8;
+  champsim::space_saving<uint64_t> uut{num_counters};
+
+  std::mt19937_64 rng{0xdeadbeef};
+  std::uniform_int_distribution<uint64_t> noise{100, 10000};
+  std::vector<uint64_t> exact(3, 0); // each key occurs more often than the total divided by the number of counters
+  for (int i = 0; i < 20000; ++i) {
+    uint64_t key = (i % 2 == 0) ? static_cast<uint64_t>(i % 3) : noise(rng);
+    if (key < std::size(exact))
+      ++exact.at(key);
+    uut.add(key);
+  }
+
+  auto top = uut.top();
+  REQUIRE(std::size(top) == num_counters);
+  for (uint64_t key = 0; key < std::size(exact); ++key) {
+    auto found = std::find_if(std::begin(top), std::end(top), [key](const auto& entry) { return entry.key == key; });
+    REQUIRE(found != std::end(top));
+    REQUIRE(found->count >= exact.at(key));
+    REQUIRE(found->count - found->error <= exact.at(key));
+  }
+}
+
+TEST_CASE("A space-saving sketch with no counters tracks nothing")
+{
+  champsim::space_saving<int> uut{};
+  uut.add(1);
+  REQUIRE(std::empty(uut.top()));
+  REQUIRE(uut.total() == 0);
+}
+
+TEST_CASE("Clearing a space-saving sketch keeps its counters")
+{
+  champsim::space_saving<int> uut{2};
+  uut.add(1);
+  uut.clear();
+  REQUIRE(std::empty(uut.top()));
+  REQUIRE(uut.num_counters() == 2);
+}
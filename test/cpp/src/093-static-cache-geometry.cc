@@ -0,0 +1,92 @@
+#include <catch.hpp>
+#include <stdexcept>
+#include <vector>
+
+#include "cache.h"
+#include "cache_geometry.h"
+#include "defaults.hpp"
+#include "mocks.hpp"
+
+TEST_CASE("A static cache geometry finds the way that holds an address")
+{
+  using geometry = champsim::static_cache_geometry<4, 3, 6>;
+  std::vector<uint64_t> tags(geometry::sets * geometry::ways, 0);
+
+  const uint64_t address = 0xdead'beef;
+  const auto set = geometry::set_index(address);
+  REQUIRE(set == ((address >> 6) & 3));
+  REQUIRE(geometry::find_way(std::data(tags), address) == geometry::ways);
+
+  tags.at(set * geometry::ways + 2) = geometry::tag(address);
+  REQUIRE(geometry::find_way(std::data(tags), address) == 2);
+  REQUIRE(geometry::find_way(std::data(tags), address + 64) == geometry::ways);
+
+  tags.at(set * geometry::ways + 1) = geometry::tag(address);
+  REQUIRE(geometry::find_way(std::data(tags), address) == 1);
+}
+
+TEST_CASE("A static cache geometry gives the cache its sets, ways, and offset")
+{
+  CACHE uut{champsim::cache_builder{}.static_geometry<16, 4, 6>()};
+  REQUIRE(uut.NUM_SET == 16);
+  REQUIRE(uut.NUM_WAY == 4);
+  REQUIRE(uut.OFFSET_BITS == champsim::data::bits{6});
+}
+
+TEST_CASE("A cache rejects a geometry that conflicts with its static geometry")
+{
+  const auto fixed = champsim::cache_builder{}.static_geometry<16, 4, 6>();
+  REQUIRE_THROWS_AS(CACHE{champsim::cache_builder{fixed}.sets(32)}, std::invalid_argument);
+  REQUIRE_THROWS_AS(CACHE{champsim::cache_builder{fixed}.ways(8)}, std::invalid_argument);
+  REQUIRE_THROWS_AS(CACHE{champsim::cache_builder{fixed}.offset_bits(champsim::data::bits{7})}, std::invalid_argument);
+  REQUIRE_NOTHROW(CACHE{champsim::cache_builder{fixed}.sets(16).ways(4)});
+}
+
+SCENARIO("A cache with a static geometry hits on blocks it has filled")
+{
+  GIVEN("A cache with a static geometry")
+  {
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l2c}
+                  .name("093-uut")
+                  .static_geometry<16, 4, 6>()
+                  .upper_levels({&mock_ul.queues})
+                  .lower_level(&mock_ll.queues)};
+
+    std::array<champsim::operable*, 3> elements{{&uut, &mock_ll, &mock_ul}};
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    auto issue_and_wait = [&](uint64_t id) {
+      decltype(mock_ul)::request_type pkt;
+      pkt.address = champsim::address{0xdeadbeef};
+      pkt.is_translated = true;
+      pkt.instr_id = id;
+      pkt.cpu = 0;
+      pkt.type = access_type::LOAD;
+      auto issued = mock_ul.issue(pkt);
+
+      for (auto i = 0; i < 100; ++i)
+        for (auto elem : elements)
+          elem->_operate();
+
+      return issued;
+    };
+
+    WHEN("A block is read twice")
+    {
+      REQUIRE(issue_and_wait(1));
+      REQUIRE(issue_and_wait(2));
+
+      THEN("Only the first read misses")
+      {
+        REQUIRE(mock_ll.packet_count() == 1);
+        REQUIRE(mock_ul.packets.back().return_time > 0);
+      }
+    }
+  }
+}
@@ -0,0 +1,121 @@
+#include <catch.hpp>
+
+#include "instr.h"
+#include "mocks.hpp"
+#include "ooo_cpu.h"
+
+namespace
+{
+ooo_model_instr ready_instruction_of_class(uint64_t id, op_class which)
+{
+  auto instr = champsim::test::instruction_with_ip(id);
+  instr.instr_id = id;
+  instr.exec_class = which;
+  instr.scheduled = true;
+  instr.ready_time = champsim::chrono::clock::time_point{};
+  return instr;
+}
+} // namespace
+
+TEST_CASE("The trace formats without a class derive the class of an instruction")
+{
+  REQUIRE(champsim::test::instruction_with_ip(1).exec_class == op_class::ALU);
+  REQUIRE(champsim::test::branch_instruction_with_ip(1).exec_class == op_class::BRANCH);
+  REQUIRE(champsim::test::instruction_with_ip_and_source_memory(champsim::address{1}, champsim::address{0xcafe}).exec_class == op_class::LOAD);
+}
+
+TEST_CASE("The classed trace format gives the class of an instruction")
+{
+  classed_instr trace_instr{};
+  trace_instr.ip = 0xdeadbeef;
+  trace_instr.instr_class = static_cast<unsigned char>(op_class::FP);
+  REQUIRE(ooo_model_instr{0, trace_instr}.exec_class == op_class::FP);
+}
+
+SCENARIO("An instruction executes with the latency of its class")
+{
+  GIVEN("A core with a long floating-point latency")
+  {
+    constexpr unsigned execute_latency = 1;
+    constexpr unsigned fp_latency = 5;
+    do_nothing_MRC mock_L1I, mock_L1D;
+    O3_CPU uut{champsim::core_builder{}
+                   .execute_latency(execute_latency)
+                   .execute_width(champsim::bandwidth::maximum_type{2})
+                   .execute_class(op_class::FP, fp_latency, champsim::bandwidth::maximum_type{1})
+                   .fetch_queues(&mock_L1I.queues)
+                   .data_queues(&mock_L1D.queues)};
+    uut.warmup = false;
+
+    uut.ROB.push_back(::ready_instruction_of_class(1, op_class::ALU));
+    uut.ROB.push_back(::ready_instruction_of_class(2, op_class::FP));
+
+    WHEN("Both instructions execute")
+    {
+      auto executed = uut.execute_instruction();
+
+      THEN("Each instruction is ready after the latency of its class")
+      {
+        REQUIRE(executed == 2);
+        REQUIRE(uut.ROB.at(0).ready_time == uut.current_time + execute_latency * uut.clock_period);
+        REQUIRE(uut.ROB.at(1).ready_time == uut.current_time + fp_latency * uut.clock_period);
+      }
+    }
+  }
+}
+
+SCENARIO("Instructions of one class contend for its functional units")
+{
+  const auto pipelined = GENERATE(true, false);
+
+  GIVEN("A core with a single divider")
+  {
+    constexpr unsigned divide_latency = 4;
+    do_nothing_MRC mock_L1I, mock_L1D;
+    O3_CPU uut{champsim::core_builder{}
+                   .execute_width(champsim::bandwidth::maximum_type{4})
+                   .execute_class(op_class::SLOW_ALU, divide_latency, champsim::bandwidth::maximum_type{1}, pipelined)
+                   .fetch_queues(&mock_L1I.queues)
+                   .data_queues(&mock_L1D.queues)};
+    uut.warmup = false;
+
+    uut.ROB.push_back(::ready_instruction_of_class(1, op_class::SLOW_ALU));
+    uut.ROB.push_back(::ready_instruction_of_class(2, op_class::SLOW_ALU));
+    uut.ROB.push_back(::ready_instruction_of_class(3, op_class::ALU));
+
+    WHEN("The instructions are ready in the same cycle")
+    {
+      auto executed = uut.execute_instruction();
+
+      THEN("Only one instruction uses the divider")
+      {
+        REQUIRE(executed == 2);
+        REQUIRE(uut.ROB.at(0).executed);
+        REQUIRE_FALSE(uut.ROB.at(1).executed);
+        REQUIRE(uut.ROB.at(2).executed);
+      }
+
+      AND_WHEN("A cycle passes")
+      {
+        uut.current_time += uut.clock_period;
+        uut.execute_instruction();
+
+        THEN("The second instruction executes only if the divider is pipelined") { REQUIRE(uut.ROB.at(1).executed == pipelined); }
+      }
+
+      AND_WHEN("The latency of the divider passes")
+      {
+        uut.current_time += divide_latency * uut.clock_period;
+        uut.execute_instruction();
+
+        THEN("The second instruction executes") { REQUIRE(uut.ROB.at(1).executed); }
+      }
+    }
+  }
+}
+
+TEST_CASE("An execute class without ports is rejected")
+{
+  champsim::core_builder builder{};
+  REQUIRE_THROWS_AS(builder.execute_class(op_class::FP, 4, champsim::bandwidth::maximum_type{0}), std::invalid_argument);
+}
@@ -0,0 +1,76 @@
+#include <catch.hpp>
+
+#include "../../../branch/bimodal/bimodal.h"
+#include "../../../btb/basic_btb/basic_btb.h"
+#include "instr.h"
+#include "mocks.hpp"
+#include "ooo_cpu.h"
+
+SCENARIO("The branch-only evaluation counts every streamed instruction")
+{
+  GIVEN("A core with no branch predictor")
+  {
+    do_nothing_MRC mock_L1I;
+    do_nothing_MRC mock_L1D;
+    O3_CPU uut{champsim::core_builder{}.fetch_queues(&mock_L1I.queues).data_queues(&mock_L1D.queues)};
+    uut.begin_phase();
+
+    WHEN("A non-branch instruction is evaluated")
+    {
+      auto instr = champsim::test::instruction_with_ip(0xdeadbeef);
+      auto mispredicted = uut.do_evaluate_branch(instr);
+
+      THEN("The instruction is counted but not mispredicted")
+      {
+        REQUIRE_FALSE(mispredicted);
+        REQUIRE(uut.sim_instr() == 1);
+        REQUIRE(uut.sim_stats.total_branch_types.value_or(branch_type::NOT_BRANCH, 0) == 1);
+        REQUIRE(uut.sim_stats.branch_type_misses.value_or(branch_type::NOT_BRANCH, 0) == 0);
+      }
+    }
+
+    WHEN("A taken jump is evaluated")
+    {
+      auto instr = champsim::test::branch_instruction_with_ip(0xdeadbeef);
+      instr.branch_target = champsim::address{0xcafebabe};
+      auto mispredicted = uut.do_evaluate_branch(instr);
+
+      THEN("The jump is mispredicted")
+      {
+        REQUIRE(mispredicted);
+        REQUIRE(uut.sim_instr() == 1);
+        REQUIRE(uut.sim_stats.total_branch_types.value_or(branch_type::BRANCH_DIRECT_JUMP, 0) == 1);
+        REQUIRE(uut.sim_stats.branch_type_misses.value_or(branch_type::BRANCH_DIRECT_JUMP, 0) == 1);
+      }
+    }
+  }
+}
+
+SCENARIO("The branch-only evaluation trains the branch predictor and BTB")
+{
+  GIVEN("A core with a bimodal predictor and a basic BTB")
+  {
+    do_nothing_MRC mock_L1I;
+    do_nothing_MRC mock_L1D;
+    O3_CPU uut{champsim::core_builder{}.fetch_queues(&mock_L1I.queues).data_queues(&mock_L1D.queues).branch_predictor<bimodal>().btb<basic_btb>()};
+    uut.initialize();
+    uut.begin_phase();
+
+    WHEN("The same taken jump is evaluated many times")
+    {
+      constexpr long long repetitions = 100;
+      for (long long i = 0; i < repetitions; ++i) {
+        auto instr = champsim::test::branch_instruction_with_ip(0xdeadbeef);
+        instr.branch_target = champsim::address{0xcafebabe};
+        uut.do_evaluate_branch(instr);
+      }
+
+      THEN("Only the first encounter is mispredicted")
+      {
+        REQUIRE(uut.sim_instr() == repetitions);
+        REQUIRE(uut.sim_stats.total_branch_types.value_or(branch_type::BRANCH_DIRECT_JUMP, 0) == repetitions);
+        REQUIRE(uut.sim_stats.branch_type_misses.value_or(branch_type::BRANCH_DIRECT_JUMP, 0) == 1);
+      }
+    }
+  }
+}
@@ -3,6 +3,17 @@
 #include "core_stats.h"
 #include "stats_printer.h"
 
+namespace
+{
+void append_cpi_stack(std::vector<std::string>& lines, std::string_view value)
+{
+  lines.emplace_back("CPI stack");
+  for (auto name : cpi_component_names) {
+    lines.push_back(std::string{name} + ": " + std::string{value});
+  }
+}
+} // namespace
+
 TEST_CASE("An empty core stats prints zero")
 {
   cpu_stats given{};
@@ -17,6 +28,7 @@ TEST_CASE("An empty core stats prints zero")
                                     "BRANCH_DIRECT_CALL: -",
                                     "BRANCH_INDIRECT_CALL: -",
                                     "BRANCH_RETURN: -"};
+  ::append_cpi_stack(expected, "-");
 
   REQUIRE_THAT(champsim::plain_printer::format(given), Catch::Matchers::RangeEquals(expected));
 }
@@ -39,6 +51,7 @@ TEST_CASE("The number of instructions and cycles modifies the IPC")
                                     "BRANCH_DIRECT_CALL: 0",
                                     "BRANCH_INDIRECT_CALL: 0",
                                     "BRANCH_RETURN: 0"};
+  ::append_cpi_stack(expected, "0");
 
   REQUIRE_THAT(champsim::plain_printer::format(given), Catch::Matchers::RangeEquals(expected));
 }
@@ -70,6 +83,7 @@ TEST_CASE("The number of mispredictions modifies the MPKI")
                                     "BRANCH_DIRECT_CALL: 0",
                                     "BRANCH_INDIRECT_CALL: 0",
                                     "BRANCH_RETURN: 0"};
+  ::append_cpi_stack(expected, "0");
   expected.at(line_index) = expected_line;
 
   REQUIRE_THAT(champsim::plain_printer::format(given), Catch::Matchers::RangeEquals(expected));
@@ -98,6 +112,29 @@ TEST_CASE("The ROB occupancy modifies the flush penalty")
                                     "BRANCH_DIRECT_CALL: 0",
                                     "BRANCH_INDIRECT_CALL: 0",
                                     "BRANCH_RETURN: 0"};
+  ::append_cpi_stack(expected, "0");
 
   REQUIRE_THAT(champsim::plain_printer::format(given), Catch::Matchers::RangeEquals(expected));
 }
+
+TEST_CASE("The CPI stack is normalized by the number of instructions")
+{
+  cpu_stats given{};
+  given.name = "test_cpu";
+  given.begin_instrs = 0;
+  given.begin_cycles = 0;
+  given.end_instrs = 100;
+  given.end_cycles = 400;
+  given.cpi_stack.set(cpi_component::RETIRING, 50);
+  given.cpi_stack.set(cpi_component::DRAM_BOUND, 300);
+  given.cpi_stack.set(cpi_component::BRANCH_MISPREDICT, 50);
+
+  auto lines = champsim::plain_printer::format(given);
+  auto cpi_begin = std::find(std::begin(lines), std::end(lines), "CPI stack");
+  REQUIRE(cpi_begin != std::end(lines));
+
+  std::vector<std::string> expected{"CPI stack",          "RETIRING: 0.5", "L1D_BOUND: 0",      "L2C_BOUND: 0",  "LLC_BOUND: 0",
+                                    "DRAM_BOUND: 3",      "ICACHE_MISS: 0", "FRONTEND_STARVED: 0", "BRANCH_MISPREDICT: 0.5", "ROB_FULL: 0",
+                                    "LQ_FULL: 0",         "SQ_FULL: 0",     "REGISTERS_FULL: 0",   "CORE_BOUND: 0"};
+  REQUIRE_THAT(std::vector<std::string>(cpi_begin, std::end(lines)), Catch::Matchers::RangeEquals(expected));
+}
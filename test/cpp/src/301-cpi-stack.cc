@@ -0,0 +1,165 @@
+#include <catch.hpp>
+
+#include "instr.h"
+#include "mocks.hpp"
+#include "ooo_cpu.h"
+
+SCENARIO("Every cycle of an idle core is attributed to the frontend")
+{
+  GIVEN("An empty core")
+  {
+    do_nothing_MRC mock_L1I, mock_L1D;
+    O3_CPU uut{champsim::core_builder{}.fetch_queues(&mock_L1I.queues).data_queues(&mock_L1D.queues)};
+    uut.begin_phase();
+
+    WHEN("Some cycles pass")
+    {
+      constexpr long cycles = 10;
+      for (long i = 0; i < cycles; ++i)
+        for (auto op : std::array<champsim::operable*, 3>{{&uut, &mock_L1I, &mock_L1D}})
+          op->_operate();
+
+      THEN("The cycles are attributed to frontend starvation")
+      {
+        REQUIRE(uut.sim_stats.cpi_stack.value_or(cpi_component::FRONTEND_STARVED, 0) == cycles);
+        REQUIRE(uut.sim_stats.cpi_stack.total() == cycles);
+      }
+    }
+  }
+}
+
+SCENARIO("A cycle that retires an instruction is attributed to retiring")
+{
+  GIVEN("A ROB with a single completed instruction")
+  {
+    do_nothing_MRC mock_L1I, mock_L1D;
+    O3_CPU uut{champsim::core_builder{}.fetch_queues(&mock_L1I.queues).data_queues(&mock_L1D.queues)};
+    uut.begin_phase();
+
+    uut.ROB.push_back(champsim::test::instruction_with_ip(1));
+    uut.ROB.front().completed = true;
+
+    WHEN("A cycle happens")
+    {
+      for (auto op : std::array<champsim::operable*, 3>{{&uut, &mock_L1I, &mock_L1D}})
+        op->_operate();
+
+      THEN("The cycle is attributed to retiring")
+      {
+        REQUIRE(uut.num_retired == 1);
+        REQUIRE(uut.sim_stats.cpi_stack.value_or(cpi_component::RETIRING, 0) == 1);
+        REQUIRE(uut.sim_stats.cpi_stack.total() == 1);
+      }
+    }
+  }
+}
+
+SCENARIO("A load at the head of the ROB is attributed to the level that served it")
+{
+  auto [miss_levels, expected_component] =
+      GENERATE(table<unsigned, cpi_component>({std::tuple{0u, cpi_component::L1D_BOUND}, std::tuple{1u, cpi_component::L2C_BOUND},
+                                               std::tuple{2u, cpi_component::LLC_BOUND}, std::tuple{3u, cpi_component::DRAM_BOUND},
+                                               std::tuple{4u, cpi_component::DRAM_BOUND}}));
+
+  GIVEN("A ROB whose head is an issued load")
+  {
+    const champsim::address load_address{0xcafe0000};
+    do_nothing_MRC mock_L1I, mock_L1D;
+    O3_CPU uut{champsim::core_builder{}.fetch_queues(&mock_L1I.queues).data_queues(&mock_L1D.queues)};
+    uut.begin_phase();
+
+    uut.ROB.push_back(champsim::test::instruction_with_ip_and_source_memory(champsim::address{2000}, load_address));
+    uut.do_memory_scheduling(uut.ROB.front());
+    uut.ROB.front().scheduled = true;
+    uut.ROB.front().executed = true;
+    for (auto& lq_entry : uut.LQ) {
+      if (lq_entry.has_value())
+        lq_entry->fetch_issued = true;
+    }
+
+    WHEN("The load returns after some cycles")
+    {
+      constexpr long stall_cycles = 20;
+      for (long i = 0; i < stall_cycles; ++i)
+        uut._operate();
+
+      THEN("The stall is not yet attributed") { REQUIRE(uut.sim_stats.cpi_stack.total() == 0); }
+
+      champsim::channel::response_type response{load_address, load_address, champsim::address{}, 0, {}};
+      response.miss_levels = miss_levels;
+      mock_L1D.queues.returned.push_back(response);
+      uut._operate();
+
+      THEN("The stall is attributed to the level that served the load")
+      {
+        REQUIRE(uut.sim_stats.cpi_stack.value_or(expected_component, 0) == stall_cycles + 1);
+        REQUIRE(uut.sim_stats.cpi_stack.total() == stall_cycles + 1);
+      }
+    }
+
+    WHEN("The phase ends before the load returns")
+    {
+      constexpr long stall_cycles = 20;
+      for (long i = 0; i < stall_cycles; ++i)
+        uut._operate();
+      uut.end_phase(0);
+
+      THEN("The stall is charged to DRAM, so that the stack accounts for every cycle")
+      {
+        REQUIRE(uut.sim_stats.cpi_stack.value_or(cpi_component::DRAM_BOUND, 0) == stall_cycles);
+        REQUIRE(uut.roi_stats.cpi_stack.total() == stall_cycles);
+      }
+    }
+  }
+}
+
+SCENARIO("A full ROB that blocks dispatch is attributed to the ROB")
+{
+  GIVEN("A full ROB whose head has not executed and a waiting instruction")
+  {
+    do_nothing_MRC mock_L1I, mock_L1D;
+    O3_CPU uut{champsim::core_builder{}.fetch_queues(&mock_L1I.queues).data_queues(&mock_L1D.queues).rob_size(1)};
+    uut.begin_phase();
+
+    uut.ROB.push_back(champsim::test::instruction_with_ip(1));
+    uut.ROB.front().ready_time = champsim::chrono::clock::time_point::max();
+    uut.DISPATCH_BUFFER.push_back(champsim::test::instruction_with_ip(2));
+    uut.DISPATCH_BUFFER.front().ready_time = champsim::chrono::clock::time_point{};
+
+    WHEN("A cycle happens")
+    {
+      for (auto op : std::array<champsim::operable*, 3>{{&uut, &mock_L1I, &mock_L1D}})
+        op->_operate();
+
+      THEN("The cycle is attributed to the full ROB")
+      {
+        REQUIRE(uut.sim_stats.cpi_stack.value_or(cpi_component::ROB_FULL, 0) == 1);
+        REQUIRE(uut.sim_stats.cpi_stack.total() == 1);
+      }
+    }
+  }
+}
+
+SCENARIO("A full register file is attributed in the cycle that it blocks scheduling")
+{
+  GIVEN("A register file too small for the instruction at the head of the ROB")
+  {
+    do_nothing_MRC mock_L1I, mock_L1D;
+    O3_CPU uut{champsim::core_builder{}.fetch_queues(&mock_L1I.queues).data_queues(&mock_L1D.queues).register_file_size(1)};
+    uut.begin_phase();
+
+    uut.ROB.push_back(champsim::test::instruction_with_registers(42));
+
+    WHEN("A cycle happens")
+    {
+      for (auto op : std::array<champsim::operable*, 3>{{&uut, &mock_L1I, &mock_L1D}})
+        op->_operate();
+
+      THEN("The cycle is attributed to the register file")
+      {
+        REQUIRE(uut.sim_stats.cpi_stack.value_or(cpi_component::REGISTERS_FULL, 0) == 1);
+        REQUIRE(uut.sim_stats.cpi_stack.total() == 1);
+      }
+    }
+  }
+}
@@ -0,0 +1,125 @@
+#include <catch.hpp>
+#include <sstream>
+
+#include "instr.h"
+#include "mocks.hpp"
+#include "ooo_cpu.h"
+#include "pipeline_trace.h"
+
+namespace
+{
+std::vector<std::string> lines_of(const std::string& text)
+{
+  std::vector<std::string> lines;
+  std::istringstream stream{text};
+  for (std::string line; std::getline(stream, line);) {
+    lines.push_back(line);
+  }
+  return lines;
+}
+
+champsim::chrono::clock::time_point at_tick(long long tick) { return champsim::chrono::clock::time_point{champsim::chrono::picoseconds{tick}}; }
+} // namespace
+
+TEST_CASE("A default pipeline tracer is disabled")
+{
+  champsim::pipeline_tracer uut{};
+  REQUIRE_FALSE(uut.enabled());
+  REQUIRE_FALSE(uut.tracks(0));
+}
+
+TEST_CASE("A pipeline tracer tracks only its sampled window")
+{
+  std::ostringstream out;
+  champsim::pipeline_tracer uut{out, 10, 20, 3, 8};
+  REQUIRE(uut.enabled());
+  REQUIRE_FALSE(uut.tracks(9));
+  REQUIRE(uut.tracks(10));
+  REQUIRE_FALSE(uut.tracks(11));
+  REQUIRE(uut.tracks(13));
+  REQUIRE(uut.tracks(19));
+  REQUIRE_FALSE(uut.tracks(22));
+}
+
+TEST_CASE("A pipeline tracer rejects an empty sample period")
+{
+  std::ostringstream out;
+  REQUIRE_THROWS_AS((champsim::pipeline_tracer{out, 0, 1, 0, 8}), std::invalid_argument);
+}
+
+TEST_CASE("A pipeline tracer writes a retired instruction in the O3PipeView format")
+{
+  using stage = champsim::pipeline_tracer::stage;
+  std::ostringstream out;
+  champsim::pipeline_tracer uut{out, 0, 100, 1, 8};
+
+  uut.begin(5, champsim::address{0xdeadbeef}, ::at_tick(1000));
+  uut.record_stage(5, stage::DECODE, ::at_tick(2000));
+  uut.record_stage(5, stage::DISPATCH, ::at_tick(3000));
+  uut.record_stage(5, stage::SCHEDULE, ::at_tick(4000));
+  uut.record_stage(5, stage::EXECUTE, ::at_tick(5000));
+  uut.record_stage(5, stage::MEMORY_ISSUE, ::at_tick(6000));
+  uut.record_stage(5, stage::MEMORY_RETURN, ::at_tick(7000));
+  uut.record_stage(5, stage::COMPLETE, ::at_tick(8000));
+  REQUIRE(out.str().empty());
+
+  uut.retire(5, ::at_tick(9000));
+
+  std::vector<std::string> expected{"O3PipeView:fetch:1000:0xdeadbeef:0:5:",
+                                    "O3PipeView:decode:2000",
+                                    "O3PipeView:rename:3000",
+                                    "O3PipeView:dispatch:4000",
+                                    "O3PipeView:issue:5000",
+                                    "O3PipeView:complete:8000",
+                                    "O3PipeView:retire:9000:store:0",
+                                    "O3PipeView:memory_issue:6000",
+                                    "O3PipeView:memory_return:7000"};
+  REQUIRE_THAT(::lines_of(out.str()), Catch::Matchers::RangeEquals(expected));
+}
+
+TEST_CASE("A pipeline tracer ignores instructions it did not see fetched")
+{
+  std::ostringstream out;
+  champsim::pipeline_tracer uut{out, 0, 100, 1, 8};
+  uut.record_stage(5, champsim::pipeline_tracer::stage::DECODE, ::at_tick(2000));
+  uut.retire(5, ::at_tick(9000));
+  REQUIRE(out.str().empty());
+}
+
+SCENARIO("A core with a pipeline trace writes each retired instruction")
+{
+  GIVEN("A core tracing every other instruction")
+  {
+    std::ostringstream out;
+    do_nothing_MRC mock_L1I, mock_L1D;
+    O3_CPU uut{champsim::core_builder{}.fetch_queues(&mock_L1I.queues).data_queues(&mock_L1D.queues)};
+    uut.enable_pipeline_trace(out, 0, std::numeric_limits<uint64_t>::max(), 2);
+
+    constexpr uint64_t num_instrs = 10;
+    for (uint64_t id = 0; id < num_instrs; ++id) {
+      auto instr = champsim::test::instruction_with_ip(0x1000 + 4 * id);
+      instr.instr_id = id;
+      uut.input_queue.push_back(instr);
+    }
+
+    WHEN("The instructions are retired")
+    {
+      for (int i = 0; i < 1000 && uut.num_retired < static_cast<long long>(num_instrs); ++i)
+        for (auto op : std::array<champsim::operable*, 3>{{&uut, &mock_L1I, &mock_L1D}})
+          op->_operate();
+
+      THEN("The sampled instructions are written in order")
+      {
+        REQUIRE(uut.num_retired == num_instrs);
+
+        std::vector<std::string> fetches;
+        auto lines = ::lines_of(out.str());
+        std::copy_if(std::begin(lines), std::end(lines), std::back_inserter(fetches), [](const auto& line) { return line.rfind("O3PipeView:fetch:", 0) == 0; });
+        REQUIRE(std::size(fetches) == num_instrs / 2);
+        for (std::size_t i = 0; i < std::size(fetches); ++i) {
+          REQUIRE_THAT(fetches.at(i), Catch::Matchers::EndsWith(":0:" + std::to_string(2 * i) + ":"));
+        }
+      }
+    }
+  }
+}
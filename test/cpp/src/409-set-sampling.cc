@@ -0,0 +1,248 @@
+#include <catch.hpp>
+
+#include "cache.h"
+#include "defaults.hpp"
+#include "mocks.hpp"
+#include "set_sampler.h"
+
+TEST_CASE("A sampled rate assumes its prior until it is observed")
+{
+  champsim::sampled_rate uut{0.25};
+  REQUIRE(uut.rate() == 0.25);
+
+  uut.observe(true);
+  REQUIRE(uut.rate() == 1.0);
+}
+
+TEST_CASE("A sampled rate draws outcomes at the observed rate")
+{
+  champsim::sampled_rate uut{};
+  for (bool occurred : {true, false, false, false})
+    uut.observe(occurred);
+
+  int occurrences = 0;
+  for (int i = 0; i < 100; ++i) {
+    auto outcome = uut.peek();
+    REQUIRE(uut.peek() == outcome);
+    uut.commit(outcome);
+    occurrences += outcome ? 1 : 0;
+  }
+
+  REQUIRE(occurrences == 25);
+}
+
+TEST_CASE("A set sampler samples one set from each group of sets")
+{
+  constexpr uint32_t num_sets = 64;
+  constexpr uint32_t num_sampled = 8;
+  champsim::set_sampler uut{num_sets, num_sampled};
+  REQUIRE(uut.enabled());
+  REQUIRE(uut.num_sampled() == num_sampled);
+
+  for (long group = 0; group < long{num_sampled}; ++group) {
+    long sampled_in_group = 0;
+    for (long set = 0; set < long{num_sets / num_sampled}; ++set)
+      sampled_in_group += uut.is_sampled(group * (num_sets / num_sampled) + set) ? 1 : 0;
+    REQUIRE(sampled_in_group == 1);
+  }
+}
+
+TEST_CASE("A default set sampler samples every set")
+{
+  champsim::set_sampler uut{};
+  REQUIRE_FALSE(uut.enabled());
+  REQUIRE(uut.is_sampled(0));
+  REQUIRE(uut.is_sampled(1000));
+}
+
+TEST_CASE("A sampled latency is the mean of its observations")
+{
+  champsim::sampled_latency uut{};
+  REQUIRE(uut.latency() == champsim::chrono::clock::duration{});
+  REQUIRE(uut.levels() == 0);
+
+  uut.observe(champsim::chrono::picoseconds{100}, 1);
+  uut.observe(champsim::chrono::picoseconds{300}, 2);
+  uut.observe(champsim::chrono::picoseconds{200}, 2);
+  REQUIRE(uut.latency() == champsim::chrono::picoseconds{200});
+  REQUIRE(uut.levels() == 2);
+}
+
+TEST_CASE("A set sampler models the misses of each type separately")
+{
+  champsim::set_sampler uut{64, 8};
+  uut.observe_miss(access_type::LOAD, champsim::chrono::picoseconds{400}, 1);
+  uut.observe_miss(access_type::PREFETCH, champsim::chrono::picoseconds{100}, 1);
+  REQUIRE(uut.miss_latency(access_type::LOAD) == champsim::chrono::picoseconds{400});
+  REQUIRE(uut.miss_latency(access_type::PREFETCH) == champsim::chrono::picoseconds{100});
+  REQUIRE(uut.miss_latency(access_type::RFO) == champsim::chrono::clock::duration{});
+}
+
+TEST_CASE("The cache builder rounds the number of sampled sets up to a power of two")
+{
+  CACHE uut{champsim::cache_builder{}.sets(64).sampled_sets(5)};
+  uut.begin_phase();
+  REQUIRE(uut.sim_stats.sets == 64);
+  REQUIRE(uut.sim_stats.sampled_sets == 8);
+}
+
+TEST_CASE("A cache that samples all of its sets simulates all of them")
+{
+  CACHE uut{champsim::cache_builder{}.sets(64).sampled_sets(64)};
+  uut.begin_phase();
+  REQUIRE(uut.sim_stats.sampled_sets == uut.sim_stats.sets);
+}
+
+SCENARIO("A cache with sampled sets extrapolates the accesses to the other sets")
+{
+  constexpr uint32_t num_sets = 16;
+  constexpr uint32_t num_sampled = 2;
+
+  GIVEN("A cache that simulates only some of its sets")
+  {
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l2c}
+                  .name("409-uut")
+                  .sets(num_sets)
+                  .ways(4)
+                  .sampled_sets(num_sampled)
+                  .offset_bits(champsim::data::bits{LOG2_BLOCK_SIZE})
+                  .upper_levels({&mock_ul.queues})
+                  .lower_level(&mock_ll.queues)};
+
+    std::array<champsim::operable*, 3> elements{{&uut, &mock_ll, &mock_ul}};
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    uint64_t id = 1;
+    auto read_every_set = [&]() {
+      for (uint32_t set = 0; set < num_sets; ++set) {
+        decltype(mock_ul)::request_type pkt;
+        pkt.address = champsim::address{0xbeef0000 + set * BLOCK_SIZE};
+        pkt.is_translated = true;
+        pkt.instr_id = id++;
+        pkt.cpu = 0;
+        pkt.type = access_type::LOAD;
+        REQUIRE(mock_ul.issue(pkt));
+
+        for (auto i = 0; i < 100; ++i)
+          for (auto elem : elements)
+            elem->_operate();
+      }
+    };
+
+    WHEN("One block in every set is read twice")
+    {
+      read_every_set();
+      read_every_set();
+
+      THEN("Only the sampled sets are counted in detail")
+      {
+        REQUIRE(uut.sim_stats.sets == num_sets);
+        REQUIRE(uut.sim_stats.sampled_sets == num_sampled);
+        REQUIRE(uut.sim_stats.sampled_misses.value_or(std::pair{access_type::LOAD, 0u}, 0) == num_sampled);
+        REQUIRE(uut.sim_stats.sampled_hits.value_or(std::pair{access_type::LOAD, 0u}, 0) == num_sampled);
+      }
+
+      THEN("Every access is counted in the extrapolated statistics")
+      {
+        REQUIRE(mock_ul.packets.size() == 2 * num_sets);
+        REQUIRE(uut.sim_stats.hits.total() + uut.sim_stats.misses.total() == 2 * num_sets);
+        REQUIRE(mock_ll.packet_count() == static_cast<std::size_t>(uut.sim_stats.misses.total()));
+      }
+    }
+
+    WHEN("The blocks are read many times")
+    {
+      constexpr int passes = 10;
+      for (int i = 0; i < passes; ++i)
+        read_every_set();
+
+      THEN("The accesses to the other sets mostly hit, like those to the sampled sets")
+      {
+        REQUIRE(uut.sim_stats.sampled_misses.value_or(std::pair{access_type::LOAD, 0u}, 0) == num_sampled);
+        REQUIRE(uut.sim_stats.misses.total() < passes * num_sets / 2);
+      }
+    }
+  }
+}
+
+SCENARIO("A cache with sampled sets does not track the misses to the other sets")
+{
+  constexpr uint32_t num_sets = 16;
+  constexpr uint32_t num_sampled = 2;
+  constexpr int lower_latency = 1000;
+
+  const champsim::set_sampler sampler{num_sets, num_sampled};
+  uint32_t other_set = 0;
+  while (sampler.is_sampled(other_set))
+    ++other_set;
+  const champsim::address address{0xbeef0000 + other_set * BLOCK_SIZE};
+
+  GIVEN("A cache that simulates only some of its sets, above a slow lower level")
+  {
+    do_nothing_MRC mock_ll{lower_latency};
+    to_rq_MRP mock_ul;
+    to_wq_MRP mock_ul_wq;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l2c}
+                  .name("409-uut-modeled")
+                  .sets(num_sets)
+                  .ways(4)
+                  .sampled_sets(num_sampled)
+                  .offset_bits(champsim::data::bits{LOG2_BLOCK_SIZE})
+                  .upper_levels({&mock_ul.queues, &mock_ul_wq.queues})
+                  .lower_level(&mock_ll.queues)};
+
+    std::array<champsim::operable*, 4> elements{{&uut, &mock_ll, &mock_ul, &mock_ul_wq}};
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    decltype(mock_ul)::request_type pkt;
+    pkt.address = address;
+    pkt.is_translated = true;
+    pkt.instr_id = 1;
+    pkt.cpu = 0;
+
+    WHEN("A block in a set that is not sampled is read")
+    {
+      pkt.type = access_type::LOAD;
+      REQUIRE(mock_ul.issue(pkt));
+
+      for (auto i = 0; i < 100; ++i)
+        for (auto elem : elements)
+          elem->_operate();
+
+      THEN("The miss is sent to the lower level and answered without an MSHR")
+      {
+        REQUIRE(uut.sim_stats.misses.total() == 1);
+        REQUIRE(mock_ll.packet_count() == 1);
+        REQUIRE(uut.get_mshr_occupancy() == 0);
+        REQUIRE(mock_ul.packets.back().return_time > 0);
+      }
+    }
+
+    WHEN("A dirty block in a set that is not sampled is written back to the cache")
+    {
+      pkt.type = access_type::WRITE;
+      REQUIRE(mock_ul_wq.issue(pkt));
+
+      for (auto i = 0; i < 100; ++i)
+        for (auto elem : elements)
+          elem->_operate();
+
+      THEN("The write is passed on to the lower level")
+      {
+        REQUIRE(uut.sim_stats.misses.total() == 1);
+        REQUIRE(mock_ll.packet_count() == 1);
+        REQUIRE(mock_ll.addresses.back() == address);
+      }
+    }
+  }
+}
@@ -321,3 +321,101 @@ SCENARIO("Translating cache queues forward RQ virtual to physical RQ")
     }
   }
 }
+
+SCENARIO("Cache queues do not merge with packets that were already consumed")
+{
+  GIVEN("A read queue with two checked items")
+  {
+    champsim::address address{0xdeadbeef};
+    champsim::channel uut{32, 32, 32, champsim::data::bits{LOG2_BLOCK_SIZE}, false};
+
+    issue(uut, address, issue_rq<decltype(uut)>);
+    issue(uut, champsim::address{0xcafebabe}, issue_rq<decltype(uut)>);
+    uut.check_collision();
+
+    WHEN("The first packet is consumed and a packet with its address is sent")
+    {
+      uut.RQ.pop_front();
+      issue(uut, address, issue_rq<decltype(uut)>);
+      uut.check_collision();
+
+      THEN("The packet is not merged")
+      {
+        REQUIRE(uut.rq_occupancy() == 2);
+        REQUIRE(uut.sim_stats.RQ_MERGED == 0);
+      }
+
+      AND_WHEN("Another packet with the same address is sent")
+      {
+        issue(uut, address, issue_rq<decltype(uut)>);
+        uut.check_collision();
+
+        THEN("It is merged with the queued packet")
+        {
+          REQUIRE(uut.rq_occupancy() == 2);
+          REQUIRE(uut.sim_stats.RQ_MERGED == 1);
+          REQUIRE(uut.RQ.back().address == address);
+        }
+      }
+    }
+  }
+}
+
+SCENARIO("Cache queues still find collisions after a packet is removed from the middle")
+{
+  GIVEN("A read queue with three checked items")
+  {
+    champsim::channel uut{32, 32, 32, champsim::data::bits{LOG2_BLOCK_SIZE}, false};
+
+    issue(uut, champsim::address{0xdeadbeef}, issue_rq<decltype(uut)>);
+    issue(uut, champsim::address{0xcafebabe}, issue_rq<decltype(uut)>);
+    issue(uut, champsim::address{0xfeedface}, issue_rq<decltype(uut)>);
+    uut.check_collision();
+
+    WHEN("The middle packet is consumed and packets with the remaining addresses are sent")
+    {
+      uut.RQ.erase(std::next(std::begin(uut.RQ)));
+      issue(uut, champsim::address{0xdeadbeef}, issue_rq<decltype(uut)>);
+      issue(uut, champsim::address{0xcafebabe}, issue_rq<decltype(uut)>);
+      uut.check_collision();
+
+      THEN("Only the packet whose address is still queued is merged")
+      {
+        REQUIRE(uut.rq_occupancy() == 3);
+        REQUIRE(uut.sim_stats.RQ_MERGED == 1);
+        REQUIRE(uut.RQ.back().address == champsim::address{0xcafebabe});
+      }
+    }
+  }
+}
+
+SCENARIO("A clean writeback merged with a dirty one is not clean")
+{
+  GIVEN("A write queue with a clean writeback")
+  {
+    champsim::channel uut{32, 32, 32, champsim::data::bits{LOG2_BLOCK_SIZE}, false};
+    constexpr champsim::address address{0xdeadbeef};
+
+    issue(uut, address, [](auto& q, auto pkt) {
+      pkt.clean = true;
+      return q.add_wq(pkt);
+    });
+    uut.check_collision();
+
+    WHEN("A dirty writeback with the same address is sent")
+    {
+      issue(uut, address, [](auto& q, auto pkt) {
+        pkt.clean = false;
+        return q.add_wq(pkt);
+      });
+      uut.check_collision();
+
+      THEN("The merged writeback is dirty")
+      {
+        REQUIRE(uut.wq_occupancy() == 1);
+        REQUIRE(uut.sim_stats.WQ_MERGED == 1);
+        REQUIRE_FALSE(uut.WQ.front().clean);
+      }
+    }
+  }
+}
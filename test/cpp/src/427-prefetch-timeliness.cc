@@ -0,0 +1,227 @@
+#include <catch.hpp>
+
+#include "cache.h"
+#include "defaults.hpp"
+#include "mocks.hpp"
+
+SCENARIO("A demand that merges into an in-flight prefetch counts the prefetch as late")
+{
+  GIVEN("A cache whose prefetch has not returned")
+  {
+    constexpr uint32_t metadata = 7;
+    constexpr auto head_start = 10;
+    const champsim::address pf_addr{0xdeadbeef};
+    release_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l2c}
+                  .name("427-uut")
+                  .upper_levels({&mock_ul.queues})
+                  .lower_level(&mock_ll.queues)};
+
+    std::array<champsim::operable*, 3> elements{{&uut, &mock_ll, &mock_ul}};
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    REQUIRE(uut.prefetch_line(pf_addr, true, metadata));
+    for (auto i = 0; i < head_start; ++i)
+      for (auto elem : elements)
+        elem->_operate();
+
+    REQUIRE(mock_ll.packet_count() == 1);
+    REQUIRE(uut.sim_stats.pf_issued_by_metadata.value_or(metadata, 0) == 1);
+
+    WHEN("A load to the same block misses")
+    {
+      decltype(mock_ul)::request_type test;
+      test.address = pf_addr;
+      test.cpu = 0;
+      test.type = access_type::LOAD;
+      test.instr_id = 1;
+      REQUIRE(mock_ul.issue(test));
+
+      for (auto i = 0; i < head_start; ++i)
+        for (auto elem : elements)
+          elem->_operate();
+
+      THEN("The prefetch is useful but late")
+      {
+        REQUIRE(uut.sim_stats.pf_useful == 1);
+        REQUIRE(uut.sim_stats.pf_late == 1);
+        REQUIRE(uut.sim_stats.pf_late_by_metadata.value_or(metadata, 0) == 1);
+        REQUIRE(uut.sim_stats.pf_useful_by_metadata.value_or(metadata, 0) == 1);
+        REQUIRE(uut.sim_stats.pf_late_cycles_saved > 0);
+        REQUIRE(uut.sim_stats.pf_late_cycles_lost == 0);
+      }
+
+      AND_WHEN("The prefetch returns")
+      {
+        mock_ll.release_all();
+        for (auto i = 0; i < head_start; ++i)
+          for (auto elem : elements)
+            elem->_operate();
+
+        THEN("The time the load still waited is counted as lost")
+        {
+          REQUIRE(mock_ul.packets.front().return_time > 0);
+          REQUIRE(uut.sim_stats.pf_late_cycles_lost > 0);
+        }
+      }
+    }
+  }
+}
+
+SCENARIO("A demand miss to a block that a prefetch evicted is counted as pollution")
+{
+  constexpr uint32_t metadata = 3;
+  const champsim::address demand_addr{0xcafebabe};
+  const champsim::address other_addr{0xdeadbeef};
+
+  GIVEN("A cache with a single block")
+  {
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l2c}
+                  .name("427-uut")
+                  .sets(1)
+                  .ways(1)
+                  .upper_levels({&mock_ul.queues})
+                  .lower_level(&mock_ll.queues)};
+
+    std::array<champsim::operable*, 3> elements{{&uut, &mock_ll, &mock_ul}};
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    uint64_t id = 1;
+    auto load = [&](champsim::address addr) {
+      decltype(mock_ul)::request_type pkt;
+      pkt.address = addr;
+      pkt.cpu = 0;
+      pkt.type = access_type::LOAD;
+      pkt.instr_id = id++;
+      REQUIRE(mock_ul.issue(pkt));
+
+      for (auto i = 0; i < 100; ++i)
+        for (auto elem : elements)
+          elem->_operate();
+    };
+
+    load(demand_addr);
+
+    WHEN("A prefetch evicts the block and the block is loaded again")
+    {
+      REQUIRE(uut.prefetch_line(other_addr, true, metadata));
+      for (auto i = 0; i < 100; ++i)
+        for (auto elem : elements)
+          elem->_operate();
+
+      load(demand_addr);
+
+      THEN("The miss is counted as pollution by the prefetch")
+      {
+        REQUIRE(uut.sim_stats.pf_pollution == 1);
+        REQUIRE(uut.sim_stats.pf_pollution_by_metadata.value_or(metadata, 0) == 1);
+        REQUIRE(uut.sim_stats.pf_useless == 1);
+      }
+
+      AND_WHEN("The block is evicted by a demand and loaded again")
+      {
+        load(other_addr);
+        load(demand_addr);
+
+        THEN("The miss is not counted as pollution") { REQUIRE(uut.sim_stats.pf_pollution == 1); }
+      }
+    }
+
+    WHEN("A load evicts the block and the block is loaded again")
+    {
+      load(other_addr);
+      load(demand_addr);
+
+      THEN("The miss is not counted as pollution") { REQUIRE(uut.sim_stats.pf_pollution == 0); }
+    }
+  }
+}
+
+// Like several of the shipped prefetchers, this one returns zero from its fill hook
+struct zero_fill_metadata : champsim::modules::prefetcher {
+  using prefetcher::prefetcher;
+
+  uint32_t prefetcher_cache_operate(champsim::address, champsim::address, uint8_t, bool, access_type, uint32_t metadata_in) { return metadata_in; }
+  uint32_t prefetcher_cache_fill(champsim::address, long, long, uint8_t, champsim::address, uint32_t) { return 0; }
+};
+
+SCENARIO("Prefetch outcomes are counted by the metadata the prefetch was issued with")
+{
+  constexpr uint32_t metadata = 5;
+  const champsim::address demand_addr{0xcafebabe};
+  const champsim::address other_addr{0xdeadbeef};
+
+  GIVEN("A cache with a single block, whose prefetcher returns other metadata from its fills")
+  {
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l2c}
+                  .name("427-uut-issue-metadata")
+                  .sets(1)
+                  .ways(1)
+                  .upper_levels({&mock_ul.queues})
+                  .lower_level(&mock_ll.queues)
+                  .prefetcher<zero_fill_metadata>()};
+
+    std::array<champsim::operable*, 3> elements{{&uut, &mock_ll, &mock_ul}};
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    auto run = [&]() {
+      for (auto i = 0; i < 100; ++i)
+        for (auto elem : elements)
+          elem->_operate();
+    };
+
+    uint64_t id = 1;
+    auto load = [&](champsim::address addr) {
+      decltype(mock_ul)::request_type pkt;
+      pkt.address = addr;
+      pkt.cpu = 0;
+      pkt.type = access_type::LOAD;
+      pkt.instr_id = id++;
+      REQUIRE(mock_ul.issue(pkt));
+      run();
+    };
+
+    load(demand_addr);
+    REQUIRE(uut.prefetch_line(other_addr, true, metadata));
+    run();
+
+    WHEN("The prefetched block is loaded")
+    {
+      load(other_addr);
+
+      THEN("The useful prefetch is counted under its issue metadata")
+      {
+        REQUIRE(uut.sim_stats.pf_useful == 1);
+        REQUIRE(uut.sim_stats.pf_useful_by_metadata.value_or(metadata, 0) == 1);
+      }
+    }
+
+    WHEN("The block that the prefetch evicted is loaded again")
+    {
+      load(demand_addr);
+
+      THEN("The pollution and the useless prefetch are counted under its issue metadata")
+      {
+        REQUIRE(uut.sim_stats.pf_pollution_by_metadata.value_or(metadata, 0) == 1);
+        REQUIRE(uut.sim_stats.pf_useless_by_metadata.value_or(metadata, 0) == 1);
+      }
+    }
+  }
+}
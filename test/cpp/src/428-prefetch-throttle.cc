@@ -0,0 +1,167 @@
+#include <catch.hpp>
+
+#include "cache.h"
+#include "defaults.hpp"
+#include "mocks.hpp"
+#include "prefetch_throttle.h"
+
+namespace
+{
+champsim::prefetch_throttle::feedback_type feedback(uint64_t issued, uint64_t useful, uint64_t late, uint64_t pollution, uint64_t demand_misses)
+{
+  champsim::prefetch_throttle::feedback_type result;
+  result.issued = issued;
+  result.useful = useful;
+  result.late = late;
+  result.pollution = pollution;
+  result.demand_misses = demand_misses;
+  return result;
+}
+} // namespace
+
+TEST_CASE("A default prefetch throttle admits every prefetch")
+{
+  champsim::prefetch_throttle uut{};
+  REQUIRE_FALSE(uut.enabled());
+  for (int i = 0; i < 100; ++i)
+    REQUIRE(uut.try_admit(0, 1));
+  REQUIRE_FALSE(uut.count_fill());
+}
+
+TEST_CASE("A prefetch throttle limits the prefetches admitted for each invocation")
+{
+  champsim::prefetch_throttle uut{10};
+  const auto degree = champsim::prefetch_throttle::levels.at(uut.aggressiveness()).degree;
+
+  for (unsigned i = 0; i < degree; ++i)
+    REQUIRE(uut.try_admit(0, std::numeric_limits<std::size_t>::max()));
+  REQUIRE_FALSE(uut.try_admit(0, std::numeric_limits<std::size_t>::max()));
+
+  uut.begin_invocation();
+  REQUIRE(uut.try_admit(0, std::numeric_limits<std::size_t>::max()));
+}
+
+TEST_CASE("A prefetch throttle limits the occupancy of the prefetch queue")
+{
+  champsim::prefetch_throttle uut{10};
+  const auto eighths = champsim::prefetch_throttle::levels.at(uut.aggressiveness()).pq_eighths;
+  REQUIRE_FALSE(uut.try_admit(16 * eighths / 8, 16));
+  REQUIRE(uut.try_admit(16 * eighths / 8 - 1, 16));
+}
+
+TEST_CASE("A prefetch throttle ends an interval after its number of fills")
+{
+  champsim::prefetch_throttle uut{3};
+  REQUIRE_FALSE(uut.count_fill());
+  REQUIRE_FALSE(uut.count_fill());
+  REQUIRE(uut.count_fill());
+  REQUIRE_FALSE(uut.count_fill());
+}
+
+TEST_CASE("A prefetch throttle becomes more aggressive when accurate prefetches are late")
+{
+  champsim::prefetch_throttle uut{1};
+  const auto initial = uut.aggressiveness();
+  uut.end_interval(::feedback(100, 90, 50, 0, 100), 0);
+  REQUIRE(uut.aggressiveness() == initial + 1);
+}
+
+TEST_CASE("A prefetch throttle becomes less aggressive when inaccurate prefetches pollute the cache")
+{
+  champsim::prefetch_throttle uut{1};
+  const auto initial = uut.aggressiveness();
+  uut.end_interval(::feedback(100, 10, 0, 50, 100), 0);
+  REQUIRE(uut.aggressiveness() == initial - 1);
+}
+
+TEST_CASE("A prefetch throttle keeps its aggressiveness when prefetches are timely and do not pollute")
+{
+  champsim::prefetch_throttle uut{1};
+  const auto initial = uut.aggressiveness();
+  uut.end_interval(::feedback(100, 90, 0, 0, 100), 0);
+  REQUIRE(uut.aggressiveness() == initial);
+}
+
+TEST_CASE("A prefetch throttle becomes less aggressive when DRAM is busy and prefetches are not accurate")
+{
+  champsim::prefetch_throttle uut{1};
+  const auto initial = uut.aggressiveness();
+  uut.end_interval(::feedback(100, 50, 50, 0, 100), champsim::prefetch_throttle::high_bandwidth);
+  REQUIRE(uut.aggressiveness() == initial - 1);
+}
+
+TEST_CASE("A prefetch throttle uses only the outcomes since the previous interval")
+{
+  champsim::prefetch_throttle uut{1};
+  const auto initial = uut.aggressiveness();
+  uut.end_interval(::feedback(100, 90, 0, 0, 100), 0);
+  uut.end_interval(::feedback(100, 90, 0, 0, 100), 0);
+  REQUIRE(uut.aggressiveness() == initial);
+}
+
+TEST_CASE("A prefetch throttle stays within its levels")
+{
+  champsim::prefetch_throttle uut{1};
+  for (uint64_t i = 1; i <= 10; ++i)
+    uut.end_interval(::feedback(100 * i, 90 * i, 50 * i, 0, 100 * i), 0);
+  REQUIRE(uut.aggressiveness() == std::size(champsim::prefetch_throttle::levels) - 1);
+
+  for (uint64_t i = 11; i <= 30; ++i)
+    uut.end_interval(::feedback(100 * i, 900, 500, 50 * i, 100 * i), 0);
+  REQUIRE(uut.aggressiveness() == 0);
+}
+
+SCENARIO("A cache with a prefetch throttle refuses prefetches beyond the degree")
+{
+  GIVEN("A cache with a prefetch throttle")
+  {
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l2c}
+                  .name("428-uut")
+                  .upper_levels({&mock_ul.queues})
+                  .lower_level(&mock_ll.queues)
+                  .set_prefetch_throttle()};
+
+    std::array<champsim::operable*, 3> elements{{&uut, &mock_ll, &mock_ul}};
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    const auto degree = champsim::prefetch_throttle::levels.at(champsim::prefetch_throttle::initial_level).degree;
+
+    WHEN("More prefetches than the degree are issued at once")
+    {
+      unsigned admitted = 0;
+      for (unsigned i = 0; i < degree + 2; ++i)
+        admitted += uut.prefetch_line(champsim::address{0xdeadbeef + i * BLOCK_SIZE}, true, 0) ? 1 : 0;
+
+      THEN("The prefetches beyond the degree are refused")
+      {
+        REQUIRE(admitted == degree);
+        REQUIRE(uut.sim_stats.pf_throttled == 2);
+        REQUIRE(uut.sim_stats.pf_issued == degree);
+      }
+
+      AND_WHEN("The cache operates")
+      {
+        for (auto elem : elements)
+          elem->_operate();
+
+        THEN("Prefetches are admitted again") { REQUIRE(uut.prefetch_line(champsim::address{0xcafebabe}, true, 0)); }
+      }
+    }
+  }
+}
+
+TEST_CASE("A cache without a prefetch throttle admits every prefetch while its queue has room")
+{
+  do_nothing_MRC mock_ll;
+  CACHE uut{champsim::cache_builder{champsim::defaults::default_l2c}.name("428-uut").lower_level(&mock_ll.queues).pq_size(16)};
+  uut.begin_phase();
+  for (unsigned i = 0; i < 16; ++i)
+    REQUIRE(uut.prefetch_line(champsim::address{0xdeadbeef + i * BLOCK_SIZE}, true, 0));
+  REQUIRE(uut.sim_stats.pf_throttled == 0);
+}
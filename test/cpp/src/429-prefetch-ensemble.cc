@@ -0,0 +1,197 @@
+#include <catch.hpp>
+
+#include "cache.h"
+#include "defaults.hpp"
+#include "mocks.hpp"
+#include "modules.h"
+#include "prefetch_ensemble.h"
+
+namespace
+{
+template <uint64_t offset>
+struct offset_prefetcher : champsim::modules::prefetcher {
+  using prefetcher::prefetcher;
+
+  uint32_t prefetcher_cache_operate(champsim::address addr, champsim::address, uint8_t, bool, access_type, uint32_t metadata_in)
+  {
+    prefetch_line(champsim::address{addr.to<uint64_t>() + offset * BLOCK_SIZE}, true, metadata_in);
+    return metadata_in;
+  }
+
+  uint32_t prefetcher_cache_fill(champsim::address, long, long, uint8_t, champsim::address, uint32_t metadata_in) { return metadata_in; }
+};
+} // namespace
+
+TEST_CASE("A default prefetch ensemble admits every candidate")
+{
+  champsim::prefetch_ensemble uut{};
+  REQUIRE_FALSE(uut.enabled());
+  REQUIRE(uut.try_admit(0, 0xdeadbeef, 0, 1) == champsim::prefetch_ensemble::admission::ADMIT);
+  REQUIRE(uut.try_admit(1, 0xdeadbeef, 100, 1) == champsim::prefetch_ensemble::admission::ADMIT);
+}
+
+TEST_CASE("A prefetch ensemble drops candidates that another component issued recently")
+{
+  champsim::prefetch_ensemble uut{2};
+  constexpr auto pq_size = std::numeric_limits<std::size_t>::max();
+  REQUIRE(uut.try_admit(0, 0xdeadbeef, 0, pq_size) == champsim::prefetch_ensemble::admission::ADMIT);
+  REQUIRE(uut.try_admit(1, 0xdeadbeef, 0, pq_size) == champsim::prefetch_ensemble::admission::DUPLICATE);
+  REQUIRE(uut.try_admit(0, 0xdeadbeef, 0, pq_size) == champsim::prefetch_ensemble::admission::ADMIT);
+  REQUIRE(uut.try_admit(1, 0xcafebabe, 0, pq_size) == champsim::prefetch_ensemble::admission::ADMIT);
+}
+
+TEST_CASE("A prefetch ensemble shares the queue equally between components without history")
+{
+  champsim::prefetch_ensemble uut{2};
+  REQUIRE(uut.quota(0, 16) == 8);
+  REQUIRE(uut.quota(1, 16) == 8);
+  REQUIRE(uut.try_admit(0, 0xdeadbeef, 8, 16) == champsim::prefetch_ensemble::admission::OVER_QUOTA);
+  REQUIRE(uut.try_admit(0, 0xdeadbeef, 7, 16) == champsim::prefetch_ensemble::admission::ADMIT);
+}
+
+TEST_CASE("A prefetch ensemble gives more of the queue to the more accurate component")
+{
+  champsim::prefetch_ensemble uut{2};
+  constexpr auto pq_size = std::numeric_limits<std::size_t>::max();
+  for (uint64_t i = 0; i < 100; ++i) {
+    REQUIRE(uut.try_admit(0, 2 * i, 0, pq_size) == champsim::prefetch_ensemble::admission::ADMIT);
+    REQUIRE(uut.try_admit(1, 2 * i + 1, 0, pq_size) == champsim::prefetch_ensemble::admission::ADMIT);
+    uut.record_useful(0);
+  }
+
+  REQUIRE(uut.accuracy(0) > uut.accuracy(1));
+  REQUIRE(uut.quota(0, 16) > uut.quota(1, 16));
+  REQUIRE(uut.quota(1, 16) >= 1);
+}
+
+SCENARIO("A cache with an ensemble of prefetchers drops duplicate candidates")
+{
+  GIVEN("A cache with two prefetchers that prefetch the same block")
+  {
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l2c}
+                  .name("429-uut")
+                  .upper_levels({&mock_ul.queues})
+                  .lower_level(&mock_ll.queues)
+                  .prefetcher<::offset_prefetcher<1>, ::offset_prefetcher<1>>()
+                  .set_prefetch_ensemble()};
+
+    std::array<champsim::operable*, 3> elements{{&uut, &mock_ll, &mock_ul}};
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    WHEN("A packet is sent")
+    {
+      decltype(mock_ul)::request_type test;
+      test.address = champsim::address{0xdeadbeef};
+      test.cpu = 0;
+      auto test_result = mock_ul.issue(test);
+
+      for (auto i = 0; i < 10; ++i)
+        for (auto elem : elements)
+          elem->_operate();
+
+      THEN("The issue is accepted") { REQUIRE(test_result); }
+
+      THEN("Only the first prefetcher issues the prefetch")
+      {
+        REQUIRE(uut.sim_stats.pf_issued == 1);
+        REQUIRE(uut.sim_stats.pf_issued_by_component.value_or(0, 0) == 1);
+        REQUIRE(uut.sim_stats.pf_issued_by_component.value_or(1, 0) == 0);
+        REQUIRE(uut.sim_stats.pf_duplicate_by_component.value_or(1, 0) == 1);
+      }
+    }
+  }
+}
+
+SCENARIO("A cache without an ensemble of prefetchers issues duplicate candidates")
+{
+  GIVEN("A cache with two prefetchers that prefetch the same block")
+  {
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l2c}
+                  .name("429-uut")
+                  .upper_levels({&mock_ul.queues})
+                  .lower_level(&mock_ll.queues)
+                  .prefetcher<::offset_prefetcher<1>, ::offset_prefetcher<1>>()};
+
+    std::array<champsim::operable*, 3> elements{{&uut, &mock_ll, &mock_ul}};
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    WHEN("A packet is sent")
+    {
+      decltype(mock_ul)::request_type test;
+      test.address = champsim::address{0xdeadbeef};
+      test.cpu = 0;
+      mock_ul.issue(test);
+
+      for (auto i = 0; i < 10; ++i)
+        for (auto elem : elements)
+          elem->_operate();
+
+      THEN("Both prefetchers issue the prefetch")
+      {
+        REQUIRE(uut.sim_stats.pf_issued == 2);
+        REQUIRE(std::empty(uut.sim_stats.pf_issued_by_component.get_keys()));
+      }
+    }
+  }
+}
+
+TEST_CASE("A prefetch ensemble admits a candidate of no component without charging it")
+{
+  champsim::prefetch_ensemble uut{2};
+
+  REQUIRE_FALSE(uut.charges(champsim::prefetch_ensemble::no_component));
+  REQUIRE(uut.try_admit(champsim::prefetch_ensemble::no_component, 0x100, 16, 16) == champsim::prefetch_ensemble::admission::ADMIT);
+  REQUIRE(uut.try_admit(1, 0x100, 0, 16) == champsim::prefetch_ensemble::admission::ADMIT);
+}
+
+SCENARIO("A cache with an ensemble of prefetchers does not charge prefetches outside an invocation")
+{
+  GIVEN("A cache with two prefetchers that have been invoked")
+  {
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l2c}
+                  .name("429-uut-outside")
+                  .upper_levels({&mock_ul.queues})
+                  .lower_level(&mock_ll.queues)
+                  .prefetcher<::offset_prefetcher<1>, ::offset_prefetcher<2>>()
+                  .set_prefetch_ensemble()};
+
+    std::array<champsim::operable*, 3> elements{{&uut, &mock_ll, &mock_ul}};
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    for (auto i = 0; i < 10; ++i)
+      for (auto elem : elements)
+        elem->_operate();
+
+    WHEN("A prefetch is issued outside the invocation of any prefetcher")
+    {
+      auto result = uut.prefetch_line(champsim::address{0xdeadbeef}, true, 0);
+
+      THEN("The prefetch is issued") { REQUIRE(result); }
+
+      THEN("The prefetch is not charged to the last prefetcher invoked")
+      {
+        REQUIRE(uut.sim_stats.pf_issued == 1);
+        REQUIRE(uut.sim_stats.pf_issued_by_component.value_or(0, 0) == 0);
+        REQUIRE(uut.sim_stats.pf_issued_by_component.value_or(1, 0) == 0);
+      }
+    }
+  }
+}
@@ -0,0 +1,242 @@
+#include <catch.hpp>
+
+#include "cache.h"
+#include "defaults.hpp"
+#include "mocks.hpp"
+#include "prefetch_candidates.h"
+
+namespace
+{
+champsim::prefetch_candidate_queue::candidate_type candidate(uint64_t block, uint32_t priority)
+{
+  champsim::prefetch_candidate_queue::candidate_type result;
+  result.address = champsim::address{block * BLOCK_SIZE};
+  result.block = block;
+  result.priority = priority;
+  return result;
+}
+} // namespace
+
+TEST_CASE("A prefetch candidate queue orders candidates by priority")
+{
+  champsim::prefetch_candidate_queue uut{};
+  REQUIRE(uut.push(::candidate(1, 1)) == champsim::prefetch_candidate_queue::push_result::ADDED);
+  REQUIRE(uut.push(::candidate(2, 3)) == champsim::prefetch_candidate_queue::push_result::ADDED);
+  REQUIRE(uut.push(::candidate(3, 2)) == champsim::prefetch_candidate_queue::push_result::ADDED);
+  REQUIRE(uut.push(::candidate(4, 3)) == champsim::prefetch_candidate_queue::push_result::ADDED);
+
+  std::vector<uint64_t> order;
+  while (!uut.empty()) {
+    order.push_back(uut.front().block);
+    uut.pop_front();
+  }
+  REQUIRE_THAT(order, Catch::Matchers::Equals(std::vector<uint64_t>{2, 4, 3, 1}));
+}
+
+TEST_CASE("A prefetch candidate queue merges candidates for the same block")
+{
+  champsim::prefetch_candidate_queue uut{};
+  REQUIRE(uut.push(::candidate(1, 1)) == champsim::prefetch_candidate_queue::push_result::ADDED);
+  REQUIRE(uut.push(::candidate(2, 2)) == champsim::prefetch_candidate_queue::push_result::ADDED);
+  REQUIRE(uut.push(::candidate(1, 3)) == champsim::prefetch_candidate_queue::push_result::MERGED);
+  REQUIRE(uut.size() == 2);
+  REQUIRE(uut.front().block == 1);
+  REQUIRE(uut.front().priority == 3);
+}
+
+TEST_CASE("A full prefetch candidate queue drops the candidate of the lowest priority")
+{
+  champsim::prefetch_candidate_queue uut{2};
+  REQUIRE(uut.push(::candidate(1, 2)) == champsim::prefetch_candidate_queue::push_result::ADDED);
+  REQUIRE(uut.push(::candidate(2, 1)) == champsim::prefetch_candidate_queue::push_result::ADDED);
+  REQUIRE(uut.full());
+
+  REQUIRE(uut.push(::candidate(3, 1)) == champsim::prefetch_candidate_queue::push_result::DROPPED);
+  REQUIRE(uut.push(::candidate(4, 3)) == champsim::prefetch_candidate_queue::push_result::REPLACED);
+  REQUIRE(uut.size() == 2);
+  REQUIRE(uut.front().block == 4);
+}
+
+SCENARIO("A cache issues the prefetch candidates of the highest priority")
+{
+  GIVEN("A cache with a small prefetch queue")
+  {
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l2c}
+                  .name("433-uut")
+                  .upper_levels({&mock_ul.queues})
+                  .lower_level(&mock_ll.queues)
+                  .pq_size(2)};
+
+    std::array<champsim::operable*, 3> elements{{&uut, &mock_ll, &mock_ul}};
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    WHEN("More candidates are pushed than the queue can hold")
+    {
+      REQUIRE(uut.push_prefetch_candidate(champsim::address{0xdead0000}, true, 1, 1));
+      REQUIRE(uut.push_prefetch_candidate(champsim::address{0xdead1000}, true, 3, 3));
+      REQUIRE(uut.push_prefetch_candidate(champsim::address{0xdead2000}, true, 2, 2));
+
+      for (auto elem : elements)
+        elem->_operate();
+
+      THEN("The candidates of the highest priority are issued")
+      {
+        REQUIRE(uut.sim_stats.pf_candidates == 3);
+        REQUIRE(uut.sim_stats.pf_issued == 2);
+        REQUIRE(uut.sim_stats.pf_issued_by_metadata.value_or(3, 0) == 1);
+        REQUIRE(uut.sim_stats.pf_issued_by_metadata.value_or(2, 0) == 1);
+        REQUIRE(uut.sim_stats.pf_issued_by_metadata.value_or(1, 0) == 0);
+      }
+
+      AND_WHEN("The cache operates again")
+      {
+        for (auto i = 0; i < 10; ++i)
+          for (auto elem : elements)
+            elem->_operate();
+
+        THEN("The remaining candidate is issued") { REQUIRE(uut.sim_stats.pf_issued_by_metadata.value_or(1, 0) == 1); }
+      }
+    }
+  }
+}
+
+SCENARIO("A cache filters prefetch candidates that are already cached or requested")
+{
+  GIVEN("A cache that holds a block")
+  {
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l2c}.name("433-uut").upper_levels({&mock_ul.queues}).lower_level(&mock_ll.queues)};
+
+    std::array<champsim::operable*, 3> elements{{&uut, &mock_ll, &mock_ul}};
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    REQUIRE(uut.prefetch_line(champsim::address{0xdeadbeef}, true, 0));
+    for (auto i = 0; i < 100; ++i)
+      for (auto elem : elements)
+        elem->_operate();
+    REQUIRE(uut.sim_stats.pf_fill == 1);
+
+    WHEN("A candidate for the cached block is pushed, along with a repeated candidate")
+    {
+      uut.push_prefetch_candidate(champsim::address{0xdeadbeef}, true, 0, 1);
+      uut.push_prefetch_candidate(champsim::address{0xcafebabe}, true, 0, 1);
+      uut.push_prefetch_candidate(champsim::address{0xcafebabe}, true, 0, 1);
+
+      for (auto elem : elements)
+        elem->_operate();
+
+      THEN("Only the new block is prefetched")
+      {
+        REQUIRE(uut.sim_stats.pf_candidates == 3);
+        REQUIRE(uut.sim_stats.pf_candidates_filtered == 2);
+        REQUIRE(uut.sim_stats.pf_issued == 2);
+      }
+    }
+  }
+}
+
+SCENARIO("A cache keeps the prefetch candidates that the throttle holds back")
+{
+  GIVEN("A cache that throttles its prefetches")
+  {
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l2c}
+                  .name("433-uut-throttle")
+                  .upper_levels({&mock_ul.queues})
+                  .lower_level(&mock_ll.queues)
+                  .pq_size(16)
+                  .set_prefetch_throttle()};
+
+    std::array<champsim::operable*, 3> elements{{&uut, &mock_ll, &mock_ul}};
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    const auto degree = champsim::prefetch_throttle::levels.at(champsim::prefetch_throttle::initial_level).degree;
+
+    WHEN("More candidates are pushed than the throttle admits in a cycle")
+    {
+      for (uint64_t i = 0; i < degree + 2; ++i)
+        REQUIRE(uut.push_prefetch_candidate(champsim::address{0xdead0000 + i * BLOCK_SIZE}, true, 0, 1));
+
+      uut._operate();
+
+      THEN("The throttle admits its degree and the others remain pending")
+      {
+        REQUIRE(uut.sim_stats.pf_issued == degree);
+        REQUIRE(uut.sim_stats.pf_candidates_dropped == 0);
+      }
+
+      AND_WHEN("The cache operates again")
+      {
+        uut._operate();
+
+        THEN("The remaining candidates are issued") { REQUIRE(uut.sim_stats.pf_issued == degree + 2); }
+      }
+    }
+  }
+}
+
+SCENARIO("A cache drops a prefetch candidate that the prefetch filter refuses")
+{
+  GIVEN("A cache with a prefetch filter that has prefetched a block and then lost it")
+  {
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l2c}
+                  .name("433-uut-filter")
+                  .upper_levels({&mock_ul.queues})
+                  .lower_level(&mock_ll.queues)
+                  .prefetch_filter(1024)};
+
+    std::array<champsim::operable*, 3> elements{{&uut, &mock_ll, &mock_ul}};
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    REQUIRE(uut.prefetch_line(champsim::address{0xdeadbeef}, true, 0));
+    for (auto i = 0; i < 100; ++i)
+      for (auto elem : elements)
+        elem->_operate();
+    REQUIRE(uut.sim_stats.pf_fill == 1);
+    uut.invalidate_entry(champsim::address{0xdeadbeef});
+
+    WHEN("A candidate for the lost block is pushed ahead of another candidate")
+    {
+      uut.push_prefetch_candidate(champsim::address{0xdeadbeef}, true, 0, 2);
+      uut.push_prefetch_candidate(champsim::address{0xcafebabe}, true, 0, 1);
+
+      uut._operate();
+
+      THEN("The refused candidate is dropped and the issue stops for the cycle")
+      {
+        REQUIRE(uut.sim_stats.pf_filtered == 1);
+        REQUIRE(uut.sim_stats.pf_candidates_dropped == 1);
+        REQUIRE(uut.sim_stats.pf_issued == 1);
+      }
+
+      AND_WHEN("The cache operates again")
+      {
+        uut._operate();
+
+        THEN("The other candidate is issued") { REQUIRE(uut.sim_stats.pf_issued == 2); }
+      }
+    }
+  }
+}
@@ -0,0 +1,121 @@
+#include <catch.hpp>
+
+#include "cache.h"
+#include "defaults.hpp"
+#include "mocks.hpp"
+#include "prefetch_filter.h"
+
+TEST_CASE("A default prefetch filter contains nothing")
+{
+  champsim::prefetch_filter uut{};
+  REQUIRE_FALSE(uut.enabled());
+  uut.insert(0xdeadbeef);
+  REQUIRE_FALSE(uut.contains(0xdeadbeef));
+}
+
+TEST_CASE("A prefetch filter contains the blocks inserted into it")
+{
+  champsim::prefetch_filter uut{1024};
+  REQUIRE(uut.enabled());
+  REQUIRE_FALSE(uut.contains(0xdeadbeef));
+  uut.insert(0xdeadbeef);
+  REQUIRE(uut.contains(0xdeadbeef));
+}
+
+TEST_CASE("A prefetch filter forgets erased blocks")
+{
+  champsim::prefetch_filter uut{1024};
+  uut.insert(0xdeadbeef);
+  uut.erase(0xdeadbeef);
+  REQUIRE_FALSE(uut.contains(0xdeadbeef));
+}
+
+TEST_CASE("A prefetch filter forgets the oldest blocks when its history is full")
+{
+  champsim::prefetch_filter uut{1024};
+  for (uint64_t block = 0; block <= uut.capacity(); ++block)
+    uut.insert(block);
+
+  REQUIRE_FALSE(uut.contains(0));
+  for (uint64_t block = 1; block <= uut.capacity(); ++block)
+    REQUIRE(uut.contains(block));
+}
+
+TEST_CASE("A prefetch filter keeps a reinserted block as the newest")
+{
+  champsim::prefetch_filter uut{1024};
+  for (uint64_t block = 0; block < uut.capacity(); ++block)
+    uut.insert(block);
+  uut.insert(0);
+  uut.insert(uut.capacity());
+
+  REQUIRE(uut.contains(0));
+  REQUIRE_FALSE(uut.contains(1));
+}
+
+TEST_CASE("A prefetch filter keeps a block inserted again after it was erased")
+{
+  champsim::prefetch_filter uut{1024};
+  uut.insert(0);
+  uut.erase(0);
+  uut.insert(0);
+  for (uint64_t block = 1; block < uut.capacity(); ++block)
+    uut.insert(block);
+
+  // The entry of the erased insertion ages out first, and must not forget the block
+  REQUIRE(uut.contains(0));
+  REQUIRE(uut.contains(1));
+}
+
+SCENARIO("A cache with a prefetch filter drops duplicate prefetches")
+{
+  GIVEN("A cache with a prefetch filter")
+  {
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l2c}
+                  .name("434-uut")
+                  .upper_levels({&mock_ul.queues})
+                  .lower_level(&mock_ll.queues)
+                  .prefetch_filter(1024)};
+
+    std::array<champsim::operable*, 3> elements{{&uut, &mock_ll, &mock_ul}};
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    WHEN("The same block is prefetched twice")
+    {
+      auto first = uut.prefetch_line(champsim::address{0xdeadbeef}, true, 0);
+      auto second = uut.prefetch_line(champsim::address{0xdeadbeef}, true, 0);
+
+      THEN("The second prefetch is dropped")
+      {
+        REQUIRE(first);
+        REQUIRE_FALSE(second);
+        REQUIRE(uut.sim_stats.pf_issued == 1);
+        REQUIRE(uut.sim_stats.pf_filtered == 1);
+      }
+    }
+
+    WHEN("A block is filled by a demand")
+    {
+      decltype(mock_ul)::request_type test;
+      test.address = champsim::address{0xdeadbeef};
+      test.cpu = 0;
+      mock_ul.issue(test);
+
+      for (auto i = 0; i < 100; ++i)
+        for (auto elem : elements)
+          elem->_operate();
+
+      THEN("A prefetch to the block is dropped")
+      {
+        REQUIRE_FALSE(uut.prefetch_line(champsim::address{0xdeadbeef}, true, 0));
+        REQUIRE(uut.sim_stats.pf_filtered == 1);
+      }
+    }
+  }
+}
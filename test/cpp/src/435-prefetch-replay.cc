@@ -0,0 +1,217 @@
+#include <catch.hpp>
+#include <sstream>
+
+#include "cache.h"
+#include "defaults.hpp"
+#include "mocks.hpp"
+#include "modules.h"
+#include "prefetch_replay.h"
+#include "prefetch_trace.h"
+
+namespace
+{
+const uint64_t test_block = 0xdeadbeef & ~uint64_t{BLOCK_SIZE - 1};
+
+struct next_block_prefetcher : champsim::modules::prefetcher {
+  using prefetcher::prefetcher;
+
+  uint32_t prefetcher_cache_operate(champsim::address addr, champsim::address, uint8_t, bool, access_type, uint32_t metadata_in)
+  {
+    prefetch_line(champsim::address{addr.to<uint64_t>() + BLOCK_SIZE}, true, metadata_in);
+    return metadata_in;
+  }
+
+  uint32_t prefetcher_cache_fill(champsim::address, long, long, uint8_t, champsim::address, uint32_t metadata_in) { return metadata_in; }
+};
+
+champsim::prefetch_trace_record demand_miss(uint64_t cycle, uint64_t block)
+{
+  champsim::prefetch_trace_record record;
+  record.cycle = cycle;
+  record.address = block * BLOCK_SIZE;
+  record.ip = 0xcafebabe;
+  record.kind = champsim::prefetch_trace_record::CACHE_OPERATE;
+  record.type = champsim::to_underlying(access_type::LOAD);
+  record.hit = 0;
+  return record;
+}
+} // namespace
+
+TEST_CASE("A prefetcher trace can be read back")
+{
+  std::stringstream stream;
+  champsim::prefetch_trace_writer writer{stream};
+  writer.write(::demand_miss(10, 0x1000));
+  writer.write(::demand_miss(20, 0x2000));
+
+  champsim::prefetch_trace_record record;
+  REQUIRE(champsim::read_prefetch_trace(stream, record));
+  REQUIRE(record.cycle == 10);
+  REQUIRE(record.address == 0x1000 * BLOCK_SIZE);
+  REQUIRE(record.ip == 0xcafebabe);
+  REQUIRE(champsim::read_prefetch_trace(stream, record));
+  REQUIRE(record.cycle == 20);
+  REQUIRE_FALSE(champsim::read_prefetch_trace(stream, record));
+}
+
+SCENARIO("A cache records the calls to its prefetcher")
+{
+  GIVEN("A cache with a prefetcher trace")
+  {
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l2c}
+                  .name("435-uut")
+                  .upper_levels({&mock_ul.queues})
+                  .lower_level(&mock_ll.queues)
+                  .prefetcher<::next_block_prefetcher>()};
+
+    std::stringstream stream;
+    uut.enable_prefetch_trace(stream);
+
+    std::array<champsim::operable*, 3> elements{{&uut, &mock_ll, &mock_ul}};
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    WHEN("A packet is sent")
+    {
+      decltype(mock_ul)::request_type test;
+      test.address = champsim::address{0xdeadbeef};
+      test.ip = champsim::address{0xcafebabe};
+      test.cpu = 0;
+      mock_ul.issue(test);
+
+      for (auto i = 0; i < 100; ++i)
+        for (auto elem : elements)
+          elem->_operate();
+
+      THEN("The access and the fill are recorded")
+      {
+        champsim::prefetch_trace_record record;
+        REQUIRE(champsim::read_prefetch_trace(stream, record));
+        REQUIRE(record.kind == champsim::prefetch_trace_record::CACHE_OPERATE);
+        REQUIRE(record.address == ::test_block);
+        REQUIRE(record.ip == 0xcafebabe);
+        REQUIRE(record.hit == 0);
+
+        bool found_fill = false;
+        while (champsim::read_prefetch_trace(stream, record)) {
+          found_fill = found_fill || (record.kind == champsim::prefetch_trace_record::CACHE_FILL && record.address == ::test_block && record.flag == 0);
+        }
+        REQUIRE(found_fill);
+      }
+    }
+  }
+}
+
+SCENARIO("A prefetcher trace can be replayed through a prefetcher")
+{
+  GIVEN("A cache with a next-block prefetcher and a trace of consecutive misses")
+  {
+    do_nothing_MRC mock_ll;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l2c}
+                  .name("435-uut")
+                  .sets(64)
+                  .lower_level(&mock_ll.queues)
+                  .prefetcher<::next_block_prefetcher>()};
+    uut.initialize();
+
+    std::stringstream stream;
+    champsim::prefetch_trace_writer writer{stream};
+    writer.write(::demand_miss(0, 0x1000));
+    writer.write(::demand_miss(200, 0x1001));
+    writer.write(::demand_miss(400, 0x1002));
+
+    WHEN("The prefetches arrive in time")
+    {
+      auto stats = champsim::prefetch_replay_main(uut, stream, 100);
+
+      THEN("The misses after the first are covered")
+      {
+        REQUIRE(stats.records == 3);
+        REQUIRE(stats.demand_misses == 3);
+        REQUIRE(stats.issued == 3);
+        REQUIRE(stats.covered == 2);
+        REQUIRE(stats.late == 0);
+        REQUIRE(stats.useless == 1);
+      }
+    }
+
+    WHEN("The prefetches arrive too late")
+    {
+      auto stats = champsim::prefetch_replay_main(uut, stream, 1000);
+
+      THEN("The prefetches are late")
+      {
+        REQUIRE(stats.covered == 0);
+        REQUIRE(stats.late == 2);
+        REQUIRE(stats.useless == 1);
+      }
+    }
+  }
+}
+
+SCENARIO("A replayed hit on a recorded prefetch is a miss")
+{
+  GIVEN("A cache with a next-block prefetcher and a trace recorded with a prefetcher")
+  {
+    do_nothing_MRC mock_ll;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l2c}
+                  .name("435-uut-flag")
+                  .sets(64)
+                  .lower_level(&mock_ll.queues)
+                  .prefetcher<::next_block_prefetcher>()};
+    uut.initialize();
+
+    auto prefetched_hit = ::demand_miss(200, 0x1001);
+    prefetched_hit.hit = 1;
+    prefetched_hit.flag = 1;
+
+    std::stringstream stream;
+    champsim::prefetch_trace_writer writer{stream};
+    writer.write(::demand_miss(0, 0x1000));
+    writer.write(prefetched_hit);
+
+    WHEN("The trace is replayed")
+    {
+      auto stats = champsim::prefetch_replay_main(uut, stream, 100);
+
+      THEN("The hit on the recorded prefetch is counted as a miss that the replayed prefetcher covers")
+      {
+        REQUIRE(stats.demand_misses == 2);
+        REQUIRE(stats.covered == 1);
+      }
+    }
+  }
+}
+
+SCENARIO("A replayed prefetcher is throttled per invocation")
+{
+  GIVEN("A throttled cache with a next-block prefetcher and a trace of consecutive misses")
+  {
+    do_nothing_MRC mock_ll;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l2c}
+                  .name("435-uut-throttle")
+                  .sets(64)
+                  .lower_level(&mock_ll.queues)
+                  .prefetcher<::next_block_prefetcher>()
+                  .set_prefetch_throttle()};
+    uut.initialize();
+
+    const auto degree = champsim::prefetch_throttle::levels.at(champsim::prefetch_throttle::initial_level).degree;
+    std::stringstream stream;
+    champsim::prefetch_trace_writer writer{stream};
+    for (uint64_t i = 0; i < degree + 2; ++i)
+      writer.write(::demand_miss(200 * i, 0x1000 + 2 * i));
+
+    WHEN("The trace is replayed")
+    {
+      auto stats = champsim::prefetch_replay_main(uut, stream, 100);
+
+      THEN("Each access issues its prefetch") { REQUIRE(stats.issued == degree + 2); }
+    }
+  }
+}
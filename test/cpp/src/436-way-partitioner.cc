@@ -0,0 +1,124 @@
+#include <catch.hpp>
+#include <vector>
+
+#include "cache.h"
+#include "defaults.hpp"
+#include "mocks.hpp"
+#include "way_partitioner.h"
+
+TEST_CASE("A default way partitioner keeps the chosen victim")
+{
+  champsim::way_partitioner uut{};
+  std::vector<champsim::cache_block> set(4);
+  REQUIRE_FALSE(uut.enabled());
+  REQUIRE(uut.restrict_victim(0, 0, std::data(set), 2) == 2);
+}
+
+TEST_CASE("A way partitioner shares the ways equally before it has counted any hits")
+{
+  champsim::way_partitioner two_cores{2, 64, 16};
+  REQUIRE_THAT(two_cores.allocations(), Catch::Matchers::Equals(std::vector<uint32_t>{8, 8}));
+
+  champsim::way_partitioner three_cores{3, 64, 16};
+  REQUIRE_THAT(three_cores.allocations(), Catch::Matchers::Equals(std::vector<uint32_t>{6, 5, 5}));
+}
+
+TEST_CASE("A way partitioner gives the ways to the core that gains hits from them")
+{
+  champsim::way_partitioner uut{2, 1, 16};
+
+  // The first core reuses 12 blocks, and the second core streams
+  uint64_t streamed = 1000;
+  for (int pass = 0; pass < 10; ++pass) {
+    for (uint64_t block = 0; block < 12; ++block) {
+      uut.observe(0, 0, block, 0);
+      uut.observe(1, 0, streamed++, 0);
+    }
+  }
+  uut.repartition();
+
+  REQUIRE(uut.repartitions() == 1);
+  REQUIRE_THAT(uut.allocations(), Catch::Matchers::Equals(std::vector<uint32_t>{12, 4}));
+}
+
+TEST_CASE("A way partitioner repartitions when the interval has passed")
+{
+  champsim::way_partitioner uut{2, 1, 16, 100};
+  uut.observe(0, 0, 0, 50);
+  REQUIRE(uut.repartitions() == 0);
+  uut.observe(0, 0, 0, 100);
+  REQUIRE(uut.repartitions() == 1);
+  uut.observe(0, 0, 0, 150);
+  REQUIRE(uut.repartitions() == 1);
+}
+
+SCENARIO("A way partitioner restricts the victims of each core")
+{
+  GIVEN("A set where the first core holds more than its share")
+  {
+    champsim::way_partitioner uut{2, 1, 4};
+    std::vector<champsim::cache_block> set(4);
+    for (auto& block : set)
+      block.valid = true;
+    uut.fill(0, 0, 0);
+    uut.fill(0, 0, 1);
+    uut.fill(0, 0, 2);
+    uut.fill(1, 0, 3);
+
+    WHEN("The second core, below its allocation, fills the set")
+    {
+      uut.touch(0, 0);
+
+      THEN("It evicts the least recently touched block of the first core")
+      {
+        REQUIRE(uut.restrict_victim(1, 0, std::data(set), 3) == 1);
+        REQUIRE(uut.restrict_victim(1, 0, std::data(set), 2) == 2);
+      }
+    }
+
+    WHEN("The first core, above its allocation, fills the set")
+    {
+      THEN("It evicts its own blocks") { REQUIRE(uut.restrict_victim(0, 0, std::data(set), 3) == 0); }
+    }
+  }
+}
+
+SCENARIO("A partitioned cache reports the allocations of its ways")
+{
+  GIVEN("A cache with way partitioning")
+  {
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_llc}
+                  .name("436-uut")
+                  .upper_levels({&mock_ul.queues})
+                  .lower_level(&mock_ll.queues)
+                  .set_way_partitioning()};
+
+    std::array<champsim::operable*, 3> elements{{&uut, &mock_ll, &mock_ul}};
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    WHEN("A packet is sent and the phase ends")
+    {
+      decltype(mock_ul)::request_type test;
+      test.address = champsim::address{0xdeadbeef};
+      test.cpu = 0;
+      mock_ul.issue(test);
+
+      for (auto i = 0; i < 100; ++i)
+        for (auto elem : elements)
+          elem->_operate();
+
+      uut.end_phase(0);
+
+      THEN("The only core is allocated every way")
+      {
+        REQUIRE_THAT(uut.roi_stats.way_allocation, Catch::Matchers::Equals(std::vector<uint32_t>{uut.NUM_WAY}));
+      }
+    }
+  }
+}
@@ -0,0 +1,169 @@
+#include <catch.hpp>
+
+#include "cache.h"
+#include "defaults.hpp"
+#include "mocks.hpp"
+
+namespace
+{
+struct two_level_fixture {
+  do_nothing_MRC mock_ll;
+  to_rq_MRP mock_ul;
+  champsim::channel between{32, 32, 32, champsim::data::bits{LOG2_BLOCK_SIZE}, false};
+  CACHE upper;
+  CACHE lower;
+
+  uint64_t id = 1;
+
+  two_level_fixture(uint32_t upper_ways, uint32_t lower_ways, champsim::inclusion_policy inclusion)
+      : upper(champsim::cache_builder{champsim::defaults::default_l2c}
+                  .name("460-upper")
+                  .sets(1)
+                  .ways(upper_ways)
+                  .offset_bits(champsim::data::bits{LOG2_BLOCK_SIZE})
+                  .upper_levels({&mock_ul.queues})
+                  .lower_level(&between)),
+        lower(champsim::cache_builder{champsim::defaults::default_llc}
+                  .name("460-lower")
+                  .sets(1)
+                  .ways(lower_ways)
+                  .inclusion(inclusion)
+                  .offset_bits(champsim::data::bits{LOG2_BLOCK_SIZE})
+                  .upper_levels({&between})
+                  .lower_level(&mock_ll.queues))
+  {
+    for (auto elem : elements()) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+  }
+
+  std::array<champsim::operable*, 4> elements() { return {{&upper, &lower, &mock_ll, &mock_ul}}; }
+
+  void read(champsim::address addr)
+  {
+    decltype(mock_ul)::request_type pkt;
+    pkt.address = addr;
+    pkt.is_translated = true;
+    pkt.instr_id = id++;
+    pkt.cpu = 0;
+    pkt.type = access_type::LOAD;
+    REQUIRE(mock_ul.issue(pkt));
+
+    for (auto i = 0; i < 200; ++i)
+      for (auto elem : elements())
+        elem->_operate();
+  }
+
+  long hits(const CACHE& cache, access_type type) const { return cache.sim_stats.hits.value_or(std::pair{type, 0u}, 0); }
+  long misses(const CACHE& cache, access_type type) const { return cache.sim_stats.misses.value_or(std::pair{type, 0u}, 0); }
+};
+
+const champsim::address block_a{0xbeef0000};
+const champsim::address block_b{0xcafe0000};
+} // namespace
+
+SCENARIO("An inclusive cache invalidates the blocks it evicts in the upper level")
+{
+  GIVEN("An inclusive cache with one way below a larger cache")
+  {
+    ::two_level_fixture fixture{4, 1, champsim::inclusion_policy::INCLUSIVE};
+
+    WHEN("A second block evicts the first from the lower level")
+    {
+      fixture.read(::block_a);
+      fixture.read(::block_b);
+
+      THEN("The first block is invalidated in the upper level")
+      {
+        REQUIRE(fixture.lower.sim_stats.back_invalidations == 1);
+        REQUIRE(fixture.upper.sim_stats.inclusion_victims == 1);
+      }
+
+      AND_WHEN("The first block is read again")
+      {
+        fixture.read(::block_a);
+
+        THEN("It misses in the upper level")
+        {
+          REQUIRE(fixture.misses(fixture.upper, access_type::LOAD) == 3);
+          REQUIRE(fixture.hits(fixture.upper, access_type::LOAD) == 0);
+        }
+      }
+    }
+  }
+}
+
+SCENARIO("A non-inclusive cache does not invalidate the upper level")
+{
+  GIVEN("A non-inclusive cache with one way below a larger cache")
+  {
+    ::two_level_fixture fixture{4, 1, champsim::inclusion_policy::NINE};
+
+    WHEN("A second block evicts the first from the lower level, and the first is read again")
+    {
+      fixture.read(::block_a);
+      fixture.read(::block_b);
+      fixture.read(::block_a);
+
+      THEN("The first block still hits in the upper level")
+      {
+        REQUIRE(fixture.upper.sim_stats.inclusion_victims == 0);
+        REQUIRE(fixture.hits(fixture.upper, access_type::LOAD) == 1);
+      }
+    }
+  }
+}
+
+SCENARIO("An exclusive cache is filled by the victims of the upper level")
+{
+  GIVEN("An exclusive cache below a cache with one way")
+  {
+    ::two_level_fixture fixture{1, 4, champsim::inclusion_policy::EXCLUSIVE};
+
+    WHEN("A second block evicts the first from the upper level")
+    {
+      fixture.read(::block_a);
+      fixture.read(::block_b);
+
+      THEN("The clean victim fills the lower level without being written to memory")
+      {
+        REQUIRE(fixture.misses(fixture.lower, access_type::WRITE) == 1);
+        REQUIRE(fixture.mock_ll.packet_count() == 2);
+      }
+
+      AND_WHEN("The blocks are read again")
+      {
+        fixture.read(::block_a);
+        fixture.read(::block_b);
+
+        THEN("They hit in the lower level and move to the upper level")
+        {
+          REQUIRE(fixture.hits(fixture.lower, access_type::LOAD) == 2);
+          REQUIRE(fixture.mock_ll.packet_count() == 2);
+
+          // Each victim misses, because the lower level gave up the block when it was read
+          REQUIRE(fixture.misses(fixture.lower, access_type::WRITE) == 3);
+          REQUIRE(fixture.hits(fixture.lower, access_type::WRITE) == 0);
+        }
+      }
+    }
+  }
+}
+
+SCENARIO("A cache above a non-exclusive cache writes back only dirty victims")
+{
+  GIVEN("A non-inclusive cache below a cache with one way")
+  {
+    ::two_level_fixture fixture{1, 4, champsim::inclusion_policy::NINE};
+
+    WHEN("A second block evicts the first from the upper level")
+    {
+      fixture.read(::block_a);
+      fixture.read(::block_b);
+
+      THEN("The clean victim is dropped") { REQUIRE(fixture.misses(fixture.lower, access_type::WRITE) == 0); }
+    }
+  }
+}
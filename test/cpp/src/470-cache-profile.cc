@@ -0,0 +1,136 @@
+#include <catch.hpp>
+#include <sstream>
+
+#include "cache.h"
+#include "cache_profiler.h"
+#include "defaults.hpp"
+#include "mocks.hpp"
+
+namespace
+{
+std::vector<std::string> lines_of(const std::string& text)
+{
+  std::vector<std::string> lines;
+  std::istringstream stream{text};
+  for (std::string line; std::getline(stream, line);) {
+    lines.push_back(line);
+  }
+  return lines;
+}
+} // namespace
+
+TEST_CASE("A default cache profiler is disabled")
+{
+  champsim::cache_profiler uut{};
+  REQUIRE_FALSE(uut.enabled());
+}
+
+TEST_CASE("A cache profiler counts accesses by set and load misses by instruction")
+{
+  std::ostringstream out;
+  champsim::cache_profiler uut{out, 4, 2};
+  REQUIRE(uut.enabled());
+
+  uut.record_access(1, champsim::address{0x100}, access_type::LOAD, true);
+  uut.record_access(1, champsim::address{0x100}, access_type::LOAD, false);
+  uut.record_access(2, champsim::address{0x100}, access_type::LOAD, false);
+  uut.record_access(2, champsim::address{0x200}, access_type::LOAD, false);
+  uut.record_access(3, champsim::address{0x300}, access_type::RFO, false);
+  uut.record_eviction(2);
+
+  REQUIRE(uut.hits(1) == 1);
+  REQUIRE(uut.misses(1) == 1);
+  REQUIRE(uut.misses(2) == 2);
+  REQUIRE(uut.evictions(2) == 1);
+  REQUIRE(uut.misses(3) == 1);
+
+  auto top = uut.top_load_misses();
+  REQUIRE(std::size(top) == 2);
+  REQUIRE(top.at(0).key == champsim::address{0x100});
+  REQUIRE(top.at(0).count == 2);
+  REQUIRE(top.at(1).key == champsim::address{0x200});
+}
+
+TEST_CASE("A cache profiler writes only the sets that were used")
+{
+  std::ostringstream out;
+  champsim::cache_profiler uut{out, 4, 2};
+  uut.record_access(2, champsim::address{0xbeef}, access_type::LOAD, false);
+  uut.write("uut", "test");
+
+  std::vector<std::string> expected{"# test uut", "set hits misses evictions", "2 0 1 0", "load_miss_ip misses error", "0xbeef 1 0", ""};
+  REQUIRE_THAT(::lines_of(out.str()), Catch::Matchers::RangeEquals(expected));
+
+  uut.clear();
+  REQUIRE(uut.misses(2) == 0);
+  REQUIRE(std::empty(uut.top_load_misses()));
+}
+
+SCENARIO("A cache with a profile writes the accesses and evictions of its sets")
+{
+  GIVEN("A profiled cache with a single way in each set")
+  {
+    std::ostringstream out;
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l2c}
+                  .name("470-uut")
+                  .sets(4)
+                  .ways(1)
+                  .offset_bits(champsim::data::bits{LOG2_BLOCK_SIZE})
+                  .upper_levels({&mock_ul.queues})
+                  .lower_level(&mock_ll.queues)};
+    uut.enable_profile(out, 4);
+
+    std::array<champsim::operable*, 3> elements{{&uut, &mock_ll, &mock_ul}};
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    uint64_t id = 1;
+    auto load = [&](uint64_t addr, uint64_t ip) {
+      decltype(mock_ul)::request_type pkt;
+      pkt.address = champsim::address{addr};
+      pkt.ip = champsim::address{ip};
+      pkt.is_translated = true;
+      pkt.instr_id = id++;
+      pkt.cpu = 0;
+      pkt.type = access_type::LOAD;
+      REQUIRE(mock_ul.issue(pkt));
+
+      for (auto i = 0; i < 100; ++i)
+        for (auto elem : elements)
+          elem->_operate();
+    };
+
+    WHEN("Two blocks that map to the same set are loaded in turn")
+    {
+      const uint64_t stride = 4 * BLOCK_SIZE;
+      load(0xbeef0000 + BLOCK_SIZE, 0x400);
+      load(0xbeef0000 + BLOCK_SIZE, 0x400);
+      load(0xbeef0000 + BLOCK_SIZE + stride, 0x500);
+      uut.write_profile("test");
+
+      THEN("The profile counts the hit, the misses, and the eviction in that set")
+      {
+        auto lines = ::lines_of(out.str());
+        REQUIRE(std::size(lines) >= 3);
+        REQUIRE(lines.at(0) == "# test 470-uut");
+        REQUIRE(lines.at(2) == "1 1 2 1");
+        REQUIRE(std::find(std::begin(lines), std::end(lines), "0x400 1 0") != std::end(lines));
+        REQUIRE(std::find(std::begin(lines), std::end(lines), "0x500 1 0") != std::end(lines));
+      }
+
+      AND_WHEN("A new phase begins")
+      {
+        out.str("");
+        uut.begin_phase();
+        uut.write_profile("next");
+
+        THEN("The profile is empty") { REQUIRE(::lines_of(out.str()).at(2) == "load_miss_ip misses error"); }
+      }
+    }
+  }
+}
@@ -0,0 +1,87 @@
+#include <catch.hpp>
+
+#include "dpc_api.h"
+#include "dram_controller.h"
+
+namespace
+{
+MEMORY_CONTROLLER make_controller(champsim::channel* ul)
+{
+  const auto clock_period = champsim::chrono::picoseconds{3200};
+  return MEMORY_CONTROLLER{clock_period,
+                           clock_period * 2,
+                           2,
+                           2,
+                           38,
+                           4,
+                           champsim::chrono::microseconds{64000},
+                           {ul},
+                           64,
+                           64,
+                           1,
+                           champsim::data::bytes{8},
+                           65536,
+                           128,
+                           8,
+                           2,
+                           8,
+                           8192};
+}
+} // namespace
+
+TEST_CASE("The DPC API reports an idle system before it is attached to an environment")
+{
+  REQUIRE(get_dram_bw() == 0);
+  REQUIRE(get_dram_channels() == 0);
+  REQUIRE(get_dram_read_bw(0) == 0);
+  REQUIRE(get_dram_core_share(0) == 0);
+  REQUIRE(get_dram_queue_latency() == 0);
+  REQUIRE(get_llc_mshr_occupancy() == 0);
+  REQUIRE(get_core_ipc(0) == 0);
+}
+
+SCENARIO("The memory controller tracks the system state of its reads")
+{
+  GIVEN("A memory controller")
+  {
+    champsim::channel ul{};
+    auto uut = ::make_controller(&ul);
+    uut.warmup = false;
+    uut.channels[0].warmup = false;
+
+    THEN("The controller is idle")
+    {
+      REQUIRE(uut.get_read_bw(0) == 0);
+      REQUIRE(uut.get_write_bw(0) == 0);
+      REQUIRE(uut.get_cpu_share(0) == 0);
+      REQUIRE(uut.get_queue_latency() == champsim::chrono::clock::duration{});
+    }
+
+    WHEN("A stream of reads is issued by a core")
+    {
+      for (uint64_t i = 0; i < 64; ++i) {
+        champsim::channel::request_type packet;
+        packet.address = champsim::address{i * BLOCK_SIZE};
+        packet.cpu = 0;
+        packet.response_requested = false;
+        ul.add_rq(packet);
+      }
+
+      for (auto i = 0; i < 2000; ++i)
+        uut._operate();
+
+      THEN("The read bandwidth and the queueing latency are measured")
+      {
+        REQUIRE(uut.get_read_bw(0) > 0);
+        REQUIRE(uut.get_write_bw(0) == 0);
+        REQUIRE(uut.get_queue_latency() > champsim::chrono::clock::duration{});
+      }
+
+      THEN("All of the traffic belongs to the core")
+      {
+        REQUIRE(uut.get_cpu_share(0) == 15);
+        REQUIRE(uut.get_cpu_share(1) == 0);
+      }
+    }
+  }
+}
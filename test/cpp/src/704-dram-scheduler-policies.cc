@@ -0,0 +1,125 @@
+#include <catch.hpp>
+
+#include "dram_controller.h"
+#include "dram_scheduler.h"
+
+namespace
+{
+MEMORY_CONTROLLER make_controller(champsim::channel* ul, champsim::dram_scheduler sched)
+{
+  const auto clock_period = champsim::chrono::picoseconds{3200};
+  return MEMORY_CONTROLLER{clock_period,
+                           clock_period * 2,
+                           2,
+                           2,
+                           38,
+                           4,
+                           champsim::chrono::microseconds{64000},
+                           {ul},
+                           64,
+                           64,
+                           1,
+                           champsim::data::bytes{8},
+                           65536,
+                           128,
+                           8,
+                           2,
+                           8,
+                           8192,
+                           sched};
+}
+} // namespace
+
+TEST_CASE("An FR-FCFS scheduler ranks every core the same")
+{
+  champsim::dram_scheduler uut{champsim::dram_scheduling_policy::FR_FCFS, 2};
+  for (auto i = 0; i < 10; ++i)
+    uut.record_transfer(0, 4);
+
+  REQUIRE(uut.rank(0) == 0);
+  REQUIRE(uut.rank(1) == 0);
+}
+
+TEST_CASE("A bandwidth cap scheduler demotes a core over its share until the epoch ends")
+{
+  champsim::dram_scheduler uut{champsim::dram_scheduling_policy::BANDWIDTH_CAP, 2, 0.5};
+  uut.record_transfer(0, static_cast<double>(champsim::dram_scheduler::cap_epoch / 2 - 1));
+  REQUIRE(uut.rank(0) == 0);
+
+  uut.record_transfer(0, 1);
+  REQUIRE(uut.rank(0) == 1);
+  REQUIRE(uut.rank(1) == 0);
+
+  for (uint64_t i = 0; i < champsim::dram_scheduler::cap_epoch; ++i)
+    uut.tick();
+  REQUIRE(uut.rank(0) == 0);
+}
+
+TEST_CASE("A BLISS scheduler blacklists a core that is served many times in a row")
+{
+  champsim::dram_scheduler uut{champsim::dram_scheduling_policy::BLISS, 2};
+  for (uint64_t i = 0; i < champsim::dram_scheduler::bliss_streak - 1; ++i)
+    uut.record_transfer(0, 4);
+  uut.record_transfer(1, 4);
+  uut.record_transfer(0, 4);
+  REQUIRE(uut.rank(0) == 0);
+
+  for (uint64_t i = 0; i < champsim::dram_scheduler::bliss_streak; ++i)
+    uut.record_transfer(0, 4);
+  REQUIRE(uut.rank(0) == 1);
+  REQUIRE(uut.rank(1) == 0);
+
+  for (uint64_t i = 0; i < champsim::dram_scheduler::bliss_clear_interval; ++i)
+    uut.tick();
+  REQUIRE(uut.rank(0) == 0);
+}
+
+TEST_CASE("An ATLAS scheduler favors the core that attained the least service")
+{
+  champsim::dram_scheduler uut{champsim::dram_scheduling_policy::ATLAS, 3};
+  uut.record_transfer(0, 100);
+  uut.record_transfer(1, 10);
+  uut.record_transfer(2, 50);
+  REQUIRE(uut.rank(0) == 0);
+
+  for (uint64_t i = 0; i < champsim::dram_scheduler::atlas_quantum; ++i)
+    uut.tick();
+  REQUIRE(uut.rank(1) == 0);
+  REQUIRE(uut.rank(2) == 1);
+  REQUIRE(uut.rank(0) == 2);
+}
+
+SCENARIO("The memory controller counts the reads of each core")
+{
+  auto policy = GENERATE(champsim::dram_scheduling_policy::FR_FCFS, champsim::dram_scheduling_policy::BANDWIDTH_CAP,
+                         champsim::dram_scheduling_policy::BLISS, champsim::dram_scheduling_policy::ATLAS);
+
+  GIVEN("A memory controller with a scheduling policy")
+  {
+    champsim::channel ul{};
+    auto uut = ::make_controller(&ul, champsim::dram_scheduler{policy, 1, 0.25});
+    uut.warmup = false;
+    uut.channels[0].warmup = false;
+
+    WHEN("A stream of reads is issued by a core")
+    {
+      for (uint64_t i = 0; i < 64; ++i) {
+        champsim::channel::request_type packet;
+        packet.address = champsim::address{i * BLOCK_SIZE};
+        packet.cpu = 0;
+        packet.response_requested = false;
+        ul.add_rq(packet);
+      }
+
+      for (auto i = 0; i < 4000; ++i)
+        uut._operate();
+
+      THEN("Every read is served and attributed to the core")
+      {
+        REQUIRE(uut.channels[0].sim_stats.reads_by_cpu.value_or(0, 0) == 64);
+        REQUIRE(uut.channels[0].sim_stats.writes_by_cpu.value_or(0, 0) == 0);
+        REQUIRE(uut.channels[0].sim_stats.read_latency_by_cpu.value_or(0, 0) > 0);
+      }
+    }
+  }
+}
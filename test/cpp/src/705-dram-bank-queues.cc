@@ -0,0 +1,111 @@
+#include <catch.hpp>
+
+#include "dram_controller.h"
+
+namespace
+{
+MEMORY_CONTROLLER make_controller(champsim::channel* ul)
+{
+  const auto clock_period = champsim::chrono::picoseconds{3200};
+  return MEMORY_CONTROLLER{clock_period,
+                           clock_period * 2,
+                           2,
+                           2,
+                           38,
+                           4,
+                           champsim::chrono::microseconds{64000},
+                           {ul},
+                           64,
+                           64,
+                           1,
+                           champsim::data::bytes{8},
+                           65536,
+                           128,
+                           8,
+                           2,
+                           8,
+                           8192};
+}
+
+std::size_t queued(const DRAM_CHANNEL::bank_queue_set& index)
+{
+  std::size_t total = 0;
+  for (const auto& bank : index.banks)
+    total += std::size(bank);
+  return total;
+}
+} // namespace
+
+SCENARIO("The memory controller groups its requests by bank")
+{
+  GIVEN("A memory controller")
+  {
+    champsim::channel ul{};
+    auto uut = ::make_controller(&ul);
+    uut.warmup = false;
+    uut.channels[0].warmup = false;
+    auto& channel = uut.channels[0];
+
+    WHEN("Reads to distinct blocks arrive")
+    {
+      for (uint64_t i = 0; i < 16; ++i) {
+        champsim::channel::request_type packet;
+        packet.address = champsim::address{i * BLOCK_SIZE};
+        packet.response_requested = false;
+        ul.add_rq(packet);
+      }
+      uut._operate();
+
+      THEN("Each read is queued at its bank")
+      {
+        REQUIRE(channel.RQ_banks.occupancy == 16);
+        REQUIRE(::queued(channel.RQ_banks) == 16);
+        for (std::size_t bank = 0; bank < std::size(channel.RQ_banks.banks); ++bank)
+          for (auto slot : channel.RQ_banks.banks[bank])
+            REQUIRE(channel.RQ[slot]->bank == channel.bank_request_index(channel.RQ[slot]->address));
+      }
+
+      AND_WHEN("The reads are served")
+      {
+        for (auto i = 0; i < 4000; ++i)
+          uut._operate();
+
+        THEN("The bank queues are empty") { REQUIRE(channel.RQ_banks.occupancy == 0); }
+      }
+    }
+
+    WHEN("Two reads to the same block arrive")
+    {
+      for (auto i = 0; i < 2; ++i) {
+        champsim::channel::request_type packet;
+        packet.address = champsim::address{0xdeadbeef};
+        packet.response_requested = true;
+        ul.add_rq(packet);
+      }
+      uut._operate();
+
+      THEN("They are merged into one queued request") { REQUIRE(channel.RQ_banks.occupancy == 1); }
+    }
+
+    WHEN("A read arrives for a block that is waiting to be written")
+    {
+      champsim::channel::request_type write;
+      write.address = champsim::address{0xdeadbeef};
+      write.response_requested = false;
+      ul.add_wq(write);
+
+      champsim::channel::request_type read;
+      read.address = champsim::address{0xdeadbeef};
+      read.response_requested = true;
+      ul.add_rq(read);
+      uut._operate();
+
+      THEN("The read is answered from the write queue")
+      {
+        REQUIRE(channel.WQ_banks.occupancy == 1);
+        REQUIRE(channel.RQ_banks.occupancy == 0);
+        REQUIRE(std::size(ul.returned) == 1);
+      }
+    }
+  }
+}
@@ -0,0 +1,90 @@
+#include <catch.hpp>
+
+#include "dram_controller.h"
+
+namespace
+{
+MEMORY_CONTROLLER make_controller(champsim::channel* ul)
+{
+  const auto clock_period = champsim::chrono::picoseconds{3200};
+  return MEMORY_CONTROLLER{clock_period,
+                           clock_period * 2,
+                           2,
+                           2,
+                           38,
+                           4,
+                           champsim::chrono::microseconds{64000},
+                           {ul},
+                           64,
+                           64,
+                           1,
+                           champsim::data::bytes{8},
+                           65536,
+                           128,
+                           8,
+                           2,
+                           8,
+                           8192};
+}
+} // namespace
+
+SCENARIO("An idle memory channel skips its work until its next event")
+{
+  GIVEN("A memory controller with no requests")
+  {
+    champsim::channel ul{};
+    auto uut = ::make_controller(&ul);
+    uut.warmup = false;
+    uut.channels[0].warmup = false;
+    auto& channel = uut.channels[0];
+
+    uut._operate();
+
+    THEN("The channel is idle until its next refresh")
+    {
+      REQUIRE(channel.idle());
+      REQUIRE(channel.idle_until == channel.next_event_time());
+      REQUIRE(channel.idle_until == channel.last_refresh + channel.tREF);
+    }
+
+    WHEN("The controller operates through several refresh periods")
+    {
+      champsim::channel awake_ul{};
+      auto awake = ::make_controller(&awake_ul);
+      awake.warmup = false;
+      awake.channels[0].warmup = false;
+      awake._operate();
+
+      while (uut.current_time < champsim::chrono::clock::time_point{} + 4 * channel.tREF) {
+        uut._operate();
+        awake.channels[0].wake();
+        awake._operate();
+      }
+
+      THEN("It refreshes just as a channel that never skips its work")
+      {
+        REQUIRE(channel.sim_stats.refresh_cycles > 0);
+        REQUIRE(channel.sim_stats.refresh_cycles == awake.channels[0].sim_stats.refresh_cycles);
+        REQUIRE(channel.last_refresh == awake.channels[0].last_refresh);
+        REQUIRE(uut.get_bw() == awake.get_bw());
+      }
+    }
+
+    WHEN("A read arrives")
+    {
+      champsim::channel::request_type packet;
+      packet.address = champsim::address{0xdeadbeef};
+      packet.response_requested = true;
+      ul.add_rq(packet);
+
+      for (auto i = 0; i < 200; ++i)
+        uut._operate();
+
+      THEN("The channel wakes to serve it")
+      {
+        REQUIRE(std::size(ul.returned) == 1);
+        REQUIRE(channel.sim_stats.RQ_ROW_BUFFER_MISS == 1);
+      }
+    }
+  }
+}
@@ -86,6 +86,17 @@ class CpuBuilderTest(unittest.TestCase):
     def test_execute_latency(self):
         self.get_element_diff(['.execute_latency(1)'], execute_latency=1)
 
+    def test_execute_classes(self):
+        self.get_element_diff(['.execute_class(op_class::FP, 4, champsim::bandwidth::maximum_type{2}, true)'], execute_classes={ 'FP': { 'latency': 4, 'ports': 2 } })
+        self.get_element_diff(['.execute_class(op_class::SLOW_ALU, 20, champsim::bandwidth::maximum_type{1}, false)'], execute_classes={ 'SLOW_ALU': { 'latency': 20, 'ports': 1, 'pipelined': False } })
+
+    def test_execute_classes_reject_zero_ports(self):
+        with self.assertRaises(ValueError):
+            config.instantiation_file.execute_class_part('FP', { 'latency': 4, 'ports': 0 }, 1)
+
+    def test_execute_classes_default_to_execute_width_ports(self):
+        self.get_element_diff(['.execute_width(champsim::bandwidth::maximum_type{3})', '.execute_class(op_class::FP, 4, champsim::bandwidth::maximum_type{3}, true)'], execute_width=3, execute_classes={ 'FP': { 'latency': 4 } })
+
     def test_dib_set(self):
         self.get_element_diff(['.dib_set(1)'], dib_set=1)
 
@@ -139,12 +150,26 @@ class CacheBuilderTests(unittest.TestCase):
     def test_log2_ways(self):
         self.get_element_diff(['.log2_ways(1)'], log2_ways=1)
 
+    def test_static_geometry(self):
+        self.get_element_diff(['.sets(64)', '.ways(8)', '.offset_bits(champsim::data::bits{6})', '.static_geometry<64, 8, 6>()'], sets=64, ways=8, _offset_bits=6, static_geometry=True)
+        self.get_element_diff(['.log2_sets(6)', '.log2_ways(3)', '.offset_bits(champsim::data::bits{champsim::lg2(64)})', '.static_geometry<64, 8, champsim::lg2(64)>()'], log2_sets=6, log2_ways=3, _offset_bits='champsim::lg2(64)', static_geometry=True)
+
+    def test_static_geometry_requires_sets_and_ways(self):
+        with self.assertRaises(ValueError):
+            list(config.instantiation_file.get_cache_builder({ 'name': 'test_cache', 'size': 1024, 'ways': 8, 'static_geometry': True }, [(None, 'test_cache'), ('test_cache', None)]))
+
     def test_pq_size(self):
         self.get_element_diff(['.pq_size(1)'], pq_size=1)
 
     def test_mshr_size(self):
         self.get_element_diff(['.mshr_size(1)'], mshr_size=1)
 
+    def test_sampled_sets(self):
+        self.get_element_diff(['.sampled_sets(64)'], sampled_sets=64)
+
+    def test_prefetch_filter(self):
+        self.get_element_diff(['.prefetch_filter(1024)'], prefetch_filter=1024)
+
     def test_latency(self):
         self.get_element_diff(['.latency(1)'], latency=1)
 
@@ -172,6 +197,23 @@ class CacheBuilderTests(unittest.TestCase):
         self.get_element_diff(['.set_virtual_prefetch()'], virtual_prefetch=True)
         self.get_element_diff(['.reset_virtual_prefetch()'], virtual_prefetch=False)
 
+    def test_prefetch_throttle(self):
+        self.get_element_diff(['.set_prefetch_throttle()'], prefetch_throttle=True)
+        self.get_element_diff(['.reset_prefetch_throttle()'], prefetch_throttle=False)
+
+    def test_prefetch_ensemble(self):
+        self.get_element_diff(['.set_prefetch_ensemble()'], prefetch_ensemble=True)
+        self.get_element_diff(['.reset_prefetch_ensemble()'], prefetch_ensemble=False)
+
+    def test_way_partitioning(self):
+        self.get_element_diff(['.set_way_partitioning()'], way_partitioning=True)
+        self.get_element_diff(['.reset_way_partitioning()'], way_partitioning=False)
+
+    def test_inclusion(self):
+        self.get_element_diff(['.inclusion(champsim::inclusion_policy::NINE)'], inclusion='non-inclusive')
+        self.get_element_diff(['.inclusion(champsim::inclusion_policy::INCLUSIVE)'], inclusion='inclusive')
+        self.get_element_diff(['.inclusion(champsim::inclusion_policy::EXCLUSIVE)'], inclusion='exclusive')
+
     def test_prefetch_activate(self):
         self.get_element_diff(['.prefetch_activate(access_type::LOAD)'], prefetch_activate=['LOAD'])
         self.get_element_diff(['.prefetch_activate(access_type::LOAD, access_type::WRITE)'], prefetch_activate=['LOAD', 'WRITE'])
@@ -304,3 +346,19 @@ class GetQueueInfoTests(unittest.TestCase):
             { 'is_good_boy': False }
         ]
         self.assertEqual(expected, evaluated)
+
+class DramSchedulerPartTests(unittest.TestCase):
+    def test_no_scheduler(self):
+        self.assertEqual('', config.instantiation_file.dram_scheduler_part({}, 2))
+
+    def test_scheduler(self):
+        evaluated = config.instantiation_file.dram_scheduler_part({ 'scheduler': 'bliss' }, 2)
+        self.assertEqual(', champsim::dram_scheduler{champsim::dram_scheduling_policy::BLISS, 2, 1.0}', evaluated)
+
+    def test_bandwidth_cap(self):
+        evaluated = config.instantiation_file.dram_scheduler_part({ 'scheduler': 'bandwidth-cap', 'bandwidth_cap': 0.5 }, 4)
+        self.assertEqual(', champsim::dram_scheduler{champsim::dram_scheduling_policy::BANDWIDTH_CAP, 4, 0.5}', evaluated)
+
+    def test_unknown_scheduler(self):
+        with self.assertRaises(ValueError):
+            config.instantiation_file.dram_scheduler_part({ 'scheduler': 'lottery' }, 2)
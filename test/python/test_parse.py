@@ -321,6 +321,15 @@ class ParseNormalizedTests(unittest.TestCase):
                 module_names = [c.get(module_key) for c in caches]
                 self.assertNotIn(None, module_names)
 
+    def test_caches_list_each_prefetcher_once(self):
+        test_config = config.parse.NormalizedConfiguration({ 'L2C': { 'name': 'test_l2c', 'prefetcher': ['a', 'b'] }, 'ooo_cpu': [{ 'name': 'test_cpu', 'L2C': 'test_l2c' }] })
+
+        result = test_config.apply_defaults_in(PassthroughContext(), PassthroughContext(), PassthroughContext(), PassthroughContext())
+        caches = result[0]['caches']
+
+        l2c = caches[[cache['name'] for cache in caches].index('test_l2c')]
+        self.assertEqual([d['name'] for d in l2c['_prefetcher_data']], ['a', 'b'])
+
 class NormalizeConfigTest(unittest.TestCase):
 
     def test_empty_config_creates_defaults(self):
@@ -417,7 +426,7 @@ class NormalizeConfigTest(unittest.TestCase):
         self.assertEqual(result.vmem.get('__test__'), True)
 
     def test_core_params_are_moved_to_core_array(self):
-        core_keys_to_copy = ('frequency', 'ifetch_buffer_size', 'decode_buffer_size', 'dispatch_buffer_size', 'register_file_size', 'rob_size', 'lq_size', 'sq_size', 'fetch_width', 'decode_width', 'dispatch_width', 'execute_width', 'lq_width', 'sq_width', 'retire_width', 'mispredict_penalty', 'scheduler_size', 'decode_latency', 'dispatch_latency', 'schedule_latency', 'execute_latency', 'branch_predictor', 'btb', 'DIB')
+        core_keys_to_copy = ('frequency', 'ifetch_buffer_size', 'decode_buffer_size', 'dispatch_buffer_size', 'register_file_size', 'rob_size', 'lq_size', 'sq_size', 'fetch_width', 'decode_width', 'dispatch_width', 'execute_width', 'lq_width', 'sq_width', 'retire_width', 'mispredict_penalty', 'scheduler_size', 'decode_latency', 'dispatch_latency', 'schedule_latency', 'execute_latency', 'execute_classes', 'branch_predictor', 'btb', 'DIB')
         for k in core_keys_to_copy:
             with self.subTest(key=k):
                 result = config.parse.NormalizedConfiguration({ k: '__test__' })
@@ -101,6 +101,13 @@ class WrapListTests(unittest.TestCase):
     def test_wrap_nonlist(self):
         self.assertEqual(config.util.wrap_list(1), [1])
 
+class UniqueTests(unittest.TestCase):
+    def test_unique_keeps_first(self):
+        self.assertEqual(config.util.unique([2,1,2,3,1]), [2,1,3])
+
+    def test_unique_unhashable(self):
+        self.assertEqual(config.util.unique([{'a': 1}, {'a': 1}, {'b': 2}]), [{'a': 1}, {'b': 2}])
+
 class ExtendEachTests(unittest.TestCase):
 
     def test_no_lists(self):
@@ -22,6 +22,7 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "../../inc/op_class.h"
 #include "../../inc/trace_instruction.h"
 
 // defines for the paths for the various decompression programs and Apple/Linux differences
@@ -39,6 +40,7 @@
 #endif
 
 bool verbose = false;
+bool classed = false;
 
 // use non-cloudsuite ChampSim trace format
 using trace_instr_format = input_instr;
@@ -207,6 +209,47 @@ struct trace {
 
 // is this a branch type?
 
+// map the CVP-1 instruction types to the functional unit classes of the extended trace format
+op_class functional_unit_class(InstClass t)
+{
+  switch (t) {
+  case loadInstClass:
+    return op_class::LOAD;
+  case storeInstClass:
+    return op_class::STORE;
+  case condBranchInstClass:
+  case uncondDirectBranchInstClass:
+  case uncondIndirectBranchInstClass:
+    return op_class::BRANCH;
+  case fpInstClass:
+    return op_class::FP;
+  case slowAluInstClass:
+    return op_class::SLOW_ALU;
+  default:
+    return op_class::ALU;
+  }
+}
+
+// write an instruction in the plain format, or in the extended format if requested
+void write_instr(const trace_instr_format& ct, InstClass t)
+{
+  if (classed) {
+    classed_instr cct;
+    memset(&cct, 0, sizeof(cct));
+    cct.ip = ct.ip;
+    cct.is_branch = ct.is_branch;
+    cct.branch_taken = ct.branch_taken;
+    memcpy(cct.destination_registers, ct.destination_registers, sizeof(cct.destination_registers));
+    memcpy(cct.source_registers, ct.source_registers, sizeof(cct.source_registers));
+    memcpy(cct.destination_memory, ct.destination_memory, sizeof(cct.destination_memory));
+    memcpy(cct.source_memory, ct.source_memory, sizeof(cct.source_memory));
+    cct.instr_class = static_cast<unsigned char>(functional_unit_class(t));
+    fwrite(&cct, sizeof(cct), 1, stdout);
+  } else {
+    fwrite(&ct, sizeof(ct), 1, stdout);
+  }
+}
+
 bool is_branch(InstClass t) { return (t == uncondIndirectBranchInstClass || t == uncondDirectBranchInstClass || t == condBranchInstClass); }
 
 std::map<UINT64, bool> code_pages, data_pages;
@@ -364,6 +407,8 @@ int main(int argc, char** argv)
   for (int i = 1; i < argc; i++) {
     if (!strcmp(argv[i], "-v"))
       verbose = true;
+    else if (!strcmp(argv[i], "-x"))
+      classed = true;
     else
       strcpy(tracefilename, argv[i]);
   }
@@ -518,7 +563,7 @@ int main(int argc, char** argv)
       default:
         assert(0);
       }
-      fwrite(&ct, sizeof(ct), 1, stdout); // write a branch trace
+      write_instr(ct, t.type); // write a branch trace
     } else {
       memset(ct.destination_registers, 0, sizeof(ct.destination_registers));
       memset(ct.source_registers, 0, sizeof(ct.source_registers));
@@ -572,7 +617,7 @@ int main(int argc, char** argv)
         case undefInstClass:
           assert(0);
         }
-        fwrite(&ct, sizeof(ct), 1, stdout); // write a non-branch trace
+        write_instr(ct, t.type); // write a non-branch trace
       }
     }
 